@@ -28,6 +28,7 @@
 #include <map>
 #include <vector>
 #include <array>
+#include <span>
 #include <queue>
 #include <string>
 #include <bitset>
@@ -44,10 +45,26 @@
 #include <algorithm>
 /* Utility */
 #include <chrono>
+#include <ctime>
 #include <cstdio>
 #include <cstdint>
+#include <cinttypes>
+#include <cstring>
 #include <cfloat>
 #include <iomanip>
 #include <iterator>
 #include <stdexcept>
-#include <functional>
\ No newline at end of file
+#include <functional>
+#include <string_view>
+#include <type_traits>
+/* Thread */
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <future>
+#include <condition_variable>
+/* System */
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
\ No newline at end of file
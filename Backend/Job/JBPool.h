@@ -0,0 +1,182 @@
+#pragma once
+#include "../Common.h"
+#include "../Log/LGImpl.h"
+/* Fixed size pool of worker threads fed from a single job queue. Jobs are meant for coarse grained work (decoding an
+ * image, parsing a file etc.), so a mutex guarded queue is cheap compared to the work in each job
+*/
+namespace Job {
+    class JBPool {
+        private:
+            struct PoolInfo {
+                struct Meta {
+                    std::queue <std::function <void (void)>> jobs;
+                    uint32_t workersCount;
+                } meta;
+
+                struct State {
+                    bool stopRequested;
+                } state;
+
+                struct Resource {
+                    Log::LGImpl* logObj;
+                    std::vector <std::thread> workers;
+                } resource;
+            } m_poolInfo;
+
+            std::mutex m_poolMutex;
+            std::condition_variable m_jobCondition;
+
+            void runWorker (void) {
+                while (true) {
+                    std::function <void (void)> job;
+                    {
+                        std::unique_lock <std::mutex> lock (m_poolMutex);
+                        m_jobCondition.wait (lock, [this](void) {
+                            return m_poolInfo.state.stopRequested || !m_poolInfo.meta.jobs.empty();
+                        });
+                        /* Remaining jobs are drained before the worker exits */
+                        if (m_poolInfo.meta.jobs.empty())
+                            return;
+
+                        job = std::move (m_poolInfo.meta.jobs.front());
+                        m_poolInfo.meta.jobs.pop();
+                    }
+                    job();
+                }
+            }
+
+        public:
+            JBPool (void) {
+                m_poolInfo = {};
+
+                auto& logObj = m_poolInfo.resource.logObj;
+                logObj       = new Log::LGImpl();
+                logObj->initLogInfo     ("Build/Log/Job",         __FILE__);
+                logObj->updateLogConfig (Log::LEVEL_TYPE_INFO,    Log::SINK_TYPE_FILE);
+                logObj->updateLogConfig (Log::LEVEL_TYPE_WARNING, Log::SINK_TYPE_CONSOLE | Log::SINK_TYPE_FILE);
+                logObj->updateLogConfig (Log::LEVEL_TYPE_ERROR,   Log::SINK_TYPE_CONSOLE | Log::SINK_TYPE_FILE);
+            }
+
+            /* A workers count of 0 picks one worker per hardware thread, leaving one for the main thread */
+            void initPoolInfo (uint32_t workersCount = 0) {
+                auto& meta     = m_poolInfo.meta;
+                auto& resource = m_poolInfo.resource;
+
+                if (workersCount == 0)
+                    workersCount = std::max (std::thread::hardware_concurrency(), 2u) - 1;
+
+                meta.jobs                      = {};
+                meta.workersCount              = workersCount;
+                m_poolInfo.state.stopRequested = false;
+
+                for (uint32_t i = 0; i < workersCount; i++)
+                    resource.workers.emplace_back (&JBPool::runWorker, this);
+
+                LOG_INFO (resource.logObj) << "Workers count"
+                                           << " "
+                                           << "[" << workersCount << "]"
+                                           << std::endl;
+            }
+
+            uint32_t getWorkersCount (void) {
+                return m_poolInfo.meta.workersCount;
+            }
+
+            /* Queue a job and return a future to its result. Exceptions thrown by the job are stored in the future, and
+             * re-thrown on get()
+            */
+            template <typename T>
+            auto addJob (T&& job) -> std::future <std::invoke_result_t <std::decay_t <T>>> {
+                using ResultType = std::invoke_result_t <std::decay_t <T>>;
+                /* std::function requires a copyable target, so the (move only) packaged task is held by a shared ptr */
+                auto task        = std::make_shared <std::packaged_task <ResultType (void)>> (std::forward <T> (job));
+                auto result      = task->get_future();
+                {
+                    std::lock_guard <std::mutex> lock (m_poolMutex);
+                    if (m_poolInfo.state.stopRequested) {
+                        LOG_ERROR (m_poolInfo.resource.logObj) << "Failed to add job, pool is stopped"
+                                                               << std::endl;
+                        throw std::runtime_error ("Failed to add job, pool is stopped");
+                    }
+                    m_poolInfo.meta.jobs.push ([task](void) {
+                        (*task)();
+                    });
+                }
+                m_jobCondition.notify_one();
+                return result;
+            }
+
+            /* Run job (jobIdx) for every idx in [0, jobsCount) and return once all of them are done. The calling thread
+             * takes part in running the jobs, and only ever waits on jobs that another thread has already started, so
+             * this is safe to call from within a job (a worker waiting on queued work could otherwise deadlock the
+             * pool). Helpers that start after every idx has been claimed return right away. The first exception thrown
+             * by a job is re-thrown here
+            */
+            template <typename T>
+            void runParallelJobs (const uint32_t jobsCount, T&& job) {
+                struct ParallelJobsInfo {
+                    std::function <void (uint32_t)> job;
+                    uint32_t jobsCount;
+                    std::atomic <uint32_t> nextJobIdx;
+                    uint32_t doneJobsCount;
+                    std::exception_ptr exception;
+                    std::mutex mutex;
+                    std::condition_variable condition;
+                };
+                auto info           = std::make_shared <ParallelJobsInfo>();
+                info->job           = std::forward <T> (job);
+                info->jobsCount     = jobsCount;
+                info->nextJobIdx    = 0;
+                info->doneJobsCount = 0;
+
+                auto runJobs = [info](void) {
+                    uint32_t jobIdx;
+                    while ((jobIdx = info->nextJobIdx.fetch_add (1)) < info->jobsCount) {
+                        std::exception_ptr exception;
+                        try {
+                            info->job (jobIdx);
+                        }
+                        catch (...) {
+                            exception = std::current_exception();
+                        }
+
+                        std::lock_guard <std::mutex> lock (info->mutex);
+                        if (exception && !info->exception)
+                            info->exception = exception;
+                        if (++info->doneJobsCount == info->jobsCount)
+                            info->condition.notify_all();
+                    }
+                };
+
+                uint32_t helpersCount = std::min (m_poolInfo.meta.workersCount, jobsCount > 0 ? jobsCount - 1: 0);
+                if (helpersCount > 0) {
+                    {
+                        std::lock_guard <std::mutex> lock (m_poolMutex);
+                        for (uint32_t i = 0; i < helpersCount && !m_poolInfo.state.stopRequested; i++)
+                            m_poolInfo.meta.jobs.push (runJobs);
+                    }
+                    m_jobCondition.notify_all();
+                }
+                runJobs();
+
+                std::unique_lock <std::mutex> lock (info->mutex);
+                info->condition.wait (lock, [&info](void) {
+                    return info->doneJobsCount == info->jobsCount;
+                });
+                if (info->exception)
+                    std::rethrow_exception (info->exception);
+            }
+
+            ~JBPool (void) {
+                {
+                    std::lock_guard <std::mutex> lock (m_poolMutex);
+                    m_poolInfo.state.stopRequested = true;
+                }
+                m_jobCondition.notify_all();
+                for (auto& worker: m_poolInfo.resource.workers)
+                    worker.join();
+
+                delete m_poolInfo.resource.logObj;
+            }
+    };
+}   // namespace Job
\ No newline at end of file
@@ -1,15 +1,18 @@
 #pragma once
 #include "../Common.h"
 #include "../Collection/CNTypeInstanceBase.h"
+#include "LGSinkRegistry.h"
+#include "LGSink.h"
+#include "LGType.h"
 
 /* 1-line log macros */
 #define LOG_LITE(obj, level)            obj->getReference()                                     \
                                             << obj->updateActiveSinkType (level)
 #define LOG(obj, level)                 obj->getReference()                                     \
                                             << obj->updateActiveSinkType (level)                \
-                                            << "[" << obj->getTimeStamp()             << "]"    \
+                                            << obj->getTimeStamp()                              \
                                             << " "                                              \
-                                            << "[" << obj->getLevelTypeString (level) << "]"    \
+                                            << "[" << Log::getLevelTypeString (level) << "]"    \
                                             << " "                                              \
                                             << ALIGN_AND_PAD_L << __FUNCTION__                  \
                                             << " "                                              \
@@ -24,6 +27,23 @@
 #define LOG_WARNING(obj)                LOG      (obj, Log::LEVEL_TYPE_WARNING)
 #define LOG_ERROR(obj)                  LOG      (obj, Log::LEVEL_TYPE_ERROR)
 
+/* Format log macros, each "{}" in the format string is replaced by the next arg. The format string must be a literal
+ * since it is stored once per call site
+*/
+#define LOG_FMT(obj, level, format, ...)                                                                \
+                                        do {                                                            \
+                                            static Log::LGSite logSite (level,                          \
+                                                                        __FILE__,                       \
+                                                                        __FUNCTION__,                   \
+                                                                        __LINE__,                       \
+                                                                        format);                        \
+                                            obj->writeFmtRecord (&logSite __VA_OPT__(,) __VA_ARGS__);   \
+                                        } while (0)
+
+#define LOG_FMT_INFO(obj, format, ...)      LOG_FMT (obj, Log::LEVEL_TYPE_INFO,    format __VA_OPT__(,) __VA_ARGS__)
+#define LOG_FMT_WARNING(obj, format, ...)   LOG_FMT (obj, Log::LEVEL_TYPE_WARNING, format __VA_OPT__(,) __VA_ARGS__)
+#define LOG_FMT_ERROR(obj, format, ...)     LOG_FMT (obj, Log::LEVEL_TYPE_ERROR,   format __VA_OPT__(,) __VA_ARGS__)
+
 #define ALIGN_AND_PAD_S                 std::right << std::setw (8)
 #define ALIGN_AND_PAD_M                 std::right << std::setw (32)
 #define ALIGN_AND_PAD_L                 std::right << std::setw (64)
@@ -34,47 +54,307 @@
 #define LINE_BREAK                      "|-----------------------------------------------------------------|"
 
 namespace Log {
-    typedef enum {
-        LEVEL_TYPE_INFO    = 1,
-        LEVEL_TYPE_WARNING = 2,
-        LEVEL_TYPE_ERROR   = 4,
-    } e_levelType;
-
-    typedef enum {
-        SINK_TYPE_NONE     = 0,
-        SINK_TYPE_CONSOLE  = 1,
-        SINK_TYPE_FILE     = 2
-    } e_sinkType;
-
-    inline e_sinkType operator | (const e_sinkType sinkTypeA, const e_sinkType sinkTypeB) {
-        return static_cast <e_sinkType> (static_cast <int> (sinkTypeA) | static_cast <int> (sinkTypeB));
-    }
-
     class LGImpl: public Collection::CNTypeInstanceBase {
         private:
+            struct RateLimitInfo {
+                uint32_t maxRecordsCount;
+                TickType windowTicks;
+                bool repeatCollapsingDisabled;
+            };
+
             struct LogInfo {
                 struct Meta {
                     std::unordered_map <e_levelType, e_sinkType> levelTypeToSinkTypeMap;
+                    std::unordered_map <e_levelType, RateLimitInfo> levelTypeToRateLimitInfoMap;
                     std::string saveFileDirPath;
                     std::string saveFileName;
                     const char* saveFileExtension;
+                    e_timeStampType timeStampType;
+                    /* Sites holding repeated/suppressed counts that are yet to be written out as summaries */
+                    std::set <LGSite*> pendingSites;
                 } meta;
 
-                struct State {
-                    e_sinkType activeSinkType;
-                } state;
-
                 struct Resource {
-                    std::ofstream file;
+                    LGSink* consoleSinkObj;
+                    LGSink* fileSinkObj;
+                    LGSink* binarySinkObj;
                 } resource;
             } m_logInfo;
 
+            /* A stream log statement is collected token by token into a per thread record, and handed over to the sinks
+             * as a whole line on std::endl. Since the record lives with the thread and not the logger, any number of
+             * threads may share a logger. Note that, the record holds the sinks (owned by the registry) rather than the
+             * logger, so that a partial line can still be written out after its logger is destroyed
+            */
+            struct PendingRecord {
+                e_levelType levelType;
+                e_sinkType sinkType;
+                e_timeStampType timeStampType;
+                LGSink* fileSinkObj;
+                LGSink* binarySinkObj;
+                std::ostringstream stream;
+
+                ~PendingRecord (void) {
+                    if (!stream.view().empty())
+                        writePendingRecord (*this);
+                }
+            };
+
+            std::mutex m_pendingSiteMutex;
+            /* End of the earliest window among the pending sites, so that the hot path only compares ticks */
+            std::atomic <TickType> m_nextSummaryTick;
+
+            static LGSinkRegistry m_sinkRegistryObj;
+            static std::mutex m_siteMutex;
+            static SiteIdType m_nextSiteId;
+            static std::atomic <FrameIdxType> m_frameIdx;
+
             /* std::endl is a template function, and this is the signature of that function */
             using EndlType = std::ostream& (std::ostream&);
 
+            static PendingRecord& getPendingRecord (void) {
+                thread_local PendingRecord pendingRecord = {};
+                return pendingRecord;
+            }
+
+            static void writePendingRecord (PendingRecord& pendingRecord) {
+                auto text                  = pendingRecord.stream.view();
+                bool flushRequired         = pendingRecord.levelType     != LEVEL_TYPE_INFO;
+                bool tickReferenceRequired = pendingRecord.timeStampType != TIME_STAMP_TYPE_WALL_CLOCK;
+
+                if (pendingRecord.sinkType & SINK_TYPE_CONSOLE)
+                    m_sinkRegistryObj.getConsoleSink()->writeText (text, flushRequired, tickReferenceRequired);
+
+                if (pendingRecord.sinkType & SINK_TYPE_FILE)
+                    pendingRecord.fileSinkObj->writeText (text, flushRequired, tickReferenceRequired);
+
+                /* Errors are usually followed by an exception, so make sure they reach the file */
+                if (pendingRecord.sinkType & SINK_TYPE_BINARY)
+                    pendingRecord.binarySinkObj->writeTextRecord (getTick(),
+                                                                  getFrameIdx(),
+                                                                  text,
+                                                                  pendingRecord.levelType == LEVEL_TYPE_ERROR);
+                pendingRecord.stream.str ("");
+            }
+
+            template <typename T>
+            void writeArg (std::vector <uint8_t>& argBytes, const T& arg) {
+                constexpr e_argType argType = getArgType <T>();
+
+                if      constexpr (argType == ARG_TYPE_BOOL)    writeBytes  (argBytes, static_cast <uint8_t>  (arg));
+                else if constexpr (argType == ARG_TYPE_CHAR)    writeBytes  (argBytes, static_cast <char>     (arg));
+                else if constexpr (argType == ARG_TYPE_INT32)   writeBytes  (argBytes, static_cast <int32_t>  (arg));
+                else if constexpr (argType == ARG_TYPE_UINT32)  writeBytes  (argBytes, static_cast <uint32_t> (arg));
+                else if constexpr (argType == ARG_TYPE_INT64)   writeBytes  (argBytes, static_cast <int64_t>  (arg));
+                else if constexpr (argType == ARG_TYPE_UINT64)  writeBytes  (argBytes, static_cast <uint64_t> (arg));
+                else if constexpr (argType == ARG_TYPE_FLOAT)   writeBytes  (argBytes, static_cast <float>    (arg));
+                else if constexpr (argType == ARG_TYPE_DOUBLE)  writeBytes  (argBytes, static_cast <double>   (arg));
+                else                                            writeString (argBytes, std::string_view       (arg));
+            }
+
+            /* Args are converted to the same types used by the binary sink before being streamed, so that enums and
+             * narrow integers read the same in text and decoded binary logs
+            */
+            template <typename T>
+            void writeTextArg (std::ostream& stream, const T& arg) {
+                constexpr e_argType argType = getArgType <T>();
+
+                if      constexpr (argType == ARG_TYPE_BOOL)    stream << static_cast <bool>     (arg);
+                else if constexpr (argType == ARG_TYPE_CHAR)    stream << static_cast <char>     (arg);
+                else if constexpr (argType == ARG_TYPE_INT32)   stream << static_cast <int32_t>  (arg);
+                else if constexpr (argType == ARG_TYPE_UINT32)  stream << static_cast <uint32_t> (arg);
+                else if constexpr (argType == ARG_TYPE_INT64)   stream << static_cast <int64_t>  (arg);
+                else if constexpr (argType == ARG_TYPE_UINT64)  stream << static_cast <uint64_t> (arg);
+                else if constexpr (argType == ARG_TYPE_FLOAT)   stream << static_cast <float>    (arg);
+                else if constexpr (argType == ARG_TYPE_DOUBLE)  stream << static_cast <double>   (arg);
+                else                                            stream << std::string_view       (arg);
+            }
+
+            void writeFormattedText (std::ostream& stream, const char* format) {
+                stream << format;
+            }
+
+            /* Replace each "{}" in the format string with the next arg, the offline decoder follows the same rules so
+             * that the text and decoded binary logs read the same
+            */
+            template <typename T, typename... Args>
+            void writeFormattedText (std::ostream& stream, const char* format, const T& arg, const Args&... args) {
+                const char* placeholder = std::strstr (format, "{}");
+                if (placeholder == nullptr) {
+                    stream << format;
+                    return;
+                }
+                stream.write (format, placeholder - format);
+                writeTextArg (stream, arg);
+                writeFormattedText (stream, placeholder + 2, args...);
+            }
+
+            template <typename... Args>
+            void registerSite (LGSite* site) {
+                /* Note that, the site id is only ever written once, so the lock is taken the first time a statement is
+                 * hit and never again
+                */
+                if (site->m_siteId.load (std::memory_order_acquire) != 0)
+                    return;
+
+                std::lock_guard <std::mutex> lock (m_siteMutex);
+                if (site->m_siteId.load (std::memory_order_relaxed) == 0) {
+                    site->m_argTypes = {getArgType <Args>()...};
+                    site->m_siteId.store (++m_nextSiteId, std::memory_order_release);
+                }
+            }
+
+
+            void writeTextHeader (std::ostream& stream, const LGSite* site, const TickType tick) {
+                stream << getTimeStamp (tick)
+                       << " "
+                       << "[" << getLevelTypeString (site->m_levelType)  << "]"
+                       << " "
+                       << ALIGN_AND_PAD_L << site->m_function
+                       << " "
+                       << ALIGN_AND_PAD_S << site->m_line
+                       << " ";
+            }
+
+            /* Summaries are written as plain text (text records in the binary sink), attributed to the site they
+             * summarize
+            */
+            void writeSummaryRecord (const LGSite* site,
+                                     const e_sinkType sinkType,
+                                     const TickType tick,
+                                     const char* summary,
+                                     const uint32_t recordsCount) {
+
+                auto& resource = m_logInfo.resource;
+                std::stringstream stream;
+                writeTextHeader (stream, site, tick);
+                stream << summary << " " << "[" << recordsCount << "]" << "\n";
+
+                auto text                  = stream.view();
+                bool tickReferenceRequired = m_logInfo.meta.timeStampType != TIME_STAMP_TYPE_WALL_CLOCK;
+                if (sinkType & SINK_TYPE_CONSOLE)
+                    resource.consoleSinkObj->writeText      (text, true, tickReferenceRequired);
+                if (sinkType & SINK_TYPE_FILE)
+                    resource.fileSinkObj->writeText         (text, true, tickReferenceRequired);
+                if (sinkType & SINK_TYPE_BINARY)
+                    resource.binarySinkObj->writeTextRecord (tick, getFrameIdx(), text, false);
+            }
+
+            /* FNV-1a, only used to tell whether a record carries the same args as the previous one from its site */
+            uint64_t getArgsHash (const std::vector <uint8_t>& argBytes) {
+                uint64_t hash = 14695981039346656037ull;
+                for (auto const& byte: argBytes) {
+                    hash ^= byte;
+                    hash *= 1099511628211ull;
+                }
+                return hash;
+            }
+
+            void addPendingSite (LGSite* site, const TickType windowEndTick) {
+                std::lock_guard <std::mutex> lock (m_pendingSiteMutex);
+                m_logInfo.meta.pendingSites.insert (site);
+                if (windowEndTick < m_nextSummaryTick.load (std::memory_order_relaxed))
+                    m_nextSummaryTick.store (windowEndTick, std::memory_order_relaxed);
+            }
+
+            /* Write out the counts of the pending sites whose window has ended (or of every pending site, when the
+             * logger is going away), so that the summary of a site is not held back until its next record
+            */
+            void flushPendingSummaries (const TickType tick, const bool expiredWindowRequired) {
+                auto& meta = m_logInfo.meta;
+                std::vector <std::tuple <LGSite*, uint32_t, uint32_t>> summaries;
+                {
+                    std::lock_guard <std::mutex> lock (m_pendingSiteMutex);
+                    TickType nextSummaryTick = std::numeric_limits <TickType>::max();
+
+                    for (auto it = meta.pendingSites.begin(); it != meta.pendingSites.end();) {
+                        LGSite* site = *it;
+                        std::lock_guard <std::mutex> siteLock (site->m_limitMutex);
+                        TickType windowEndTick = site->m_windowStartTick +
+                                                 meta.levelTypeToRateLimitInfoMap[site->m_levelType].windowTicks;
+
+                        if (expiredWindowRequired && tick < windowEndTick) {
+                            nextSummaryTick = std::min (nextSummaryTick, windowEndTick);
+                            it++;
+                            continue;
+                        }
+                        summaries.push_back ({site, site->m_repeatedRecordsCount, site->m_suppressedRecordsCount});
+                        site->m_repeatedRecordsCount   = 0;
+                        site->m_suppressedRecordsCount = 0;
+                        it = meta.pendingSites.erase (it);
+                    }
+                    m_nextSummaryTick.store (nextSummaryTick, std::memory_order_relaxed);
+                }
+
+                for (auto const& [site, repeatedRecordsCount, suppressedRecordsCount]: summaries) {
+                    auto sinkType = meta.levelTypeToSinkTypeMap[site->m_levelType];
+                    if (repeatedRecordsCount != 0)
+                        writeSummaryRecord (site, sinkType, tick, "Last message repeated", repeatedRecordsCount);
+                    if (suppressedRecordsCount != 0)
+                        writeSummaryRecord (site, sinkType, tick, "Messages suppressed", suppressedRecordsCount);
+                }
+            }
+
+            /* A site may write at most maxRecordsCount records per window, and a record with the same args as the
+             * previous one from the same site is collapsed into a count. Counts are written out as summaries ahead of
+             * the next record that goes through, or once the window has ended (see flushPendingSummaries), whichever
+             * comes first
+            */
+            bool isRecordAllowed (LGSite* site,
+                                  const e_sinkType sinkType,
+                                  const RateLimitInfo& rateLimitInfo,
+                                  const TickType tick,
+                                  const std::vector <uint8_t>& argBytes) {
+
+                uint64_t argsHash               = getArgsHash (argBytes);
+                uint32_t suppressedRecordsCount = 0;
+                uint32_t repeatedRecordsCount   = 0;
+                bool recordAllowed              = true;
+                TickType windowEndTick          = 0;
+                {
+                    std::lock_guard <std::mutex> lock (site->m_limitMutex);
+                    if (tick - site->m_windowStartTick >= rateLimitInfo.windowTicks) {
+                        suppressedRecordsCount         = site->m_suppressedRecordsCount;
+                        repeatedRecordsCount           = site->m_repeatedRecordsCount;
+                        site->m_windowStartTick        = tick;
+                        site->m_windowRecordsCount     = 0;
+                        site->m_suppressedRecordsCount = 0;
+                        site->m_repeatedRecordsCount   = 0;
+                    }
+
+                    if (!rateLimitInfo.repeatCollapsingDisabled &&
+                        site->m_windowRecordsCount != 0         && site->m_lastArgsHash == argsHash) {
+                        site->m_repeatedRecordsCount++;
+                        recordAllowed = false;
+                    }
+                    else if (rateLimitInfo.maxRecordsCount != 0 &&
+                             site->m_windowRecordsCount >= rateLimitInfo.maxRecordsCount) {
+                        site->m_suppressedRecordsCount++;
+                        recordAllowed = false;
+                    }
+                    else {
+                        repeatedRecordsCount          += site->m_repeatedRecordsCount;
+                        site->m_repeatedRecordsCount   = 0;
+                        site->m_windowRecordsCount++;
+                        site->m_lastArgsHash           = argsHash;
+                    }
+                    windowEndTick = site->m_windowStartTick + rateLimitInfo.windowTicks;
+                }
+                /* Added outside the site lock, since pending sites are flushed with the pending site lock held first */
+                if (!recordAllowed)
+                    addPendingSite (site, windowEndTick);
+
+                if (repeatedRecordsCount != 0)
+                    writeSummaryRecord (site, sinkType, tick, "Last message repeated", repeatedRecordsCount);
+                if (suppressedRecordsCount != 0)
+                    writeSummaryRecord (site, sinkType, tick, "Messages suppressed", suppressedRecordsCount);
+                return recordAllowed;
+            }
+
         public:
             LGImpl (void) {
-                m_logInfo = {};
+                m_logInfo         = {};
+                m_nextSummaryTick = std::numeric_limits <TickType>::max();
             }
 
             void initLogInfo (const std::string saveFileDirPath,
@@ -82,6 +362,7 @@ namespace Log {
                               const char* saveFileExtension = ".log") {
 
                 auto& meta        = m_logInfo.meta;
+                auto& resource    = m_logInfo.resource;
                 /* If we are using __FILE__ as save file name, strip path and extension to get just its name */
                 size_t stripStart = saveFileName.find_last_of ("\\/") + 1;
                 size_t stripEnd   = saveFileName.find_last_of ('.');
@@ -91,11 +372,26 @@ namespace Log {
                 meta.levelTypeToSinkTypeMap[LEVEL_TYPE_INFO]    = SINK_TYPE_CONSOLE;
                 meta.levelTypeToSinkTypeMap[LEVEL_TYPE_WARNING] = SINK_TYPE_CONSOLE;
                 meta.levelTypeToSinkTypeMap[LEVEL_TYPE_ERROR]   = SINK_TYPE_CONSOLE;
+                /* Warnings and errors are the ones that end up being written every frame when something goes wrong */
+                updateRateLimitConfig (LEVEL_TYPE_INFO,    0,  0,    true);
+                updateRateLimitConfig (LEVEL_TYPE_WARNING, 16, 1000, false);
+                updateRateLimitConfig (LEVEL_TYPE_ERROR,   16, 1000, false);
 
                 meta.saveFileDirPath                            = saveFileDirPath;
                 meta.saveFileName                               = saveFileName;
                 meta.saveFileExtension                          = saveFileExtension;
-                m_logInfo.state.activeSinkType                  = SINK_TYPE_NONE;
+                meta.timeStampType                              = TIME_STAMP_TYPE_WALL_CLOCK;
+
+                std::string saveFilePath                        = saveFileDirPath + "/" + saveFileName;
+                resource.consoleSinkObj                         = m_sinkRegistryObj.getConsoleSink();
+                resource.fileSinkObj                            = m_sinkRegistryObj.getFileSink (
+                                                                    SINK_TYPE_FILE,
+                                                                    saveFilePath + saveFileExtension
+                                                                  );
+                resource.binarySinkObj                          = m_sinkRegistryObj.getFileSink (
+                                                                    SINK_TYPE_BINARY,
+                                                                    saveFilePath + g_binaryFileExtension
+                                                                  );
             }
 
             LGImpl& getReference (void) {
@@ -106,64 +402,168 @@ namespace Log {
                 m_logInfo.meta.levelTypeToSinkTypeMap[levelType] = sinkType;
             }
 
+            /* Rotation and budget limits of the file and/or binary sink behind this logger. Note that, sinks are shared
+             * by every logger writing to the same path, so the limits apply to all of them
+            */
+            void updateSinkConfig (const e_sinkType sinkType,
+                                   const size_t maxFileSize,
+                                   const uint32_t maxRotatedFiles,
+                                   const size_t maxSessionSize) {
+
+                if (sinkType & SINK_TYPE_FILE)
+                    m_logInfo.resource.fileSinkObj->updateSinkConfig   (maxFileSize, maxRotatedFiles, maxSessionSize);
+                if (sinkType & SINK_TYPE_BINARY)
+                    m_logInfo.resource.binarySinkObj->updateSinkConfig (maxFileSize, maxRotatedFiles, maxSessionSize);
+            }
+
+            /* Rate limiting applies to format log statements (see LOG_FMT), which are the ones meant for hot paths. A
+             * maxRecordsCount of 0 leaves the number of records per window unbounded
+            */
+            void updateRateLimitConfig (const e_levelType levelType,
+                                        const uint32_t maxRecordsCount,
+                                        const uint32_t windowDurationMs,
+                                        const bool repeatCollapsingDisabled) {
+
+                using Period                           = std::chrono::steady_clock::period;
+                auto& rateLimitInfo                    = m_logInfo.meta.levelTypeToRateLimitInfoMap[levelType];
+                rateLimitInfo.maxRecordsCount          = maxRecordsCount;
+                rateLimitInfo.windowTicks              = static_cast <TickType> (windowDurationMs) *
+                                                         Period::den / (Period::num * 1000);
+                rateLimitInfo.repeatCollapsingDisabled = repeatCollapsingDisabled;
+            }
+
+            /* Start a new line in the pending record of this thread. Whatever is left of a previous line (one that was
+             * never terminated with std::endl) is written out first
+            */
             const char* updateActiveSinkType (const e_levelType levelType) {
-                m_logInfo.state.activeSinkType = m_logInfo.meta.levelTypeToSinkTypeMap[levelType];
+                auto& pendingRecord         = getPendingRecord();
+                if (!pendingRecord.stream.view().empty())
+                    writePendingRecord (pendingRecord);
+
+                pendingRecord.levelType     = levelType;
+                pendingRecord.sinkType      = m_logInfo.meta.levelTypeToSinkTypeMap[levelType];
+                pendingRecord.timeStampType = m_logInfo.meta.timeStampType;
+                pendingRecord.fileSinkObj   = m_logInfo.resource.fileSinkObj;
+                pendingRecord.binarySinkObj = m_logInfo.resource.binarySinkObj;
                 return "";
             }
 
-            std::string getTimeStamp (void) {
-                std::stringstream stream;
-                auto now = std::chrono::system_clock::now();
-                auto t_c = std::chrono::system_clock::to_time_t (now);
-                /* https://en.cppreference.com/w/cpp/io/manip/put_time */
-                stream << std::put_time (std::localtime (&t_c), "%F %T");
-                return stream.str();
-            }
-
-            const char* getLevelTypeString (const e_levelType levelType) {
-                switch (levelType) {
-                    case LEVEL_TYPE_INFO:       return "INFO";
-                    case LEVEL_TYPE_WARNING:    return "WARN";
-                    case LEVEL_TYPE_ERROR:      return "ERRO";
-                    default:                    return "UNDF";
+            /* Tick time stamps are cheap enough to leave on in hot paths, and precise enough to line up with frame
+             * timings. Wall clock time stamps are formatted once per second (per thread) and reused in between
+            */
+            void updateTimeStampConfig (const e_timeStampType timeStampType) {
+                m_logInfo.meta.timeStampType = timeStampType;
+            }
+
+            /* Note that, the returned string is owned by the calling thread and is only valid until its next call */
+            const char* getTimeStamp (const TickType tick) {
+                thread_local char timeStamp[64];
+                thread_local std::time_t lastWallTime = -1;
+                auto timeStampType                    = m_logInfo.meta.timeStampType;
+
+                if (timeStampType == TIME_STAMP_TYPE_WALL_CLOCK) {
+                    auto wallTime = std::chrono::system_clock::to_time_t (std::chrono::system_clock::now());
+                    if (wallTime != lastWallTime) {
+                        /* https://en.cppreference.com/w/cpp/chrono/c/strftime */
+                        std::strftime (timeStamp, sizeof (timeStamp), "[%F %T]", std::localtime (&wallTime));
+                        lastWallTime = wallTime;
+                    }
+                    return timeStamp;
                 }
+
+                if (timeStampType == TIME_STAMP_TYPE_TICK)
+                    std::snprintf (timeStamp, sizeof (timeStamp), "[%" PRId64 "]", tick);
+                else
+                    std::snprintf (timeStamp, sizeof (timeStamp), "[%" PRId64 "] [%" PRIu64 "]",
+                                   tick,
+                                   getFrameIdx());
+                /* Invalidate the cached wall clock time stamp, since the buffer is shared */
+                lastWallTime = -1;
+                return timeStamp;
             }
+
+            const char* getTimeStamp (void) {
+                return getTimeStamp (m_logInfo.meta.timeStampType == TIME_STAMP_TYPE_WALL_CLOCK ? 0: getTick());
+            }
+
+            /* Frame index is process wide, and is expected to be bumped once at the start of every frame */
+            static void updateFrameIdx (void) {
+                m_frameIdx.fetch_add (1, std::memory_order_relaxed);
+            }
+
+            static FrameIdxType getFrameIdx (void) {
+                return m_frameIdx.load (std::memory_order_relaxed);
+            }
+
+            /* Format log statements (see LOG_FMT) are meant for hot paths. When routed to the binary sink, only the
+             * site id, a raw tick and the raw argument bytes are written; formatting is deferred to the offline decoder
+            */
+            template <typename... Args>
+            void writeFmtRecord (LGSite* site, const Args&... args) {
+                auto& meta          = m_logInfo.meta;
+                auto& resource      = m_logInfo.resource;
+                auto sinkType       = meta.levelTypeToSinkTypeMap[site->m_levelType];
+                auto& rateLimitInfo = meta.levelTypeToRateLimitInfoMap[site->m_levelType];
+                bool flushRequired  = site->m_levelType != LEVEL_TYPE_INFO;
+                if (sinkType == SINK_TYPE_NONE)
+                    return;
+                registerSite <Args...> (site);
+
+                /* Arguments are encoded outside the sink lock, into a buffer that is reused across calls. They are also
+                 * needed to tell repeated records apart, when rate limiting is enabled
+                */
+                thread_local std::vector <uint8_t> argBytes;
+                bool rateLimitEnabled = rateLimitInfo.maxRecordsCount != 0 || !rateLimitInfo.repeatCollapsingDisabled;
+                TickType tick         = getTick();
+                if (tick >= m_nextSummaryTick.load (std::memory_order_relaxed))
+                    flushPendingSummaries (tick, true);
+                if ((sinkType & SINK_TYPE_BINARY) || rateLimitEnabled) {
+                    argBytes.clear();
+                    (writeArg (argBytes, args), ...);
+                }
+                if (rateLimitEnabled && !isRecordAllowed (site, sinkType, rateLimitInfo, tick, argBytes))
+                    return;
+
+                if (sinkType & SINK_TYPE_BINARY)
+                    resource.binarySinkObj->writeFmtRecord (site,
+                                                            tick,
+                                                            getFrameIdx(),
+                                                            argBytes,
+                                                            site->m_levelType == LEVEL_TYPE_ERROR);
+
+                if (sinkType & (SINK_TYPE_CONSOLE | SINK_TYPE_FILE)) {
+                    std::stringstream stream;
+                    writeTextHeader    (stream, site, tick);
+                    writeFormattedText (stream, site->m_format, args...);
+                    stream << "\n";
+
+                    auto text                  = stream.view();
+                    bool tickReferenceRequired = meta.timeStampType != TIME_STAMP_TYPE_WALL_CLOCK;
+                    if (sinkType & SINK_TYPE_CONSOLE)
+                        resource.consoleSinkObj->writeText (text, flushRequired, tickReferenceRequired);
+                    if (sinkType & SINK_TYPE_FILE)
+                        resource.fileSinkObj->writeText    (text, flushRequired, tickReferenceRequired);
+                }
+            }
+
             /* We are using an explicit overload of operator << for std::endl only, and other templated for everything
              * else (https://stackoverflow.com/questions/17595957/operator-overloading-in-c-for-logging-purposes)
             */
             template <typename T>
             LGImpl& operator << (const T& data) {
-                auto& meta           = m_logInfo.meta;
-                auto& activeSinkType = m_logInfo.state.activeSinkType;
-                auto& file           = m_logInfo.resource.file;
-
-                if (activeSinkType & SINK_TYPE_CONSOLE)
-                    std::cout << data;
-
-                if (activeSinkType & SINK_TYPE_FILE) {
-                    file.open (meta.saveFileDirPath + "/" +
-                               meta.saveFileName    +
-                               meta.saveFileExtension, std::ios::app);
-                    file << data;
-                    file.close();
-                }
+                auto& pendingRecord = getPendingRecord();
+                /* Skip formatting altogether for levels that are not routed anywhere */
+                if (pendingRecord.sinkType != SINK_TYPE_NONE)
+                    pendingRecord.stream << data;
                 return *this;
             }
 
             LGImpl& operator << (EndlType endl) {
-                auto& meta           = m_logInfo.meta;
-                auto& activeSinkType = m_logInfo.state.activeSinkType;
-                auto& file           = m_logInfo.resource.file;
-
-                if (activeSinkType & SINK_TYPE_CONSOLE)
-                    std::cout << endl;
-
-                if (activeSinkType & SINK_TYPE_FILE) {
-                    file.open (meta.saveFileDirPath + "/" +
-                               meta.saveFileName    +
-                               meta.saveFileExtension, std::ios::app);
-                    file << endl;
-                    file.close();
+                static_cast <void> (endl);
+                auto& pendingRecord = getPendingRecord();
+                if (pendingRecord.sinkType != SINK_TYPE_NONE) {
+                    pendingRecord.stream << "\n";
+                    writePendingRecord (pendingRecord);
                 }
                 return *this;
             }
@@ -179,5 +579,14 @@ namespace Log {
             void onUpdate (void) override {
                 /* Do nothing */
             }
+
+            /* Sinks are owned by the registry, only the summaries still held by this logger are written out */
+            ~LGImpl (void) {
+                flushPendingSummaries (getTick(), false);
+            }
     };
+    LGSinkRegistry LGImpl::m_sinkRegistryObj;
+    std::mutex LGImpl::m_siteMutex;
+    SiteIdType LGImpl::m_nextSiteId = 0;
+    std::atomic <FrameIdxType> LGImpl::m_frameIdx {0};
 }   // namespace Log
\ No newline at end of file
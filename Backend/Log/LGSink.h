@@ -0,0 +1,510 @@
+#pragma once
+#include "../Common.h"
+#include "LGType.h"
+/* A sink is the single owner of an output (console, text file or binary file) and is shared by every logger that
+ * writes to it. Loggers build complete lines/records on their own and only take the sink lock to append them, so
+ * statements from different threads never interleave mid line and contention is limited to loggers sharing a file
+*/
+namespace Log {
+    class LGSink {
+        private:
+            struct SinkInfo {
+                struct Meta {
+                    e_sinkType sinkType;
+                    std::string saveFilePath;
+                    std::vector <uint8_t> bufferedBytes;
+                    /* Binary sink */
+                    std::vector <bool> definedSiteFlags;
+                    TickType lastTick;
+                    FrameIdxType lastFrameIdx;
+                    /* Size of the file on disk (not counting buffered bytes), and the size reserved for it */
+                    size_t fileSize;
+                    size_t preallocatedSize;
+                    /* Bytes accepted by the sink in this session, across rotations */
+                    size_t sessionSize;
+                    size_t maxFileSize;
+                    uint32_t maxRotatedFiles;
+                    size_t maxSessionSize;
+                } meta;
+
+                struct State {
+                    bool binaryHeaderWritten;
+                    bool tickReferenceWritten;
+                    bool sessionBudgetExhausted;
+                } state;
+
+                struct Resource {
+                    int fileDescriptor;
+                    /* Called before the file is (re)opened, so that the registry can keep the open files count bounded
+                     * by closing the least recently written file, and once the sink gives up its file on its own (on
+                     * rotation or a failed open), so that the registry stops counting it
+                    */
+                    std::function <void (LGSink*)> fileOpenBinding;
+                    std::function <void (LGSink*)> fileCloseBinding;
+                } resource;
+            } m_sinkInfo;
+
+            std::mutex m_sinkMutex;
+            std::atomic <TickType> m_lastWriteTick;
+
+            void openFile (void) {
+                auto& meta     = m_sinkInfo.meta;
+                auto& resource = m_sinkInfo.resource;
+                if (resource.fileDescriptor != -1)
+                    return;
+
+                if (resource.fileOpenBinding)
+                    resource.fileOpenBinding (this);
+                resource.fileDescriptor = open (meta.saveFilePath.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+                if (resource.fileDescriptor == -1) {
+                    if (resource.fileCloseBinding)
+                        resource.fileCloseBinding (this);
+                    return;
+                }
+
+                off_t fileSize          = lseek (resource.fileDescriptor, 0, SEEK_END);
+                meta.fileSize           = fileSize == -1 ? 0: static_cast <size_t> (fileSize);
+                meta.preallocatedSize   = meta.fileSize;
+            }
+
+            /* Closes the file without telling the registry, which is what the registry itself needs when evicting
+             * the sink (see tryCloseFile)
+            */
+            void releaseFile (void) {
+                auto& resource = m_sinkInfo.resource;
+                if (resource.fileDescriptor == -1)
+                    return;
+                /* Give back the space reserved past the end of the file */
+                if (m_sinkInfo.meta.preallocatedSize > m_sinkInfo.meta.fileSize)
+                    static_cast <void> (ftruncate (resource.fileDescriptor,
+                                                   static_cast <off_t> (m_sinkInfo.meta.fileSize)));
+                close (resource.fileDescriptor);
+                resource.fileDescriptor = -1;
+            }
+
+            void closeFile (void) {
+                auto& resource = m_sinkInfo.resource;
+                if (resource.fileDescriptor == -1)
+                    return;
+
+                releaseFile();
+                if (resource.fileCloseBinding)
+                    resource.fileCloseBinding (this);
+            }
+
+            /* Reserve disk space ahead of the write offset so that appends do not have to extend the file block by
+             * block. The visible file size is left as is, so readers (and a crash) never see a zero filled tail
+            */
+            void preallocateFile (const size_t writeSize) {
+                auto& meta         = m_sinkInfo.meta;
+                if (meta.fileSize + writeSize <= meta.preallocatedSize)
+                    return;
+
+                size_t targetSize  = meta.fileSize + writeSize + g_preallocationSize;
+                if (meta.maxFileSize != 0)
+                    targetSize     = std::max (std::min (targetSize, meta.maxFileSize), meta.fileSize + writeSize);
+                off_t offset       = static_cast <off_t> (meta.preallocatedSize);
+                off_t length       = static_cast <off_t> (targetSize - meta.preallocatedSize);
+#if __linux__
+                fallocate (m_sinkInfo.resource.fileDescriptor, FALLOC_FL_KEEP_SIZE, offset, length);
+#elif __APPLE__
+                fstore_t store     = {F_ALLOCATECONTIG, F_PEOFPOSMODE, 0, length, 0};
+                if (fcntl (m_sinkInfo.resource.fileDescriptor, F_PREALLOCATE, &store) == -1) {
+                    store.fst_flags = F_ALLOCATEALL;
+                    fcntl (m_sinkInfo.resource.fileDescriptor, F_PREALLOCATE, &store);
+                }
+                static_cast <void> (offset);
+#else
+                static_cast <void> (offset);
+                static_cast <void> (length);
+#endif  // __linux__
+                /* Preallocation is only a hint, a failure here shows up (if at all) as a failed write */
+                meta.preallocatedSize = targetSize;
+            }
+
+            /* Writes the buffered bytes to the file as it is, without (re)opening it */
+            void writeBuffer (void) {
+                auto& meta           = m_sinkInfo.meta;
+                auto& fileDescriptor = m_sinkInfo.resource.fileDescriptor;
+                if (meta.bufferedBytes.empty())
+                    return;
+
+                if (fileDescriptor != -1) {
+                    preallocateFile (meta.bufferedBytes.size());
+
+                    size_t writeOffset = 0;
+                    while (writeOffset < meta.bufferedBytes.size()) {
+                        ssize_t writeSize = write (fileDescriptor,
+                                                   meta.bufferedBytes.data() + writeOffset,
+                                                   meta.bufferedBytes.size() - writeOffset);
+                        if (writeSize <= 0)
+                            break;
+                        writeOffset      += static_cast <size_t> (writeSize);
+                    }
+                    meta.fileSize += writeOffset;
+                }
+                /* Bytes that could not be written are dropped, logging must never stall or throw */
+                meta.bufferedBytes.clear();
+            }
+
+            void flushBuffer (void) {
+                if (m_sinkInfo.meta.bufferedBytes.empty())
+                    return;
+
+                openFile();
+                writeBuffer();
+            }
+
+            /* The current file is moved to <path>.1, <path>.1 to <path>.2 and so on, dropping the oldest. A new file
+             * starts at the next write, with its own binary header, site records and tick reference
+            */
+            void rotateFile (void) {
+                auto& meta     = m_sinkInfo.meta;
+                auto& state    = m_sinkInfo.state;
+                flushBuffer();
+                closeFile();
+
+                std::string rotatedFilePath = meta.saveFilePath + "." + std::to_string (meta.maxRotatedFiles);
+                std::remove (rotatedFilePath.c_str());
+                for (uint32_t i = meta.maxRotatedFiles; i > 1; i--)
+                    std::rename ((meta.saveFilePath + "." + std::to_string (i - 1)).c_str(),
+                                 (meta.saveFilePath + "." + std::to_string (i)).c_str());
+                if (meta.maxRotatedFiles != 0)
+                    std::rename (meta.saveFilePath.c_str(), (meta.saveFilePath + ".1").c_str());
+                else
+                    std::remove (meta.saveFilePath.c_str());
+
+                meta.definedSiteFlags      = {};
+                meta.fileSize              = 0;
+                meta.preallocatedSize      = 0;
+                state.binaryHeaderWritten  = false;
+                state.tickReferenceWritten = false;
+            }
+
+            /* Returns false if the record has to be dropped since the session budget is used up. The first dropped
+             * record is replaced by a notice. The record size is only used to decide on the budget and rotation, since
+             * a rotation changes what has to be written ahead of the record; the bytes actually buffered for it are
+             * charged afterwards (see chargeRecord)
+            */
+            bool isRecordAccepted (const size_t recordSize) {
+                auto& meta  = m_sinkInfo.meta;
+                auto& state = m_sinkInfo.state;
+
+                if (meta.maxSessionSize != 0 && meta.sessionSize + recordSize > meta.maxSessionSize) {
+                    if (!state.sessionBudgetExhausted) {
+                        state.sessionBudgetExhausted = true;
+                        const char* notice           = "Session budget exhausted, dropping further records\n";
+                        if (meta.sinkType == SINK_TYPE_BINARY) {
+                            if (!state.binaryHeaderWritten)
+                                writeBinaryHeader();
+                            writeBytes           (meta.bufferedBytes, static_cast <uint8_t> (RECORD_TYPE_TEXT));
+                            writeTickAndFrameIdx (getTick(), meta.lastFrameIdx);
+                            writeString          (meta.bufferedBytes, notice);
+                        }
+                        else
+                            meta.bufferedBytes.insert (meta.bufferedBytes.end(), notice, notice + std::strlen (notice));
+                        flushBuffer();
+                    }
+                    return false;
+                }
+
+                if (meta.maxFileSize != 0 && meta.fileSize + meta.bufferedBytes.size() + recordSize > meta.maxFileSize)
+                    rotateFile();
+                return true;
+            }
+
+            /* Charge everything buffered since the record offset (the record along with the header, site record or tick
+             * reference written ahead of it) to the session budget
+            */
+            void chargeRecord (const size_t recordOffset) {
+                auto& meta        = m_sinkInfo.meta;
+                meta.sessionSize += meta.bufferedBytes.size() - recordOffset;
+            }
+
+            uint64_t getZigZag (const int64_t delta) {
+                return (static_cast <uint64_t> (delta) << 1) ^ static_cast <uint64_t> (delta >> 63);
+            }
+
+            /* Encoded size of a binary record in the current file, counting the header and site record if they are yet
+             * to be written. The payload is the raw argument bytes of a fmt record, or the string of a text record
+            */
+            size_t getBinaryRecordSize (const LGSite* site,
+                                        const TickType tick,
+                                        const FrameIdxType frameIdx,
+                                        const size_t payloadSize) {
+
+                auto& meta                = m_sinkInfo.meta;
+                TickType lastTick         = meta.lastTick;
+                FrameIdxType lastFrameIdx = meta.lastFrameIdx;
+                size_t recordSize         = sizeof (uint8_t) + payloadSize;
+
+                if (!m_sinkInfo.state.binaryHeaderWritten) {
+                    recordSize           += std::strlen (g_binaryFileMagic) + sizeof (g_binaryFileVersion) +
+                                            4 * sizeof (int64_t);
+                    lastTick              = getTick();
+                    lastFrameIdx          = 0;
+                }
+                if (site != nullptr) {
+                    SiteIdType siteId     = site->m_siteId.load (std::memory_order_relaxed);
+                    recordSize           += getVarintSize (siteId);
+                    if (siteId >= meta.definedSiteFlags.size() || !meta.definedSiteFlags[siteId])
+                        recordSize       += sizeof (uint8_t) + getVarintSize (siteId) + sizeof (uint8_t) +
+                                            sizeof (site->m_line) +
+                                            3 * sizeof (uint32_t) + std::strlen (site->m_file) +
+                                                                    std::strlen (site->m_function) +
+                                                                    std::strlen (site->m_format) +
+                                            sizeof (uint8_t) + site->m_argTypes.size();
+                }
+                recordSize               += getVarintSize (getZigZag (tick - lastTick));
+                recordSize               += getVarintSize (getZigZag (static_cast <int64_t> (frameIdx - lastFrameIdx)));
+                return recordSize;
+            }
+
+            /* Ticks and frame indices are written as the (zig-zag encoded) difference to the previous record in the
+             * file, which usually fits in 2-3 bytes (1 byte for frame indices) instead of 8. Records from different
+             * threads may reach the sink slightly out of order, which only results in a negative delta
+            */
+            void writeDelta (const int64_t delta) {
+                writeVarint (m_sinkInfo.meta.bufferedBytes, getZigZag (delta));
+            }
+
+            void writeTickAndFrameIdx (const TickType tick, const FrameIdxType frameIdx) {
+                auto& meta        = m_sinkInfo.meta;
+                writeDelta (tick - meta.lastTick);
+                writeDelta (static_cast <int64_t> (frameIdx - meta.lastFrameIdx));
+                meta.lastTick     = tick;
+                meta.lastFrameIdx = frameIdx;
+            }
+
+            /* Written ahead of the first tick based text line, so that ticks in text logs can be related to wall clock
+             * time the same way the binary header does
+            */
+            void writeTickReference (void) {
+                using Period  = std::chrono::steady_clock::period;
+                auto wallTime = std::chrono::system_clock::to_time_t (std::chrono::system_clock::now());
+                std::stringstream stream;
+                stream << "[" << std::put_time (std::localtime (&wallTime), "%F %T") << "]"
+                       << " "
+                       << "[" << getTick()                                           << "]"
+                       << " "
+                       << "Tick reference, period"
+                       << " "
+                       << "[" << Period::num << "/" << Period::den                   << "]"
+                       << "\n";
+
+                auto& meta    = m_sinkInfo.meta;
+                auto text     = stream.str();
+                if (meta.sinkType == SINK_TYPE_CONSOLE)
+                    std::cout.write (text.data(), static_cast <std::streamsize> (text.size()));
+                else
+                    meta.bufferedBytes.insert (meta.bufferedBytes.end(), text.begin(), text.end());
+                m_sinkInfo.state.tickReferenceWritten = true;
+            }
+
+            void writeBinaryHeader (void) {
+                using Period        = std::chrono::steady_clock::period;
+                auto& bufferedBytes = m_sinkInfo.meta.bufferedBytes;
+                auto wallTime       = std::chrono::system_clock::to_time_t (std::chrono::system_clock::now());
+
+                bufferedBytes.insert (bufferedBytes.end(),
+                                      g_binaryFileMagic,
+                                      g_binaryFileMagic + std::strlen (g_binaryFileMagic));
+                writeBytes (bufferedBytes, g_binaryFileVersion);
+                writeBytes (bufferedBytes, static_cast <int64_t> (Period::num));
+                writeBytes (bufferedBytes, static_cast <int64_t> (Period::den));
+                writeBytes (bufferedBytes, m_sinkInfo.meta.lastTick = getTick());
+                writeBytes (bufferedBytes, static_cast <int64_t> (wallTime));
+                m_sinkInfo.meta.lastFrameIdx         = 0;
+                m_sinkInfo.state.binaryHeaderWritten = true;
+            }
+
+            void writeSiteRecord (const LGSite* site) {
+                auto& bufferedBytes = m_sinkInfo.meta.bufferedBytes;
+                writeBytes  (bufferedBytes, static_cast <uint8_t> (RECORD_TYPE_SITE));
+                writeVarint (bufferedBytes, site->m_siteId.load (std::memory_order_relaxed));
+                writeBytes  (bufferedBytes, static_cast <uint8_t> (site->m_levelType));
+                writeBytes  (bufferedBytes, site->m_line);
+                writeString (bufferedBytes, site->m_file);
+                writeString (bufferedBytes, site->m_function);
+                writeString (bufferedBytes, site->m_format);
+                writeBytes  (bufferedBytes, static_cast <uint8_t> (site->m_argTypes.size()));
+                for (auto const& argType: site->m_argTypes)
+                    writeBytes (bufferedBytes, static_cast <uint8_t> (argType));
+            }
+
+        public:
+            LGSink (void) {
+                m_sinkInfo      = {};
+                m_lastWriteTick = 0;
+            }
+
+            void initSinkInfo (const e_sinkType sinkType,
+                               const std::string saveFilePath,
+                               const std::function <void (LGSink*)> fileOpenBinding,
+                               const std::function <void (LGSink*)> fileCloseBinding) {
+
+                auto& meta                              = m_sinkInfo.meta;
+                meta.sinkType                           = sinkType;
+                meta.saveFilePath                       = saveFilePath;
+                meta.bufferedBytes                      = {};
+                meta.definedSiteFlags                   = {};
+                meta.lastTick                           = 0;
+                meta.lastFrameIdx                       = 0;
+                /* The file is only opened at the first flush, while rotation is decided as records come in. Files are
+                 * appended to, so a file left by an earlier session counts towards the max file size from the start
+                */
+                struct stat fileStat;
+                meta.fileSize                           = sinkType != SINK_TYPE_CONSOLE &&
+                                                          stat (saveFilePath.c_str(), &fileStat) == 0 ?
+                                                          static_cast <size_t> (fileStat.st_size): 0;
+                meta.preallocatedSize                   = 0;
+                meta.sessionSize                        = 0;
+                meta.maxFileSize                        = g_maxFileSize;
+                meta.maxRotatedFiles                    = g_maxRotatedFiles;
+                meta.maxSessionSize                     = 0;
+                if (sinkType != SINK_TYPE_CONSOLE)
+                    meta.bufferedBytes.reserve (g_maxSinkBufferSize);
+
+                m_sinkInfo.state.binaryHeaderWritten    = false;
+                m_sinkInfo.state.tickReferenceWritten   = false;
+                m_sinkInfo.state.sessionBudgetExhausted = false;
+                m_sinkInfo.resource.fileDescriptor      = -1;
+                m_sinkInfo.resource.fileOpenBinding     = fileOpenBinding;
+                m_sinkInfo.resource.fileCloseBinding    = fileCloseBinding;
+            }
+
+            /* A maxFileSize of 0 disables rotation, and a maxSessionSize of 0 leaves the bytes written per session
+             * unbounded
+            */
+            void updateSinkConfig (const size_t maxFileSize,
+                                   const uint32_t maxRotatedFiles,
+                                   const size_t maxSessionSize) {
+
+                std::lock_guard <std::mutex> lock (m_sinkMutex);
+                auto& meta           = m_sinkInfo.meta;
+                meta.maxFileSize     = maxFileSize;
+                meta.maxRotatedFiles = maxRotatedFiles;
+                meta.maxSessionSize  = maxSessionSize;
+            }
+
+            TickType getLastWriteTick (void) {
+                return m_lastWriteTick.load (std::memory_order_relaxed);
+            }
+
+            /* Text is written as complete lines. The console is flushed on every line (same as std::endl) whereas files
+             * are only flushed when asked to, which is the case for warnings and errors, or once the buffer is full
+            */
+            void writeText (const std::string_view text, const bool flushRequired, const bool tickReferenceRequired) {
+                std::lock_guard <std::mutex> lock (m_sinkMutex);
+                auto& meta = m_sinkInfo.meta;
+                m_lastWriteTick.store (getTick(), std::memory_order_relaxed);
+
+                if (meta.sinkType == SINK_TYPE_CONSOLE) {
+                    if (tickReferenceRequired && !m_sinkInfo.state.tickReferenceWritten)
+                        writeTickReference();
+                    std::cout.write (text.data(), static_cast <std::streamsize> (text.size()));
+                    std::cout.flush();
+                    return;
+                }
+
+                if (!isRecordAccepted (text.size()))
+                    return;
+                size_t recordOffset = meta.bufferedBytes.size();
+                if (tickReferenceRequired && !m_sinkInfo.state.tickReferenceWritten)
+                    writeTickReference();
+                meta.bufferedBytes.insert (meta.bufferedBytes.end(), text.begin(), text.end());
+                chargeRecord (recordOffset);
+
+                if (meta.bufferedBytes.size() >= g_maxSinkBufferSize || flushRequired)
+                    flushBuffer();
+            }
+
+            /* Append a fmt record, with the argument bytes already encoded by the caller. The site record is written
+             * ahead of the first fmt record of a site in this file
+            */
+            void writeFmtRecord (const LGSite* site,
+                                 const TickType tick,
+                                 const FrameIdxType frameIdx,
+                                 const std::vector <uint8_t>& argBytes,
+                                 const bool flushRequired) {
+
+                std::lock_guard <std::mutex> lock (m_sinkMutex);
+                auto& meta        = m_sinkInfo.meta;
+                SiteIdType siteId = site->m_siteId.load (std::memory_order_relaxed);
+                m_lastWriteTick.store (tick, std::memory_order_relaxed);
+
+                if (!isRecordAccepted (getBinaryRecordSize (site, tick, frameIdx, argBytes.size())))
+                    return;
+                size_t recordOffset = meta.bufferedBytes.size();
+                if (!m_sinkInfo.state.binaryHeaderWritten)
+                    writeBinaryHeader();
+
+                if (siteId >= meta.definedSiteFlags.size())
+                    meta.definedSiteFlags.resize (siteId + 1, false);
+                if (!meta.definedSiteFlags[siteId]) {
+                    writeSiteRecord (site);
+                    meta.definedSiteFlags[siteId] = true;
+                }
+
+                writeBytes           (meta.bufferedBytes, static_cast <uint8_t> (RECORD_TYPE_FMT));
+                writeVarint          (meta.bufferedBytes, siteId);
+                writeTickAndFrameIdx (tick, frameIdx);
+                meta.bufferedBytes.insert (meta.bufferedBytes.end(), argBytes.begin(), argBytes.end());
+                chargeRecord (recordOffset);
+
+                if (meta.bufferedBytes.size() >= g_maxSinkBufferSize || flushRequired)
+                    flushBuffer();
+            }
+
+            void writeTextRecord (const TickType tick,
+                                  const FrameIdxType frameIdx,
+                                  const std::string_view text,
+                                  const bool flushRequired) {
+
+                std::lock_guard <std::mutex> lock (m_sinkMutex);
+                auto& meta = m_sinkInfo.meta;
+                m_lastWriteTick.store (tick, std::memory_order_relaxed);
+
+                if (!isRecordAccepted (getBinaryRecordSize (nullptr, tick, frameIdx, sizeof (uint32_t) + text.size())))
+                    return;
+                size_t recordOffset = meta.bufferedBytes.size();
+                if (!m_sinkInfo.state.binaryHeaderWritten)
+                    writeBinaryHeader();
+
+                writeBytes           (meta.bufferedBytes, static_cast <uint8_t> (RECORD_TYPE_TEXT));
+                writeTickAndFrameIdx (tick, frameIdx);
+                writeString          (meta.bufferedBytes, text);
+                chargeRecord (recordOffset);
+
+                if (meta.bufferedBytes.size() >= g_maxSinkBufferSize || flushRequired)
+                    flushBuffer();
+            }
+
+            /* Called by the registry to release a file handle. The lock is only tried, since the caller may itself be
+             * a sink waiting on a file slot, in which case another victim is picked instead. This is called with the
+             * registry lock held, so the file is never (re)opened here, and a sink without an open file keeps its
+             * buffered bytes for its next flush
+            */
+            bool tryCloseFile (void) {
+                std::unique_lock <std::mutex> lock (m_sinkMutex, std::try_to_lock);
+                if (!lock.owns_lock())
+                    return false;
+
+                if (m_sinkInfo.resource.fileDescriptor != -1)
+                    writeBuffer();
+                releaseFile();
+                return true;
+            }
+
+            ~LGSink (void) {
+                std::lock_guard <std::mutex> lock (m_sinkMutex);
+                /* Write out the remaining buffered records without going through the registry, which is being torn
+                 * down at this point
+                */
+                m_sinkInfo.resource.fileOpenBinding  = nullptr;
+                m_sinkInfo.resource.fileCloseBinding = nullptr;
+                flushBuffer();
+                closeFile();
+            }
+    };
+}   // namespace Log
\ No newline at end of file
@@ -0,0 +1,100 @@
+#pragma once
+#include "../Common.h"
+#include "LGSink.h"
+#include "LGType.h"
+/* Process wide owner of all sinks. Loggers are handles onto the sinks returned from here, so any number of loggers
+ * (across any number of threads) writing to the same path share one sink and one file handle. The registry also keeps
+ * the number of open files bounded, see g_maxOpenFiles
+*/
+namespace Log {
+    class LGSinkRegistry {
+        private:
+            struct SinkRegistryInfo {
+                struct Meta {
+                    std::unordered_map <std::string, LGSink*> pathToSinkObjMap;
+                    std::set <LGSink*> openSinkObjs;
+                } meta;
+
+                struct Resource {
+                    LGSink* consoleSinkObj;
+                } resource;
+            } m_sinkRegistryInfo;
+
+            std::mutex m_registryMutex;
+
+            /* Note that, this is called with the lock of the sink being opened held, and so victims are only ever
+             * try-locked (see LGSink::tryCloseFile)
+            */
+            void onFileOpen (LGSink* sinkObj) {
+                std::lock_guard <std::mutex> lock (m_registryMutex);
+                auto& openSinkObjs = m_sinkRegistryInfo.meta.openSinkObjs;
+
+                while (openSinkObjs.size() >= g_maxOpenFiles) {
+                    std::vector <LGSink*> victimSinkObjs;
+                    for (auto const& openSinkObj: openSinkObjs) {
+                        if (openSinkObj != sinkObj)
+                            victimSinkObjs.push_back (openSinkObj);
+                    }
+                    std::sort (victimSinkObjs.begin(), victimSinkObjs.end(), [](LGSink* a, LGSink* b) {
+                        return a->getLastWriteTick() < b->getLastWriteTick();
+                    });
+
+                    LGSink* closedSinkObj = nullptr;
+                    for (auto const& victimSinkObj: victimSinkObjs) {
+                        if (victimSinkObj->tryCloseFile()) {
+                            closedSinkObj = victimSinkObj;
+                            break;
+                        }
+                    }
+                    /* Every other file is busy, go over the limit for now rather than blocking */
+                    if (closedSinkObj == nullptr)
+                        break;
+                    openSinkObjs.erase (closedSinkObj);
+                }
+                openSinkObjs.insert (sinkObj);
+            }
+
+            /* Called with the lock of the sink being closed held, same as onFileOpen */
+            void onFileClose (LGSink* sinkObj) {
+                std::lock_guard <std::mutex> lock (m_registryMutex);
+                m_sinkRegistryInfo.meta.openSinkObjs.erase (sinkObj);
+            }
+
+        public:
+            LGSinkRegistry (void) {
+                m_sinkRegistryInfo = {};
+                m_sinkRegistryInfo.resource.consoleSinkObj = new LGSink();
+                m_sinkRegistryInfo.resource.consoleSinkObj->initSinkInfo (SINK_TYPE_CONSOLE, "", nullptr, nullptr);
+            }
+
+            LGSink* getConsoleSink (void) {
+                return m_sinkRegistryInfo.resource.consoleSinkObj;
+            }
+
+            /* Sinks are created on first request and opened on first write, so loggers that never write to a sink
+             * do not hold a file handle
+            */
+            LGSink* getFileSink (const e_sinkType sinkType, const std::string saveFilePath) {
+                std::lock_guard <std::mutex> lock (m_registryMutex);
+                auto& pathToSinkObjMap = m_sinkRegistryInfo.meta.pathToSinkObjMap;
+
+                if (pathToSinkObjMap.find (saveFilePath) != pathToSinkObjMap.end())
+                    return pathToSinkObjMap[saveFilePath];
+
+                auto sinkObj = new LGSink();
+                sinkObj->initSinkInfo (sinkType, saveFilePath, [this](LGSink* sinkObj) {
+                    onFileOpen (sinkObj);
+                }, [this](LGSink* sinkObj) {
+                    onFileClose (sinkObj);
+                });
+                pathToSinkObjMap[saveFilePath] = sinkObj;
+                return sinkObj;
+            }
+
+            ~LGSinkRegistry (void) {
+                for (auto const& [saveFilePath, sinkObj]: m_sinkRegistryInfo.meta.pathToSinkObjMap)
+                    delete sinkObj;
+                delete m_sinkRegistryInfo.resource.consoleSinkObj;
+            }
+    };
+}   // namespace Log
\ No newline at end of file
@@ -0,0 +1,199 @@
+#pragma once
+#include "../Common.h"
+
+namespace Log {
+    using SiteIdType                      = uint32_t;
+    using TickType                        = int64_t;
+    using FrameIdxType                    = uint64_t;
+
+    const char* g_binaryFileMagic         = "LGB1";
+    const char* g_binaryFileExtension     = ".lgb";
+    const uint32_t g_binaryFileVersion    = 2;
+    /* File sinks collect lines/records in memory and write them out once the buffer crosses this size, which keeps
+     * the cost of a log statement down to a clock read and a few copies
+    */
+    const size_t g_maxSinkBufferSize      = 64 * 1024;
+    /* Default rotation limits, a file is moved aside once it grows past g_maxFileSize and only the last
+     * g_maxRotatedFiles of those are kept, which bounds disk usage per sink to (g_maxRotatedFiles + 1) *
+     * g_maxFileSize. See LGSink::updateSinkConfig
+    */
+    const size_t g_maxFileSize            = 16 * 1024 * 1024;
+    const uint32_t g_maxRotatedFiles      = 4;
+    /* Disk space is reserved ahead of writes in chunks of this size, without changing the visible file size */
+    const size_t g_preallocationSize      = 1024 * 1024;
+    /* Upper bound on log files held open at once across all sinks, the least recently written file is closed (and
+     * re-opened in append mode on its next write) once the limit is reached
+    */
+    const uint32_t g_maxOpenFiles         = 16;
+
+    typedef enum {
+        LEVEL_TYPE_INFO    = 1,
+        LEVEL_TYPE_WARNING = 2,
+        LEVEL_TYPE_ERROR   = 4,
+    } e_levelType;
+
+    typedef enum {
+        SINK_TYPE_NONE     = 0,
+        SINK_TYPE_CONSOLE  = 1,
+        SINK_TYPE_FILE     = 2,
+        SINK_TYPE_BINARY   = 4
+    } e_sinkType;
+
+    /* Wall clock time stamps are formatted per record, whereas tick time stamps are the raw steady clock count. Tick
+     * based text logs carry a reference line (wall clock time and tick at the time of the first write) from which
+     * wall clock time can be derived
+    */
+    typedef enum {
+        TIME_STAMP_TYPE_WALL_CLOCK     = 0,
+        TIME_STAMP_TYPE_TICK           = 1,
+        TIME_STAMP_TYPE_TICK_AND_FRAME = 2
+    } e_timeStampType;
+
+    inline e_sinkType operator | (const e_sinkType sinkTypeA, const e_sinkType sinkTypeB) {
+        return static_cast <e_sinkType> (static_cast <int> (sinkTypeA) | static_cast <int> (sinkTypeB));
+    }
+
+    /* Binary log file layout
+     *  +-----------+-----------+-----------+-----------+     +-----------+
+     *  |  Header   |  Record   |  Record   |  Record   | ... |  Record   |
+     *  +-----------+-----------+-----------+-----------+     +-----------+
+     *
+     *  Header      magic, version, tick period (num, den), tick and wall clock time (seconds) captured at file open
+     *  Site        type, site id, level, line, file, function, format, args count, arg type per arg
+     *  Fmt         type, site id, tick, frame idx, raw argument bytes
+     *  Text        type, tick, frame idx, text
+     *
+     * A site record is written the first time a log statement is hit for a given file, so that every file can be
+     * decoded on its own. Fmt records then carry nothing but the site id, the tick and the raw argument bytes. Strings
+     * (in site, fmt and text records) are written as a uint32_t length followed by the characters. Text records hold
+     * the output of the stream based log macros when they are routed to the binary sink. Ticks and frame indices are
+     * written as zig-zag encoded differences to the previous record in the file
+    */
+    typedef enum {
+        RECORD_TYPE_SITE   = 1,
+        RECORD_TYPE_FMT    = 2,
+        RECORD_TYPE_TEXT   = 3
+    } e_recordType;
+
+    typedef enum {
+        ARG_TYPE_BOOL      = 1,
+        ARG_TYPE_CHAR      = 2,
+        ARG_TYPE_INT32     = 3,
+        ARG_TYPE_UINT32    = 4,
+        ARG_TYPE_INT64     = 5,
+        ARG_TYPE_UINT64    = 6,
+        ARG_TYPE_FLOAT     = 7,
+        ARG_TYPE_DOUBLE    = 8,
+        ARG_TYPE_STRING    = 9
+    } e_argType;
+
+    TickType getTick (void) {
+        return std::chrono::steady_clock::now().time_since_epoch().count();
+    }
+
+    const char* getLevelTypeString (const e_levelType levelType) {
+        switch (levelType) {
+            case LEVEL_TYPE_INFO:       return "INFO";
+            case LEVEL_TYPE_WARNING:    return "WARN";
+            case LEVEL_TYPE_ERROR:      return "ERRO";
+            default:                    return "UNDF";
+        }
+    }
+
+    /* A site is a single format log statement in source. Its id is assigned the first time the statement runs, along
+     * with the arg types which are only known at the point of the call
+    */
+    struct LGSite {
+        public:
+            e_levelType m_levelType;
+            const char* m_file;
+            const char* m_function;
+            uint32_t m_line;
+            const char* m_format;
+
+            std::atomic <SiteIdType> m_siteId;
+            std::vector <e_argType> m_argTypes;
+
+            /* Rate limit state, only touched (under the site lock) when rate limiting is enabled for the level */
+            std::mutex m_limitMutex;
+            TickType m_windowStartTick;
+            uint32_t m_windowRecordsCount;
+            uint32_t m_suppressedRecordsCount;
+            uint32_t m_repeatedRecordsCount;
+            uint64_t m_lastArgsHash;
+
+            LGSite (const e_levelType levelType,
+                    const char* file,
+                    const char* function,
+                    const uint32_t line,
+                    const char* format) {
+
+                m_levelType = levelType;
+                m_file      = file;
+                m_function  = function;
+                m_line      = line;
+                m_format    = format;
+                m_siteId    = 0;
+                m_argTypes  = {};
+
+                m_windowStartTick        = 0;
+                m_windowRecordsCount     = 0;
+                m_suppressedRecordsCount = 0;
+                m_repeatedRecordsCount   = 0;
+                m_lastArgsHash           = 0;
+            }
+    };
+
+    template <typename T>
+    constexpr e_argType getArgType (void) {
+        using U = std::decay_t <T>;
+
+        if      constexpr (std::is_enum_v <U>)
+            return getArgType <std::underlying_type_t <U>>();
+        else if constexpr (std::is_same_v <U, bool>)
+            return ARG_TYPE_BOOL;
+        else if constexpr (std::is_same_v <U, char>)
+            return ARG_TYPE_CHAR;
+        else if constexpr (std::is_integral_v <U> && std::is_signed_v <U>)
+            return sizeof (U) <= 4 ? ARG_TYPE_INT32:  ARG_TYPE_INT64;
+        else if constexpr (std::is_integral_v <U>)
+            return sizeof (U) <= 4 ? ARG_TYPE_UINT32: ARG_TYPE_UINT64;
+        else if constexpr (std::is_same_v <U, float>)
+            return ARG_TYPE_FLOAT;
+        else if constexpr (std::is_floating_point_v <U>)
+            return ARG_TYPE_DOUBLE;
+        else {
+            static_assert (std::is_convertible_v <const U&, std::string_view>, "Unsupported log arg type");
+            return ARG_TYPE_STRING;
+        }
+    }
+
+    template <typename T>
+    void writeBytes (std::vector <uint8_t>& bytes, const T& value) {
+        auto valueBytes = reinterpret_cast <const uint8_t*> (&value);
+        bytes.insert (bytes.end(), valueBytes, valueBytes + sizeof (T));
+    }
+
+    /* Variable length (LEB128) encoding, 7 bits per byte with the high bit set on all but the last byte */
+    void writeVarint (std::vector <uint8_t>& bytes, uint64_t value) {
+        while (value >= 0x80) {
+            bytes.push_back (static_cast <uint8_t> (value | 0x80));
+            value >>= 7;
+        }
+        bytes.push_back (static_cast <uint8_t> (value));
+    }
+
+    size_t getVarintSize (uint64_t value) {
+        size_t size = 1;
+        while (value >= 0x80) {
+            value >>= 7;
+            size++;
+        }
+        return size;
+    }
+
+    void writeString (std::vector <uint8_t>& bytes, const std::string_view value) {
+        writeBytes (bytes, static_cast <uint32_t> (value.size()));
+        bytes.insert (bytes.end(), value.begin(), value.end());
+    }
+}   // namespace Log
\ No newline at end of file
@@ -230,6 +230,61 @@ namespace Renderer {
                                 copyRegions.data());
     }
 
+    /* Fill every mip level of an image from a single buffer in one copy command, where each level is tightly packed
+     * starting at its own offset in the buffer (see SBTexturePool). This replaces generating the mip chain on the GPU
+     * with blitImageToMipMaps when the levels are already available on the host
+    */
+    void copyBufferToImageMipLevels (const VkCommandBuffer cmdBuffer,
+                                     const VkBuffer srcBuffer,
+                                     const VkImage dstImage,
+                                     const std::vector <VkDeviceSize>& srcOffsets,
+                                     const VkExtent3D extent,
+                                     const uint32_t baseArrayLayer,
+                                     const uint32_t layersCount,
+                                     const VkImageLayout imageLayout,
+                                     const VkImageAspectFlags aspectFlags,
+                                     std::vector <VkBufferImageCopy>& copyRegions) {
+
+        uint32_t mipLevels  = static_cast <uint32_t> (srcOffsets.size());
+        auto appendBarriers = std::vector <VkImageMemoryBarrier> {};
+        transitionImageLayout (cmdBuffer,
+                               dstImage,
+                               0,
+                               mipLevels,
+                               baseArrayLayer,
+                               layersCount,
+                               VK_IMAGE_LAYOUT_UNDEFINED,
+                               VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                               aspectFlags,
+                               appendBarriers);
+
+        for (uint32_t i = 0; i < mipLevels; i++) {
+            VkBufferImageCopy copyRegion;
+            copyRegion.bufferOffset                    = srcOffsets[i];
+            copyRegion.bufferRowLength                 = 0;
+            copyRegion.bufferImageHeight               = 0;
+            copyRegion.imageOffset                     = {0, 0, 0};
+            copyRegion.imageExtent                     = {
+                std::max (extent.width  >> i, 1u),
+                std::max (extent.height >> i, 1u),
+                1
+            };
+
+            copyRegion.imageSubresource.mipLevel       = i;
+            copyRegion.imageSubresource.baseArrayLayer = baseArrayLayer;
+            copyRegion.imageSubresource.layerCount     = layersCount;
+            copyRegion.imageSubresource.aspectMask     = aspectFlags;
+
+            copyRegions.push_back (copyRegion);
+        }
+        vkCmdCopyBufferToImage (cmdBuffer,
+                                srcBuffer,
+                                dstImage,
+                                imageLayout,
+                                static_cast <uint32_t> (copyRegions.size()),
+                                copyRegions.data());
+    }
+
     /* Mipmaps are precalculated, downscaled versions of an image. Each new image is half the width and height of the
      * previous one. Mipmaps are used as a form of Level of Detail or LOD. Objects that are far away from the camera will
      * sample their textures from the smaller mip images. Using smaller images increases the rendering speed and avoids
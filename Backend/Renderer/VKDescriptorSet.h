@@ -150,7 +150,9 @@ namespace Renderer {
             /* Note that vkUpdateDescriptorSets doesn't copy a buffer, for example, into the descriptor set, but rather
              * gives the descriptor set a pointer to the buffer described by VkDescriptorBufferInfo. So then this method
              * doesn't need to be called more than once for a descriptor set, since modifying the buffer that a
-             * descriptor set points to will update what the descriptor set sees
+             * descriptor set points to will update what the descriptor set sees. The writes are cleared once applied,
+             * since they point into the (caller owned) info vectors, which makes it safe to add and apply writes again
+             * later on (to swap out an image that was re-created, for instance)
             */
             void updateDescriptorSets (void) {
                 auto& writeSets = m_descriptorSetInfo.meta.writeSets;
@@ -159,6 +161,7 @@ namespace Renderer {
                                          writeSets.data(),
                                          0,
                                          nullptr);
+                writeSets.clear();
             }
 
             std::vector <VkDescriptorSet>& getDescriptorSets (void) {
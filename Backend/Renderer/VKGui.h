@@ -16,6 +16,13 @@
 namespace Renderer {
     class VKGui: public Collection::CNTypeInstanceBase {
         private:
+            struct TextureInfo {
+                VkDescriptorSet descriptorSet;
+                VkImageView imageView;
+                VkSampler sampler;
+                VkImageLayout imageLayout;
+            };
+
             struct GuiInfo {
                 struct Meta {
                     const char* iniSaveFilePath;
@@ -36,7 +43,7 @@ namespace Renderer {
                     VKSwapChain* swapChainObj;
                     VKRenderPass* renderPassObj;
                     VKDescriptorPool* descPoolObj;
-                    std::vector <VkDescriptorSet> descriptorSets;
+                    std::vector <TextureInfo> textureInfos;
                 } resource;
             } m_guiInfo;
 
@@ -351,8 +358,8 @@ namespace Renderer {
             }
 
             void destroyGui (void) {
-                for (auto const& descriptorSet: m_guiInfo.resource.descriptorSets)
-                    ImGui_ImplVulkan_RemoveTexture (descriptorSet);
+                for (auto const& textureInfo: m_guiInfo.resource.textureInfos)
+                    ImGui_ImplVulkan_RemoveTexture (textureInfo.descriptorSet);
 
                 ImPlot::DestroyContext();
                 ImGui_ImplVulkan_Shutdown();
@@ -416,7 +423,7 @@ namespace Renderer {
                 meta.iniSaveFilePath              = iniSaveFilePath;
                 meta.fontFilePath                 = fontFilePath;
                 meta.iconFilePath                 = iconFilePath;
-                m_guiInfo.resource.descriptorSets = {};
+                m_guiInfo.resource.textureInfos   = {};
             }
 
             ImTextureID addTexture (const VkImageView imageView,
@@ -424,10 +431,50 @@ namespace Renderer {
                                     const VkImageLayout imageLayout) {
 
                 auto descriptorSet = ImGui_ImplVulkan_AddTexture (sampler, imageView, imageLayout);
-                m_guiInfo.resource.descriptorSets.push_back      (descriptorSet);
+                m_guiInfo.resource.textureInfos.push_back        ({
+                    descriptorSet,
+                    imageView,
+                    sampler,
+                    imageLayout
+                });
                 return reinterpret_cast <ImTextureID>            (descriptorSet);
             }
 
+            /* Point every texture added with the old image view at the new one (an image that has been re-created, for
+             * instance), so that the texture ids handed out by addTexture stay valid. Note that, the descriptor sets
+             * must not be in use by the device
+            */
+            void updateTextures (const VkImageView oldImageView, const VkImageView newImageView) {
+                for (auto& textureInfo: m_guiInfo.resource.textureInfos) {
+                    if (textureInfo.imageView != oldImageView)
+                        continue;
+
+                    VkDescriptorImageInfo descriptorImageInfo;
+                    descriptorImageInfo.imageView       = newImageView;
+                    descriptorImageInfo.sampler         = textureInfo.sampler;
+                    descriptorImageInfo.imageLayout     = textureInfo.imageLayout;
+
+                    VkWriteDescriptorSet writeDescriptorSet;
+                    writeDescriptorSet.sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                    writeDescriptorSet.pNext            = nullptr;
+                    writeDescriptorSet.dstBinding       = 0;
+                    writeDescriptorSet.descriptorCount  = 1;
+                    writeDescriptorSet.dstArrayElement  = 0;
+                    writeDescriptorSet.descriptorType   = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+                    writeDescriptorSet.dstSet           = textureInfo.descriptorSet;
+                    writeDescriptorSet.pBufferInfo      = nullptr;
+                    writeDescriptorSet.pImageInfo       = &descriptorImageInfo;
+                    writeDescriptorSet.pTexelBufferView = nullptr;
+
+                    vkUpdateDescriptorSets (*m_guiInfo.resource.logDeviceObj->getLogDevice(),
+                                             1,
+                                             &writeDescriptorSet,
+                                             0,
+                                             nullptr);
+                    textureInfo.imageView               = newImageView;
+                }
+            }
+
             void toggleCursorInput (const bool val) {
                 auto& configFlags = ImGui::GetIO().ConfigFlags;
                 if (val)            configFlags &= ~ImGuiConfigFlags_NoMouse;
@@ -58,10 +58,8 @@ namespace Renderer {
                  * and try again
                 */
                 if (result == VK_ERROR_OUT_OF_DATE_KHR) {
-                    LOG_WARNING (resource.logObj) << "Failed to get swap chain image idx"
-                                                  << " "
-                                                  << "[" << string_VkResult (result) << "]"
-                                                  << std::endl;
+                    LOG_FMT_WARNING (resource.logObj, "Failed to get swap chain image idx [{}]",
+                                     string_VkResult (result));
 
                     for (auto const& binding: resource.viewPortResizeBindings) {
                         if (binding != nullptr)
@@ -120,10 +118,8 @@ namespace Renderer {
 
                 if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR ||
                     resource.windowObj->isWindowResized()) {
-                    LOG_WARNING (resource.logObj) << "Failed to present swap chain image"
-                                                  << " "
-                                                  << "[" << string_VkResult (result) << "]"
-                                                  << std::endl;
+                    LOG_FMT_WARNING (resource.logObj, "Failed to present swap chain image [{}]",
+                                     string_VkResult (result));
 
                     resource.windowObj->toggleWindowResized (false);
                     for (auto const& binding: resource.viewPortResizeBindings) {
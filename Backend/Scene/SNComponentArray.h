@@ -108,10 +108,7 @@ namespace Scene {
                 */
                 auto& meta = m_componentArrayInfo.meta;
                 if (meta.entityToIdxMap.find (entity) == meta.entityToIdxMap.end()) {
-                    LOG_ERROR (m_componentArrayInfo.resource.logObj) << "Component does not exist"
-                                                                     << " "
-                                                                     << "[" << entity << "]"
-                                                                     << std::endl;
+                    LOG_FMT_ERROR (m_componentArrayInfo.resource.logObj, "Component does not exist [{}]", entity);
                     throw std::runtime_error ("Component does not exist");
                 }
                 return &meta.array[meta.entityToIdxMap[entity]];
@@ -41,7 +41,7 @@ namespace SandBox {
      *  |   N/A             |   N/A             |   N/A             |   CORE            |   N/A             |
      *  |                   |                   |                   |   SWAP_CHAIN      |   ?               |
      *  |                   |                   |                   |   COPY_OPS        |                   |
-     *  |                   |                   |                   |   BLIT_OPS        |                   |
+     *  |                   |                   |                   |   STREAM_OPS      |                   |
      *  |                   |                   |                   |   DRAW_OPS        |                   |
      *  |                   |                   |                   |   IN_FLIGHT       |                   |
      *  |                   |                   |                   |   IMG_AVAILABLE   |                   |
@@ -55,7 +55,7 @@ namespace SandBox {
      *  |                   |   SKY_BOX         |   SHADOW_CONFIG   |                   |                   |
      *  |                   |   DEBUG           |   NORMAL          |                   |                   |
      *  |                   |                   |   POSITION        |                   |                   |
-     *  |                   |                   |   COLOR           |                   |                   |
+     *  |                   |                   |   COLOR           |   ARRAY           |                   |
      *  |                   |                   |   DEPTH           |                   |                   |
      *  |                   |                   |   GBUFFER         |                   |                   |
      *  |                   |                   |   TEXTURE         |                   |                   |
@@ -236,10 +236,10 @@ namespace SandBox {
 
         {   /* Buffer           [S_DEFAULT_VERTEX_STAGING] */
             auto batchingObj = resource.sceneObj->getSystem <SYMeshBatching>();
-            auto vertices    = batchingObj->getBatchedVertices (TAG_TYPE_STD_NO_ALPHA);
+            auto vertices    = batchingObj->getBatchedPackedVertices (TAG_TYPE_STD_NO_ALPHA);
             auto bufferObj   = new Renderer::VKBuffer (logObj, phyDeviceObj, logDeviceObj);
             bufferObj->initBufferInfo (
-                vertices.size() * sizeof (Vertex),
+                vertices.size() * sizeof (PackedVertex),
                 VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
                 {
@@ -254,12 +254,32 @@ namespace SandBox {
                 true
             );
         }
+        {   /* Buffer           [S_DEFAULT_POSITION_STAGING] */
+            auto batchingObj = resource.sceneObj->getSystem <SYMeshBatching>();
+            auto positions   = batchingObj->getBatchedPackedPositions (TAG_TYPE_STD_NO_ALPHA);
+            auto bufferObj   = new Renderer::VKBuffer (logObj, phyDeviceObj, logDeviceObj);
+            bufferObj->initBufferInfo (
+                positions.size() * sizeof (PackedPosition),
+                VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                {
+                    phyDeviceObj->getTransferQueueFamilyIdx()
+                },
+                false
+            );
+
+            collectionObj->addCollectionTypeInstance <Renderer::VKBuffer> ("S_DEFAULT_POSITION_STAGING", bufferObj);
+            bufferObj->updateBuffer (
+                positions.data(),
+                true
+            );
+        }
         {   /* Buffer           [S_DEFAULT_INDEX_STAGING] */
             auto batchingObj = resource.sceneObj->getSystem <SYMeshBatching>();
-            auto indices     = batchingObj->getBatchedIndices (TAG_TYPE_STD_NO_ALPHA);
+            auto indices     = batchingObj->getBatchedPackedIndices (TAG_TYPE_STD_NO_ALPHA);
             auto bufferObj   = new Renderer::VKBuffer (logObj, phyDeviceObj, logDeviceObj);
             bufferObj->initBufferInfo (
-                indices.size() * sizeof (IndexType),
+                indices.size(),
                 VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
                 {
@@ -276,10 +296,10 @@ namespace SandBox {
         }
         {   /* Buffer           [S_DEFAULT_VERTEX] */
             auto batchingObj = resource.sceneObj->getSystem <SYMeshBatching>();
-            auto vertices    = batchingObj->getBatchedVertices (TAG_TYPE_STD_NO_ALPHA);
+            auto vertices    = batchingObj->getBatchedPackedVertices (TAG_TYPE_STD_NO_ALPHA);
             auto bufferObj   = new Renderer::VKBuffer (logObj, phyDeviceObj, logDeviceObj);
             bufferObj->initBufferInfo (
-                vertices.size() * sizeof (Vertex),
+                vertices.size() * sizeof (PackedVertex),
                 VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
                 VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
                 {
@@ -291,12 +311,32 @@ namespace SandBox {
 
             collectionObj->addCollectionTypeInstance <Renderer::VKBuffer> ("S_DEFAULT_VERTEX", bufferObj);
         }
+        {   /* Buffer           [S_DEFAULT_POSITION] */
+            /* The depth only passes (shadow and shadow cube) fetch from this position only stream instead of the full
+             * packed vertices, with the same vertex offsets and index buffer
+            */
+            auto batchingObj = resource.sceneObj->getSystem <SYMeshBatching>();
+            auto positions   = batchingObj->getBatchedPackedPositions (TAG_TYPE_STD_NO_ALPHA);
+            auto bufferObj   = new Renderer::VKBuffer (logObj, phyDeviceObj, logDeviceObj);
+            bufferObj->initBufferInfo (
+                positions.size() * sizeof (PackedPosition),
+                VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                {
+                    phyDeviceObj->getGraphicsQueueFamilyIdx(),
+                    phyDeviceObj->getTransferQueueFamilyIdx()
+                },
+                true
+            );
+
+            collectionObj->addCollectionTypeInstance <Renderer::VKBuffer> ("S_DEFAULT_POSITION", bufferObj);
+        }
         {   /* Buffer           [S_DEFAULT_INDEX] */
             auto batchingObj = resource.sceneObj->getSystem <SYMeshBatching>();
-            auto indices     = batchingObj->getBatchedIndices (TAG_TYPE_STD_NO_ALPHA);
+            auto indices     = batchingObj->getBatchedPackedIndices (TAG_TYPE_STD_NO_ALPHA);
             auto bufferObj   = new Renderer::VKBuffer (logObj, phyDeviceObj, logDeviceObj);
             bufferObj->initBufferInfo (
-                indices.size() * sizeof (IndexType),
+                indices.size(),
                 VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
                 VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
                 {
@@ -595,7 +635,7 @@ namespace SandBox {
                 vertexInputBindings   = {
                     pipelineObj->createVertexInputBinding (
                         0,
-                        sizeof (Vertex),
+                        sizeof (PackedPosition),
                         VK_VERTEX_INPUT_RATE_VERTEX
                     )
                 };
@@ -603,8 +643,8 @@ namespace SandBox {
                     pipelineObj->createVertexInputAttribute (
                         0,
                         0,
-                        offsetof (Vertex, meta.position),
-                        VK_FORMAT_R32G32B32_SFLOAT
+                        offsetof (PackedPosition, position),
+                        VK_FORMAT_R16G16B16A16_UNORM
                     )
                 };
                 pipelineObj->createVertexInputState (
@@ -853,7 +893,7 @@ namespace SandBox {
                 vertexInputBindings   = {
                     pipelineObj->createVertexInputBinding (
                         0,
-                        sizeof (Vertex),
+                        sizeof (PackedPosition),
                         VK_VERTEX_INPUT_RATE_VERTEX
                     )
                 };
@@ -861,8 +901,8 @@ namespace SandBox {
                     pipelineObj->createVertexInputAttribute (
                         0,
                         0,
-                        offsetof (Vertex, meta.position),
-                        VK_FORMAT_R32G32B32_SFLOAT
+                        offsetof (PackedPosition, position),
+                        VK_FORMAT_R16G16B16A16_UNORM
                     )
                 };
                 pipelineObj->createVertexInputState (
@@ -1064,6 +1104,37 @@ namespace SandBox {
         auto phyDeviceObj   = collectionObj->getCollectionTypeInstance <Renderer::VKPhyDevice> ("CORE");
         auto logDeviceObj   = collectionObj->getCollectionTypeInstance <Renderer::VKLogDevice> ("CORE");
         auto swapChainObj   = collectionObj->getCollectionTypeInstance <Renderer::VKSwapChain> ("CORE");
+        /* Textures are block compressed (see SBTexturePool), fall back to RGBA8 for any format that the device can't
+         * sample from
+        */
+        for (auto const& info: resource.stdTexturePoolObj->getTexturePool()) {
+            auto imageFormat = Renderer::getSupportedImageFormat (
+                *phyDeviceObj->getPhyDevice(),
+                {
+                    info.format,
+                    VK_FORMAT_R8G8B8A8_SRGB
+                },
+                VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT,
+                VK_IMAGE_TILING_OPTIMAL
+            );
+            if (imageFormat != info.format)
+                resource.stdTexturePoolObj->decompressImage (info.idx);
+        }
+        resource.stdTexturePoolObj->packTextures();
+        /* Only the tail of the mip chain is uploaded here, the finer levels are streamed in once the textures are seen
+         * on screen (see streamTextures). Textures that can't be re-loaded once their host copy is freed (not cached),
+         * and textures that share an image with others (packed) are uploaded in full
+        */
+        for (auto const& info: resource.stdTexturePoolObj->getTexturePool())
+            resource.textureResidencyObj->addTexture (
+                info.idx,
+                info.width,
+                info.height,
+                info.mipLevels,
+                info.format,
+                !resource.stdTexturePoolObj->isImageReloadable (info.idx) ||
+                 resource.stdTexturePoolObj->isImagePacked     (info.idx)
+            );
         auto stdTexturePool = resource.stdTexturePoolObj->getTexturePool();
 
         {   /* Buffer           [G_DEFAULT_MESH_INSTANCE_?] */
@@ -1088,12 +1159,34 @@ namespace SandBox {
                 );
             }
         }
-        {   /* Buffer           [G_DEFAULT_TEXTURE_STAGING_?] */
-            for (auto const& [idx, info]: stdTexturePool) {
+        {   /* Buffer           [G_DEFAULT_MATERIAL_?] */
+            auto materials = resource.meshPoolObj->getMaterials();
+
+            for (uint32_t i = 0; i < g_maxFramesInFlight; i++) {
                 auto bufferObj = new Renderer::VKBuffer (logObj, phyDeviceObj, logDeviceObj);
                 bufferObj->initBufferInfo (
-                    /* Note that, the image will be loaded with 4 channels due to the STBI_rgb_alpha flag */
-                    static_cast <VkDeviceSize> (info.width * info.height * 4),
+                    materials.size() * sizeof (materials[0]),
+                    VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                    {
+                        phyDeviceObj->getGraphicsQueueFamilyIdx()
+                    },
+                    false
+                );
+
+                collectionObj->addCollectionTypeInstance <Renderer::VKBuffer> (
+                    "G_DEFAULT_MATERIAL_" + std::to_string (i),
+                    bufferObj
+                );
+            }
+        }
+        {   /* Buffer           [G_DEFAULT_TEXTURE_STAGING_?] */
+            for (auto const& info: stdTexturePool) {
+                auto baseMipLevel = resource.textureResidencyObj->getBaseMipLevel (info.idx);
+                auto bufferObj    = new Renderer::VKBuffer (logObj, phyDeviceObj, logDeviceObj);
+                bufferObj->initBufferInfo (
+                    /* Note that, the staging buffer holds every resident mip level of the image (see SBTexturePool) */
+                    static_cast <VkDeviceSize> (info.size - info.mipOffsets[baseMipLevel]),
                     VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
                     {
@@ -1103,14 +1196,14 @@ namespace SandBox {
                 );
 
                 collectionObj->addCollectionTypeInstance <Renderer::VKBuffer> (
-                    "G_DEFAULT_TEXTURE_STAGING_" + std::to_string (idx),
+                    "G_DEFAULT_TEXTURE_STAGING_" + std::to_string (info.idx),
                     bufferObj
                 );
                 bufferObj->updateBuffer (
-                    info.data,
+                    resource.stdTexturePoolObj->getImageData (info.idx) + info.mipOffsets[baseMipLevel],
                     true
                 );
-                resource.stdTexturePoolObj->destroyImage (idx);
+                resource.stdTexturePoolObj->destroyImage (info.idx);
             }
         }
 
@@ -1268,30 +1361,78 @@ namespace SandBox {
 
             collectionObj->addCollectionTypeInstance <Renderer::VKImage> ("G_DEFAULT_DEPTH", imageObj);
         }
-        {   /* Image            [G_DEFAULT_TEXTURE_?] */
-            for (auto const& [idx, info]: stdTexturePool) {
+        {   /* Image            [G_DEFAULT_TEXTURE_ARRAY_?] */
+            for (auto const& [arrayIdx, textureIdxs]: resource.stdTexturePoolObj->getTextureArrays()) {
+                /* Every layer of a texture array shares the extent, format and mip levels (see packTextures) */
+                auto& info    = stdTexturePool[textureIdxs[0]];
                 auto imageObj = new Renderer::VKImage (logObj, phyDeviceObj, logDeviceObj);
-                /* To calculate the number of levels in the mip chain, we use the max function to select the largest
-                 * dimension. The log2 function calculates how many times that dimension can be divided by 2. The floor
-                 * function handles cases where the largest dimension is not a power of 2. Finally, 1 is added so that
-                 * the original texture has a mip level
-                */
-                uint32_t mipLevels = static_cast <uint32_t> (
-                    std::floor (std::log2 (std::max (
-                        info.width,
-                        info.height
-                    )))
-                ) + 1;
                 imageObj->initImageInfo (
                     static_cast <uint32_t> (info.width),
                     static_cast <uint32_t> (info.height),
-                    mipLevels,
+                    info.mipLevels,
+                    0,
+                    static_cast <uint32_t> (textureIdxs.size()),
+                    0,
+                    VK_IMAGE_LAYOUT_UNDEFINED,
+                    info.format,
+                    VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                    VK_SAMPLE_COUNT_1_BIT,
+                    VK_IMAGE_TILING_OPTIMAL,
+                    VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                    {
+                        phyDeviceObj->getGraphicsQueueFamilyIdx(),
+                        phyDeviceObj->getTransferQueueFamilyIdx()
+                    },
+                    VK_IMAGE_ASPECT_COLOR_BIT,
+                    VK_IMAGE_VIEW_TYPE_2D_ARRAY
+                );
+
+                collectionObj->addCollectionTypeInstance <Renderer::VKImage> (
+                    "G_DEFAULT_TEXTURE_ARRAY_" + std::to_string (arrayIdx),
+                    imageObj
+                );
+            }
+        }
+        {   /* Image            [G_DEFAULT_TEXTURE_?] */
+            for (auto const& info: stdTexturePool) {
+                /* A packed texture is a 2D view of its layer in the texture array, and so it is bound (and shown in
+                 * the gui) just like any other texture
+                */
+                if (resource.stdTexturePoolObj->isImagePacked (info.idx)) {
+                    auto arrayLayerInfo = resource.stdTexturePoolObj->getArrayLayerInfo (info.idx);
+                    auto arrayImageObj  = collectionObj->getCollectionTypeInstance <Renderer::VKImage> (
+                        "G_DEFAULT_TEXTURE_ARRAY_" + std::to_string (arrayLayerInfo.arrayIdx)
+                    );
+                    auto imageObj       = new Renderer::VKImage (logObj, phyDeviceObj, logDeviceObj);
+                    imageObj->initImageInfo (
+                        info.mipLevels,
+                        arrayLayerInfo.layerIdx,
+                        1,
+                        info.format,
+                        VK_IMAGE_ASPECT_COLOR_BIT,
+                        VK_IMAGE_VIEW_TYPE_2D,
+                        *arrayImageObj->getImage()
+                    );
+
+                    collectionObj->addCollectionTypeInstance <Renderer::VKImage> (
+                        "G_DEFAULT_TEXTURE_" + std::to_string (info.idx),
+                        imageObj
+                    );
+                    continue;
+                }
+
+                auto baseMipLevel = resource.textureResidencyObj->getBaseMipLevel (info.idx);
+                auto imageObj     = new Renderer::VKImage (logObj, phyDeviceObj, logDeviceObj);
+                imageObj->initImageInfo (
+                    static_cast <uint32_t> (std::max (info.width  >> baseMipLevel, 1)),
+                    static_cast <uint32_t> (std::max (info.height >> baseMipLevel, 1)),
+                    info.mipLevels - baseMipLevel,
                     0,
                     1,
                     0,
                     VK_IMAGE_LAYOUT_UNDEFINED,
-                    VK_FORMAT_R8G8B8A8_SRGB,
-                    VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                    info.format,
+                    VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
                     VK_SAMPLE_COUNT_1_BIT,
                     VK_IMAGE_TILING_OPTIMAL,
                     VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
@@ -1304,7 +1445,7 @@ namespace SandBox {
                 );
 
                 collectionObj->addCollectionTypeInstance <Renderer::VKImage> (
-                    "G_DEFAULT_TEXTURE_" + std::to_string (idx),
+                    "G_DEFAULT_TEXTURE_" + std::to_string (info.idx),
                     imageObj
                 );
             }
@@ -1513,7 +1654,7 @@ namespace SandBox {
                 vertexInputBindings   = {
                     pipelineObj->createVertexInputBinding (
                         0,
-                        sizeof (Vertex),
+                        sizeof (PackedVertex),
                         VK_VERTEX_INPUT_RATE_VERTEX
                     )
                 };
@@ -1521,44 +1662,26 @@ namespace SandBox {
                     pipelineObj->createVertexInputAttribute (
                         0,
                         0,
-                        offsetof (Vertex, meta.uv),
-                        VK_FORMAT_R32G32_SFLOAT
+                        offsetof (PackedVertex, meta.uv),
+                        VK_FORMAT_R16G16_SFLOAT
                     ),
                     pipelineObj->createVertexInputAttribute (
                         0,
                         1,
-                        offsetof (Vertex, meta.normal),
-                        VK_FORMAT_R32G32B32_SFLOAT
+                        offsetof (PackedVertex, meta.normal),
+                        VK_FORMAT_R16G16_SNORM
                     ),
                     pipelineObj->createVertexInputAttribute (
                         0,
                         2,
-                        offsetof (Vertex, meta.position),
-                        VK_FORMAT_R32G32B32_SFLOAT
+                        offsetof (PackedVertex, meta.position),
+                        VK_FORMAT_R16G16B16A16_UNORM
                     ),
                     pipelineObj->createVertexInputAttribute (
                         0,
                         3,
-                        offsetof (Vertex, material.diffuseTextureIdx),
-                        VK_FORMAT_R32_UINT
-                    ),
-                    pipelineObj->createVertexInputAttribute (
-                        0,
-                        4,
-                        offsetof (Vertex, material.specularTextureIdx),
-                        VK_FORMAT_R32_UINT
-                    ),
-                    pipelineObj->createVertexInputAttribute (
-                        0,
-                        5,
-                        offsetof (Vertex, material.emissionTextureIdx),
-                        VK_FORMAT_R32_UINT
-                    ),
-                    pipelineObj->createVertexInputAttribute (
-                        0,
-                        6,
-                        offsetof (Vertex, material.shininess),
-                        VK_FORMAT_R32_UINT
+                        offsetof (PackedVertex, materialIdx),
+                        VK_FORMAT_R16_UINT
                     )
                 };
                 pipelineObj->createVertexInputState (
@@ -1710,6 +1833,7 @@ namespace SandBox {
             }
             {   /* Descriptor set layout */
                 perFrameBindingFlags   = {
+                    0,
                     0
                 };
                 perFrameLayoutBindings = {
@@ -1717,7 +1841,13 @@ namespace SandBox {
                         0,
                         1,
                         VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                        VK_SHADER_STAGE_VERTEX_BIT
+                        VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT
+                    ),
+                    pipelineObj->createDescriptorSetLayoutBinding (
+                        1,
+                        1,
+                        VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                        VK_SHADER_STAGE_FRAGMENT_BIT
                     )
                 };
                 /* Note that, if you look at the reported value of maxPerStageDescriptorSamplers, you may find it to be
@@ -1783,6 +1913,10 @@ namespace SandBox {
                 g_maxFramesInFlight,                                /* G_DEFAULT_MESH_INSTANCE_? */
                 VK_DESCRIPTOR_TYPE_STORAGE_BUFFER
             );
+            descPoolObj->addDescriptorPoolSize (
+                g_maxFramesInFlight,                                /* G_DEFAULT_MATERIAL_?      */
+                VK_DESCRIPTOR_TYPE_STORAGE_BUFFER
+            );
             descPoolObj->addDescriptorPoolSize (
                 static_cast <uint32_t> (stdTexturePool.size()),     /* G_DEFAULT_TEXTURE_?       */
                 VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER
@@ -1821,6 +1955,21 @@ namespace SandBox {
                         descriptorBufferInfos
                     );
                 }
+                {   /* Binding 1 */
+                    auto bufferObj             = collectionObj->getCollectionTypeInstance <Renderer::VKBuffer> (
+                        "G_DEFAULT_MATERIAL_" + std::to_string (i)
+                    );
+                    auto descriptorBufferInfos = std::vector <VkDescriptorBufferInfo> {
+                        descSetObj->createDescriptorBufferInfo (
+                            *bufferObj->getBuffer(),
+                            0,
+                            bufferObj->getBufferSize()
+                        )
+                    };
+                    bindingNumberToBufferInfosPoolMap[1].push_back (
+                        descriptorBufferInfos
+                    );
+                }
             }
             /* Write and update descriptor sets */
             for (uint32_t i = 0; i < g_maxFramesInFlight; i++) {
@@ -1835,6 +1984,17 @@ namespace SandBox {
                         descriptorImageInfos
                     );
                 }
+                {   /* Binding 1 */
+                    descSetObj->addWriteDescriptorSet (
+                        1,
+                        static_cast <uint32_t> (bindingNumberToBufferInfosPoolMap[1][i].size()),
+                        0,
+                        VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                        descSetObj->getDescriptorSets()[i],
+                        bindingNumberToBufferInfosPoolMap[1][i],
+                        descriptorImageInfos
+                    );
+                }
             }
             descSetObj->updateDescriptorSets();
         }
@@ -1853,9 +2013,9 @@ namespace SandBox {
             std::unordered_map <uint32_t, std::vector <VkDescriptorImageInfo>> bindingNumberToImageInfosMap;
 
             {   /* Binding 0 */
-                for (auto const& [idx, info]: stdTexturePool) {
+                for (auto const& info: stdTexturePool) {
                     auto imageObj   = collectionObj->getCollectionTypeInstance <Renderer::VKImage>   (
-                        "G_DEFAULT_TEXTURE_" + std::to_string (idx)
+                        "G_DEFAULT_TEXTURE_" + std::to_string (info.idx)
                     );
                     auto samplerObj = collectionObj->getCollectionTypeInstance <Renderer::VKSampler> (
                         "G_DEFAULT_TEXTURE"
@@ -1894,6 +2054,27 @@ namespace SandBox {
         auto phyDeviceObj      = collectionObj->getCollectionTypeInstance <Renderer::VKPhyDevice> ("CORE");
         auto logDeviceObj      = collectionObj->getCollectionTypeInstance <Renderer::VKLogDevice> ("CORE");
         auto swapChainObj      = collectionObj->getCollectionTypeInstance <Renderer::VKSwapChain> ("CORE");
+        /* Same as the textures in the G pass, except that all faces share one cube image and so must share one format
+         * as well
+        */
+        bool decompressionRequired = false;
+        for (auto const& info: resource.skyBoxTexturePoolObj->getTexturePool()) {
+            auto imageFormat = Renderer::getSupportedImageFormat (
+                *phyDeviceObj->getPhyDevice(),
+                {
+                    info.format,
+                    VK_FORMAT_R8G8B8A8_SRGB
+                },
+                VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT,
+                VK_IMAGE_TILING_OPTIMAL
+            );
+            decompressionRequired |= imageFormat != info.format ||
+                                     info.format != resource.skyBoxTexturePoolObj->getTexturePool()[0].format;
+        }
+        if (decompressionRequired) {
+            for (auto const& info: resource.skyBoxTexturePoolObj->getTexturePool())
+                resource.skyBoxTexturePoolObj->decompressImage (info.idx);
+        }
         auto stdTexturePool    = resource.stdTexturePoolObj->getTexturePool();
         auto skyBoxTexturePool = resource.skyBoxTexturePoolObj->getTexturePool();
 
@@ -2150,10 +2331,10 @@ namespace SandBox {
             }
         }
         {   /* Buffer           [F_SKY_BOX_TEXTURE_STAGING_?] */
-            for (auto const& [idx, info]: skyBoxTexturePool) {
+            for (auto const& info: skyBoxTexturePool) {
                 auto bufferObj = new Renderer::VKBuffer (logObj, phyDeviceObj, logDeviceObj);
                 bufferObj->initBufferInfo (
-                    static_cast <VkDeviceSize> (info.width * info.height * 4),
+                    static_cast <VkDeviceSize> (info.size),
                     VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
                     {
@@ -2163,23 +2344,23 @@ namespace SandBox {
                 );
 
                 collectionObj->addCollectionTypeInstance <Renderer::VKBuffer> (
-                    "F_SKY_BOX_TEXTURE_STAGING_" + std::to_string (idx),
+                    "F_SKY_BOX_TEXTURE_STAGING_" + std::to_string (info.idx),
                     bufferObj
                 );
                 bufferObj->updateBuffer (
-                    info.data,
+                    resource.skyBoxTexturePoolObj->getImageData (info.idx),
                     true
                 );
-                resource.skyBoxTexturePoolObj->destroyImage (idx);
+                resource.skyBoxTexturePoolObj->destroyImage (info.idx);
             }
         }
 
         {   /* Buffer           [F_DEFAULT_VERTEX_STAGING] */
             auto batchingObj = resource.sceneObj->getSystem <SYMeshBatching>();
-            auto vertices    = batchingObj->getBatchedVertices (TAG_TYPE_STD_ALPHA);
+            auto vertices    = batchingObj->getBatchedPackedVertices (TAG_TYPE_STD_ALPHA);
             auto bufferObj   = new Renderer::VKBuffer (logObj, phyDeviceObj, logDeviceObj);
             bufferObj->initBufferInfo (
-                vertices.size() * sizeof (Vertex),
+                vertices.size() * sizeof (PackedVertex),
                 VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
                 {
@@ -2196,10 +2377,10 @@ namespace SandBox {
         }
         {   /* Buffer           [F_DEFAULT_INDEX_STAGING] */
             auto batchingObj = resource.sceneObj->getSystem <SYMeshBatching>();
-            auto indices     = batchingObj->getBatchedIndices (TAG_TYPE_STD_ALPHA);
+            auto indices     = batchingObj->getBatchedPackedIndices (TAG_TYPE_STD_ALPHA);
             auto bufferObj   = new Renderer::VKBuffer (logObj, phyDeviceObj, logDeviceObj);
             bufferObj->initBufferInfo (
-                indices.size() * sizeof (IndexType),
+                indices.size(),
                 VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
                 {
@@ -2216,10 +2397,10 @@ namespace SandBox {
         }
         {   /* Buffer           [F_DEFAULT_VERTEX] */
             auto batchingObj = resource.sceneObj->getSystem <SYMeshBatching>();
-            auto vertices    = batchingObj->getBatchedVertices (TAG_TYPE_STD_ALPHA);
+            auto vertices    = batchingObj->getBatchedPackedVertices (TAG_TYPE_STD_ALPHA);
             auto bufferObj   = new Renderer::VKBuffer (logObj, phyDeviceObj, logDeviceObj);
             bufferObj->initBufferInfo (
-                vertices.size() * sizeof (Vertex),
+                vertices.size() * sizeof (PackedVertex),
                 VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
                 VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
                 {
@@ -2233,10 +2414,10 @@ namespace SandBox {
         }
         {   /* Buffer           [F_DEFAULT_INDEX] */
             auto batchingObj = resource.sceneObj->getSystem <SYMeshBatching>();
-            auto indices     = batchingObj->getBatchedIndices (TAG_TYPE_STD_ALPHA);
+            auto indices     = batchingObj->getBatchedPackedIndices (TAG_TYPE_STD_ALPHA);
             auto bufferObj   = new Renderer::VKBuffer (logObj, phyDeviceObj, logDeviceObj);
             bufferObj->initBufferInfo (
-                indices.size() * sizeof (IndexType),
+                indices.size(),
                 VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
                 VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
                 {
@@ -2270,6 +2451,27 @@ namespace SandBox {
                 );
             }
         }
+        {   /* Buffer           [F_DEFAULT_MATERIAL_?] */
+            auto materials = resource.meshPoolObj->getMaterials();
+
+            for (uint32_t i = 0; i < g_maxFramesInFlight; i++) {
+                auto bufferObj = new Renderer::VKBuffer (logObj, phyDeviceObj, logDeviceObj);
+                bufferObj->initBufferInfo (
+                    materials.size() * sizeof (materials[0]),
+                    VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                    {
+                        phyDeviceObj->getGraphicsQueueFamilyIdx()
+                    },
+                    false
+                );
+
+                collectionObj->addCollectionTypeInstance <Renderer::VKBuffer> (
+                    "F_DEFAULT_MATERIAL_" + std::to_string (i),
+                    bufferObj
+                );
+            }
+        }
 
         {   /* Image            [F_LIGHT_COLOR] */
             auto imageObj = new Renderer::VKImage (logObj, phyDeviceObj, logDeviceObj);
@@ -2305,7 +2507,7 @@ namespace SandBox {
                 6,
                 VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT,
                 VK_IMAGE_LAYOUT_UNDEFINED,
-                VK_FORMAT_R8G8B8A8_SRGB,
+                skyBoxTexturePool[0].format,
                 VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
                 VK_SAMPLE_COUNT_1_BIT,
                 VK_IMAGE_TILING_OPTIMAL,
@@ -3566,7 +3768,7 @@ namespace SandBox {
                 vertexInputBindings   = {
                     pipelineObj->createVertexInputBinding (
                         0,
-                        sizeof (Vertex),
+                        sizeof (PackedVertex),
                         VK_VERTEX_INPUT_RATE_VERTEX
                     )
                 };
@@ -3574,20 +3776,20 @@ namespace SandBox {
                     pipelineObj->createVertexInputAttribute (
                         0,
                         0,
-                        offsetof (Vertex, meta.uv),
-                        VK_FORMAT_R32G32_SFLOAT
+                        offsetof (PackedVertex, meta.uv),
+                        VK_FORMAT_R16G16_SFLOAT
                     ),
                     pipelineObj->createVertexInputAttribute (
                         0,
                         1,
-                        offsetof (Vertex, meta.position),
-                        VK_FORMAT_R32G32B32_SFLOAT
+                        offsetof (PackedVertex, meta.position),
+                        VK_FORMAT_R16G16B16A16_UNORM
                     ),
                     pipelineObj->createVertexInputAttribute (
                         0,
                         2,
-                        offsetof (Vertex, material.diffuseTextureIdx),
-                        VK_FORMAT_R32_UINT
+                        offsetof (PackedVertex, materialIdx),
+                        VK_FORMAT_R16_UINT
                     )
                 };
                 pipelineObj->createVertexInputState (
@@ -3698,6 +3900,7 @@ namespace SandBox {
             }
             {   /* Descriptor set layout */
                 perFrameBindingFlags   = {
+                    0,
                     0
                 };
                 perFrameLayoutBindings = {
@@ -3705,7 +3908,13 @@ namespace SandBox {
                         0,
                         1,
                         VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                        VK_SHADER_STAGE_VERTEX_BIT
+                        VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT
+                    ),
+                    pipelineObj->createDescriptorSetLayoutBinding (
+                        1,
+                        1,
+                        VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                        VK_SHADER_STAGE_FRAGMENT_BIT
                     )
                 };
                 otherBindingFlags      = {
@@ -3753,6 +3962,10 @@ namespace SandBox {
                 g_maxFramesInFlight,                                /* F_DEFAULT_MESH_INSTANCE_? */
                 VK_DESCRIPTOR_TYPE_STORAGE_BUFFER
             );
+            descPoolObj->addDescriptorPoolSize (
+                g_maxFramesInFlight,                                /* F_DEFAULT_MATERIAL_?      */
+                VK_DESCRIPTOR_TYPE_STORAGE_BUFFER
+            );
             descPoolObj->addDescriptorPoolSize (
                 static_cast <uint32_t> (stdTexturePool.size()),     /* G_DEFAULT_TEXTURE_?       */
                 VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER
@@ -3791,6 +4004,21 @@ namespace SandBox {
                         descriptorBufferInfos
                     );
                 }
+                {   /* Binding 1 */
+                    auto bufferObj             = collectionObj->getCollectionTypeInstance <Renderer::VKBuffer> (
+                        "F_DEFAULT_MATERIAL_" + std::to_string (i)
+                    );
+                    auto descriptorBufferInfos = std::vector <VkDescriptorBufferInfo> {
+                        descSetObj->createDescriptorBufferInfo (
+                            *bufferObj->getBuffer(),
+                            0,
+                            bufferObj->getBufferSize()
+                        )
+                    };
+                    bindingNumberToBufferInfosPoolMap[1].push_back (
+                        descriptorBufferInfos
+                    );
+                }
             }
             /* Write and update descriptor sets */
             for (uint32_t i = 0; i < g_maxFramesInFlight; i++) {
@@ -3805,6 +4033,17 @@ namespace SandBox {
                         descriptorImageInfos
                     );
                 }
+                {   /* Binding 1 */
+                    descSetObj->addWriteDescriptorSet (
+                        1,
+                        static_cast <uint32_t> (bindingNumberToBufferInfosPoolMap[1][i].size()),
+                        0,
+                        VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                        descSetObj->getDescriptorSets()[i],
+                        bindingNumberToBufferInfosPoolMap[1][i],
+                        descriptorImageInfos
+                    );
+                }
             }
             descSetObj->updateDescriptorSets();
         }
@@ -3823,9 +4062,9 @@ namespace SandBox {
             std::unordered_map <uint32_t, std::vector <VkDescriptorImageInfo>> bindingNumberToImageInfosMap;
 
             {   /* Binding 0 */
-                for (auto const& [idx, info]: stdTexturePool) {
+                for (auto const& info: stdTexturePool) {
                     auto imageObj   = collectionObj->getCollectionTypeInstance <Renderer::VKImage>   (
-                        "G_DEFAULT_TEXTURE_" + std::to_string (idx)
+                        "G_DEFAULT_TEXTURE_" + std::to_string (info.idx)
                     );
                     auto samplerObj = collectionObj->getCollectionTypeInstance <Renderer::VKSampler> (
                         "G_DEFAULT_TEXTURE"
@@ -4254,6 +4493,24 @@ namespace SandBox {
                     copyRegions
                 );
             }
+            {   /* Position buffer->buffer      [S_DEFAULT] */
+                auto srcBufferObj = collectionObj->getCollectionTypeInstance <Renderer::VKBuffer> (
+                    "S_DEFAULT_POSITION_STAGING"
+                );
+                auto dstBufferObj = collectionObj->getCollectionTypeInstance <Renderer::VKBuffer> (
+                    "S_DEFAULT_POSITION"
+                );
+                auto copyRegions  = std::vector <VkBufferCopy> {};
+                Renderer::copyBufferToBuffer (
+                    bufferObj->getCmdBuffers()[0],
+                    *srcBufferObj->getBuffer(),
+                    *dstBufferObj->getBuffer(),
+                    0,
+                    0,
+                    srcBufferObj->getBufferSize(),
+                    copyRegions
+                );
+            }
             {   /* Index  buffer->buffer        [S_DEFAULT] */
                 auto srcBufferObj = collectionObj->getCollectionTypeInstance <Renderer::VKBuffer> (
                     "S_DEFAULT_INDEX_STAGING"
@@ -4274,34 +4531,59 @@ namespace SandBox {
             }
 
             {   /* Buffer->Image                [G_DEFAULT] */
-                for (auto const& [idx, info]: stdTexturePool) {
+                for (auto const& info: stdTexturePool) {
                     auto srcBufferObj = collectionObj->getCollectionTypeInstance <Renderer::VKBuffer> (
-                        "G_DEFAULT_TEXTURE_STAGING_" + std::to_string (idx)
+                        "G_DEFAULT_TEXTURE_STAGING_" + std::to_string (info.idx)
                     );
                     auto dstImageObj  = collectionObj->getCollectionTypeInstance <Renderer::VKImage>  (
-                        "G_DEFAULT_TEXTURE_"         + std::to_string (idx)
+                        "G_DEFAULT_TEXTURE_"         + std::to_string (info.idx)
                     );
-                    auto copyRegions  = std::vector <VkBufferImageCopy> {};
-                    Renderer::copyBufferToImage (
+                    /* A packed texture is copied into its layer of the texture array */
+                    uint32_t baseArrayLayer = 0;
+                    if (resource.stdTexturePoolObj->isImagePacked (info.idx)) {
+                        auto arrayLayerInfo = resource.stdTexturePoolObj->getArrayLayerInfo (info.idx);
+                        dstImageObj         = collectionObj->getCollectionTypeInstance <Renderer::VKImage> (
+                            "G_DEFAULT_TEXTURE_ARRAY_" + std::to_string (arrayLayerInfo.arrayIdx)
+                        );
+                        baseArrayLayer      = arrayLayerInfo.layerIdx;
+                    }
+                    auto baseMipLevel   = resource.textureResidencyObj->getBaseMipLevel (info.idx);
+                    auto srcOffsets     = std::vector <VkDeviceSize> {};
+                    auto copyRegions    = std::vector <VkBufferImageCopy> {};
+                    auto appendBarriers = std::vector <VkImageMemoryBarrier> {};
+                    for (uint32_t i = baseMipLevel; i < info.mipLevels; i++)
+                        srcOffsets.push_back (info.mipOffsets[i] - info.mipOffsets[baseMipLevel]);
+                    /* Note that, the mip levels are generated on the host (and cached), so every resident level is
+                     * copied from the staging buffer as is
+                    */
+                    Renderer::copyBufferToImageMipLevels (
                         bufferObj->getCmdBuffers()[0],
                         *srcBufferObj->getBuffer(),
                         *dstImageObj->getImage(),
-                        0,
-                        0,
-                        0,
-                        {0, 0, 0},
+                        srcOffsets,
                         {
                             dstImageObj->getImageExtent().width,
                             dstImageObj->getImageExtent().height,
                             1
                         },
-                        dstImageObj->getImageMipLevels(),
-                        0,
-                        dstImageObj->getImageLayersCount(),
+                        baseArrayLayer,
+                        1,
                         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
                         dstImageObj->getImageAspectFlags(),
                         copyRegions
                     );
+                    Renderer::transitionImageLayout (
+                        bufferObj->getCmdBuffers()[0],
+                        *dstImageObj->getImage(),
+                        0,
+                        dstImageObj->getImageMipLevels(),
+                        baseArrayLayer,
+                        1,
+                        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                        dstImageObj->getImageAspectFlags(),
+                        appendBarriers
+                    );
                 }
             }
 
@@ -4379,9 +4661,9 @@ namespace SandBox {
                 );
             }
             {   /* Buffer->Image                [F_SKY_BOX] */
-                for (auto const& [idx, info]: skyBoxTexturePool) {
+                for (auto const& info: skyBoxTexturePool) {
                     auto srcBufferObj   = collectionObj->getCollectionTypeInstance <Renderer::VKBuffer> (
-                        "F_SKY_BOX_TEXTURE_STAGING_" + std::to_string (idx)
+                        "F_SKY_BOX_TEXTURE_STAGING_" + std::to_string (info.idx)
                     );
                     auto dstImageObj    = collectionObj->getCollectionTypeInstance <Renderer::VKImage>  (
                         "F_SKY_BOX_TEXTURE"
@@ -4402,7 +4684,7 @@ namespace SandBox {
                             1
                         },
                         dstImageObj->getImageMipLevels(),
-                        idx,    /* Note that, we are using texture idx as layer idx here */
+                        info.idx,   /* Note that, we are using texture idx as layer idx here */
                         1,
                         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
                         dstImageObj->getImageAspectFlags(),
@@ -4413,7 +4695,7 @@ namespace SandBox {
                         *dstImageObj->getImage(),
                         0,
                         dstImageObj->getImageMipLevels(),
-                        idx,    /* Note that, we are using texture idx as layer idx here */
+                        info.idx,   /* Note that, we are using texture idx as layer idx here */
                         1,
                         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
                         VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
@@ -4488,98 +4770,23 @@ namespace SandBox {
             collectionObj->removeCollectionTypeInstance <Renderer::VKFence>      ("COPY_OPS");
             collectionObj->removeCollectionTypeInstance <Renderer::VKBuffer>     ("F_DEFAULT_INDEX_STAGING");
             collectionObj->removeCollectionTypeInstance <Renderer::VKBuffer>     ("F_DEFAULT_VERTEX_STAGING");
-            for (auto const& [idx, info]: skyBoxTexturePool)
+            for (auto const& info: skyBoxTexturePool)
                 collectionObj->removeCollectionTypeInstance <Renderer::VKBuffer> (
-                    "F_SKY_BOX_TEXTURE_STAGING_" + std::to_string (idx)
+                    "F_SKY_BOX_TEXTURE_STAGING_" + std::to_string (info.idx)
                 );
             collectionObj->removeCollectionTypeInstance <Renderer::VKBuffer>     ("F_SKY_BOX_INDEX_STAGING");
             collectionObj->removeCollectionTypeInstance <Renderer::VKBuffer>     ("F_SKY_BOX_VERTEX_STAGING");
             collectionObj->removeCollectionTypeInstance <Renderer::VKBuffer>     ("F_WIRE_INDEX_STAGING");
             collectionObj->removeCollectionTypeInstance <Renderer::VKBuffer>     ("F_WIRE_VERTEX_STAGING");
-            for (auto const& [idx, info]: stdTexturePool)
+            for (auto const& info: stdTexturePool)
                 collectionObj->removeCollectionTypeInstance <Renderer::VKBuffer> (
-                    "G_DEFAULT_TEXTURE_STAGING_" + std::to_string (idx)
+                    "G_DEFAULT_TEXTURE_STAGING_" + std::to_string (info.idx)
                 );
             collectionObj->removeCollectionTypeInstance <Renderer::VKBuffer>     ("S_DEFAULT_INDEX_STAGING");
+            collectionObj->removeCollectionTypeInstance <Renderer::VKBuffer>     ("S_DEFAULT_POSITION_STAGING");
             collectionObj->removeCollectionTypeInstance <Renderer::VKBuffer>     ("S_DEFAULT_VERTEX_STAGING");
         }
 
-        {   /* Fence            [BLIT_OPS] */
-            auto fenObj = new Renderer::VKFence (logObj, logDeviceObj);
-            fenObj->initFenceInfo (
-                0
-            );
-
-            collectionObj->addCollectionTypeInstance <Renderer::VKFence> ("BLIT_OPS", fenObj);
-        }
-        {   /* Cmd pool         [BLIT_OPS] */
-            auto cmdPoolObj = new Renderer::VKCmdPool (logObj, logDeviceObj);
-            cmdPoolObj->initCmdPoolInfo (
-                VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,
-                phyDeviceObj->getGraphicsQueueFamilyIdx()
-            );
-
-            collectionObj->addCollectionTypeInstance <Renderer::VKCmdPool> ("BLIT_OPS", cmdPoolObj);
-        }
-        {   /* Cmd buffers      [BLIT_OPS] */
-            auto fenObj     = collectionObj->getCollectionTypeInstance <Renderer::VKFence>   ("BLIT_OPS");
-            auto cmdPoolObj = collectionObj->getCollectionTypeInstance <Renderer::VKCmdPool> ("BLIT_OPS");
-            auto bufferObj  = new Renderer::VKCmdBuffer (logObj, logDeviceObj, cmdPoolObj);
-            bufferObj->initCmdBufferInfo (
-                1,
-                VK_COMMAND_BUFFER_LEVEL_PRIMARY
-            );
-
-            collectionObj->addCollectionTypeInstance <Renderer::VKCmdBuffer> ("BLIT_OPS", bufferObj);
-            Renderer::beginCmdBufferRecording (
-                bufferObj->getCmdBuffers()[0],
-                VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT
-            );
-            {   /* Image->Image                 [G_DEFAULT] */
-                for (auto const& [idx, info]: stdTexturePool) {
-                    auto imageObj = collectionObj->getCollectionTypeInstance <Renderer::VKImage> (
-                        "G_DEFAULT_TEXTURE_" + std::to_string (idx)
-                    );
-                    Renderer::blitImageToMipMaps (
-                        bufferObj->getCmdBuffers()[0],
-                        *imageObj->getImage(),
-                        imageObj->getImageExtent().width,
-                        imageObj->getImageExtent().height,
-                        imageObj->getImageMipLevels(),
-                        0,
-                        imageObj->getImageAspectFlags()
-                    );
-                }
-            }
-            Renderer::endCmdBufferRecording (
-                bufferObj->getCmdBuffers()[0]
-            );
-
-            auto cmdBuffers       = std::vector {
-                bufferObj->getCmdBuffers()[0]
-            };
-            auto waitSemaphores   = std::vector <VkSemaphore> {};
-            auto waitStageMasks   = std::vector <VkPipelineStageFlags> {};
-            auto signalSemaphores = std::vector <VkSemaphore> {};
-            auto submitInfos      = std::vector <VkSubmitInfo> {};
-            Renderer::submitCmdBuffers (
-                *logDeviceObj->getGraphicsQueue(),
-                *fenObj->getFence(),
-                cmdBuffers,
-                waitSemaphores,
-                waitStageMasks,
-                signalSemaphores,
-                submitInfos
-            );
-            fenObj->waitForFence();
-            fenObj->resetFence();
-
-            /* Destroy blit ops temperory resources */
-            collectionObj->removeCollectionTypeInstance <Renderer::VKCmdBuffer> ("BLIT_OPS");
-            collectionObj->removeCollectionTypeInstance <Renderer::VKCmdPool>   ("BLIT_OPS");
-            collectionObj->removeCollectionTypeInstance <Renderer::VKFence>     ("BLIT_OPS");
-        }
-
         {   /* Fence            [IN_FLIGHT_?] */
             for (uint32_t i = 0; i < g_maxFramesInFlight; i++) {
                 auto fenObj = new Renderer::VKFence (logObj, logDeviceObj);
@@ -4711,6 +4918,253 @@ namespace SandBox {
         }
     }
 
+    /* Re-create the images of the textures whose resident mip levels changed this frame (see SBTextureResidency), and
+     * point every descriptor that samples them (G/F pass texture arrays, gui textures) at the new images
+    */
+    void SBImpl::streamTextures (void) {
+        auto& resource      = m_sandBoxInfo.resource;
+        auto& collectionObj = resource.collectionObj;
+        auto residencyObj   = resource.textureResidencyObj;
+        auto texturePoolObj = resource.stdTexturePoolObj;
+
+        auto idxToBaseMipLevelMap = residencyObj->getResidencyChanges();
+        if (idxToBaseMipLevelMap.empty())
+            return;
+
+        auto logObj         = collectionObj->getCollectionTypeInstance <Log::LGImpl>           ("CORE");
+        auto phyDeviceObj   = collectionObj->getCollectionTypeInstance <Renderer::VKPhyDevice> ("CORE");
+        auto logDeviceObj   = collectionObj->getCollectionTypeInstance <Renderer::VKLogDevice> ("CORE");
+        auto guiObj         = collectionObj->getCollectionTypeInstance <Renderer::VKGui>       ("DRAW_OPS");
+        /* The images are swapped out in place, so none of them may be in use by a frame in flight. Note that, the
+         * residency manager caps the changes per frame, and textures only change once their on screen size crosses a
+         * mip level, so this stall is rare
+        */
+        vkDeviceWaitIdle (*logDeviceObj->getLogDevice());
+
+        {   /* Fence            [STREAM_OPS] */
+            auto fenObj = new Renderer::VKFence (logObj, logDeviceObj);
+            fenObj->initFenceInfo (
+                0
+            );
+
+            collectionObj->addCollectionTypeInstance <Renderer::VKFence> ("STREAM_OPS", fenObj);
+        }
+        {   /* Cmd pool         [STREAM_OPS] */
+            auto cmdPoolObj = new Renderer::VKCmdPool (logObj, logDeviceObj);
+            cmdPoolObj->initCmdPoolInfo (
+                VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,
+                phyDeviceObj->getTransferQueueFamilyIdx()
+            );
+
+            collectionObj->addCollectionTypeInstance <Renderer::VKCmdPool> ("STREAM_OPS", cmdPoolObj);
+        }
+
+        auto fenObj     = collectionObj->getCollectionTypeInstance <Renderer::VKFence>   ("STREAM_OPS");
+        auto cmdPoolObj = collectionObj->getCollectionTypeInstance <Renderer::VKCmdPool> ("STREAM_OPS");
+        auto bufferObj  = new Renderer::VKCmdBuffer (logObj, logDeviceObj, cmdPoolObj);
+        bufferObj->initCmdBufferInfo (
+            1,
+            VK_COMMAND_BUFFER_LEVEL_PRIMARY
+        );
+        collectionObj->addCollectionTypeInstance <Renderer::VKCmdBuffer> ("STREAM_OPS", bufferObj);
+
+        Renderer::beginCmdBufferRecording (
+            bufferObj->getCmdBuffers()[0],
+            VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT
+        );
+        std::map <uint32_t, VkImageView> idxToOldImageViewMap;
+        for (auto const& [idx, baseMipLevel]: idxToBaseMipLevelMap) {
+            /* Host copies are freed once uploaded, so the image is mapped back in from the texture cache */
+            if (!texturePoolObj->reloadImage (idx)) {
+                residencyObj->disableStreaming (idx);
+                continue;
+            }
+            auto& info = texturePoolObj->getTexturePool()[idx];
+
+            {   /* Buffer           [G_DEFAULT_TEXTURE_STAGING_?] */
+                auto stagingBufferObj = new Renderer::VKBuffer (logObj, phyDeviceObj, logDeviceObj);
+                stagingBufferObj->initBufferInfo (
+                    static_cast <VkDeviceSize> (info.size - info.mipOffsets[baseMipLevel]),
+                    VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                    {
+                        phyDeviceObj->getTransferQueueFamilyIdx()
+                    },
+                    false
+                );
+
+                collectionObj->addCollectionTypeInstance <Renderer::VKBuffer> (
+                    "G_DEFAULT_TEXTURE_STAGING_" + std::to_string (idx),
+                    stagingBufferObj
+                );
+                stagingBufferObj->updateBuffer (
+                    texturePoolObj->getImageData (idx) + info.mipOffsets[baseMipLevel],
+                    true
+                );
+                texturePoolObj->destroyImage (idx);
+            }
+            {   /* Image            [G_DEFAULT_TEXTURE_?] */
+                auto oldImageObj = collectionObj->getCollectionTypeInstance <Renderer::VKImage> (
+                    "G_DEFAULT_TEXTURE_" + std::to_string (idx)
+                );
+                idxToOldImageViewMap[idx] = *oldImageObj->getImageView();
+                collectionObj->removeCollectionTypeInstance <Renderer::VKImage> (
+                    "G_DEFAULT_TEXTURE_" + std::to_string (idx)
+                );
+
+                auto imageObj = new Renderer::VKImage (logObj, phyDeviceObj, logDeviceObj);
+                imageObj->initImageInfo (
+                    static_cast <uint32_t> (std::max (info.width  >> baseMipLevel, 1)),
+                    static_cast <uint32_t> (std::max (info.height >> baseMipLevel, 1)),
+                    info.mipLevels - baseMipLevel,
+                    0,
+                    1,
+                    0,
+                    VK_IMAGE_LAYOUT_UNDEFINED,
+                    info.format,
+                    VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                    VK_SAMPLE_COUNT_1_BIT,
+                    VK_IMAGE_TILING_OPTIMAL,
+                    VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                    {
+                        phyDeviceObj->getGraphicsQueueFamilyIdx(),
+                        phyDeviceObj->getTransferQueueFamilyIdx()
+                    },
+                    VK_IMAGE_ASPECT_COLOR_BIT,
+                    VK_IMAGE_VIEW_TYPE_2D
+                );
+
+                collectionObj->addCollectionTypeInstance <Renderer::VKImage> (
+                    "G_DEFAULT_TEXTURE_" + std::to_string (idx),
+                    imageObj
+                );
+            }
+            {   /* Buffer->Image                [G_DEFAULT] */
+                auto srcBufferObj = collectionObj->getCollectionTypeInstance <Renderer::VKBuffer> (
+                    "G_DEFAULT_TEXTURE_STAGING_" + std::to_string (idx)
+                );
+                auto dstImageObj  = collectionObj->getCollectionTypeInstance <Renderer::VKImage>  (
+                    "G_DEFAULT_TEXTURE_"         + std::to_string (idx)
+                );
+                auto srcOffsets     = std::vector <VkDeviceSize> {};
+                auto copyRegions    = std::vector <VkBufferImageCopy> {};
+                auto appendBarriers = std::vector <VkImageMemoryBarrier> {};
+                for (uint32_t i = baseMipLevel; i < info.mipLevels; i++)
+                    srcOffsets.push_back (info.mipOffsets[i] - info.mipOffsets[baseMipLevel]);
+
+                Renderer::copyBufferToImageMipLevels (
+                    bufferObj->getCmdBuffers()[0],
+                    *srcBufferObj->getBuffer(),
+                    *dstImageObj->getImage(),
+                    srcOffsets,
+                    {
+                        dstImageObj->getImageExtent().width,
+                        dstImageObj->getImageExtent().height,
+                        1
+                    },
+                    0,
+                    dstImageObj->getImageLayersCount(),
+                    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                    dstImageObj->getImageAspectFlags(),
+                    copyRegions
+                );
+                Renderer::transitionImageLayout (
+                    bufferObj->getCmdBuffers()[0],
+                    *dstImageObj->getImage(),
+                    0,
+                    dstImageObj->getImageMipLevels(),
+                    0,
+                    dstImageObj->getImageLayersCount(),
+                    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                    VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                    dstImageObj->getImageAspectFlags(),
+                    appendBarriers
+                );
+            }
+        }
+        Renderer::endCmdBufferRecording (
+            bufferObj->getCmdBuffers()[0]
+        );
+
+        auto cmdBuffers       = std::vector {
+            bufferObj->getCmdBuffers()[0]
+        };
+        auto waitSemaphores   = std::vector <VkSemaphore> {};
+        auto waitStageMasks   = std::vector <VkPipelineStageFlags> {};
+        auto signalSemaphores = std::vector <VkSemaphore> {};
+        auto submitInfos      = std::vector <VkSubmitInfo> {};
+        Renderer::submitCmdBuffers (
+            *logDeviceObj->getTransferQueue(),
+            *fenObj->getFence(),
+            cmdBuffers,
+            waitSemaphores,
+            waitStageMasks,
+            signalSemaphores,
+            submitInfos
+        );
+        fenObj->waitForFence();
+        fenObj->resetFence();
+
+        /* Destroy stream ops temperory resources */
+        collectionObj->removeCollectionTypeInstance <Renderer::VKCmdBuffer>  ("STREAM_OPS");
+        collectionObj->removeCollectionTypeInstance <Renderer::VKCmdPool>    ("STREAM_OPS");
+        collectionObj->removeCollectionTypeInstance <Renderer::VKFence>      ("STREAM_OPS");
+        for (auto const& [idx, oldImageView]: idxToOldImageViewMap)
+            collectionObj->removeCollectionTypeInstance <Renderer::VKBuffer> (
+                "G_DEFAULT_TEXTURE_STAGING_" + std::to_string (idx)
+            );
+
+        {   /* Descriptor sets  [G_DEFAULT_OTHER, F_DEFAULT_OTHER] */
+            auto samplerObj            = collectionObj->getCollectionTypeInstance <Renderer::VKSampler> (
+                "G_DEFAULT_TEXTURE"
+            );
+            auto descriptorBufferInfos = std::vector <VkDescriptorBufferInfo> {};
+            /* Note that, the writes point into these infos until the descriptor sets are updated */
+            std::map <uint32_t, std::vector <VkDescriptorImageInfo>> idxToImageInfosMap;
+
+            for (auto const& descSetId: {"G_DEFAULT_OTHER", "F_DEFAULT_OTHER"}) {
+                auto descSetObj = collectionObj->getCollectionTypeInstance <Renderer::VKDescriptorSet> (descSetId);
+                for (auto const& [idx, oldImageView]: idxToOldImageViewMap) {
+                    auto imageObj = collectionObj->getCollectionTypeInstance <Renderer::VKImage> (
+                        "G_DEFAULT_TEXTURE_" + std::to_string (idx)
+                    );
+                    idxToImageInfosMap[idx] = {
+                        descSetObj->createDescriptorImageInfo (
+                            *imageObj->getImageView(),
+                            *samplerObj->getSampler(),
+                            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+                        )
+                    };
+                    /* Binding 0, array element idx */
+                    descSetObj->addWriteDescriptorSet (
+                        0,
+                        1,
+                        idx,
+                        VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                        descSetObj->getDescriptorSets()[0],
+                        descriptorBufferInfos,
+                        idxToImageInfosMap[idx]
+                    );
+                }
+                descSetObj->updateDescriptorSets();
+            }
+        }
+        for (auto const& [idx, oldImageView]: idxToOldImageViewMap) {
+            auto imageObj = collectionObj->getCollectionTypeInstance <Renderer::VKImage> (
+                "G_DEFAULT_TEXTURE_" + std::to_string (idx)
+            );
+            guiObj->updateTextures (oldImageView, *imageObj->getImageView());
+            residencyObj->updateBaseMipLevel (idx, idxToBaseMipLevelMap[idx]);
+
+            LOG_INFO (logObj) << "Texture streamed"
+                              << " "
+                              << "[" << idx << "]"
+                              << " "
+                              << "[" << idxToBaseMipLevelMap[idx] << "]"
+                              << std::endl;
+        }
+    }
+
     void SBImpl::destroyRenderer (void) {
         auto& resource      = m_sandBoxInfo.resource;
         auto& collectionObj = resource.collectionObj;
@@ -4778,6 +5232,10 @@ namespace SandBox {
             collectionObj->removeCollectionTypeInstance <Renderer::VKImage>          ("F_SKY_BOX_TEXTURE");
             collectionObj->removeCollectionTypeInstance <Renderer::VKImage>          ("F_LIGHT_COLOR");
 
+            for (uint32_t i = 0; i < g_maxFramesInFlight; i++)
+                collectionObj->removeCollectionTypeInstance <Renderer::VKBuffer>     (
+                    "F_DEFAULT_MATERIAL_"      + std::to_string (i)
+                );
             for (uint32_t i = 0; i < g_maxFramesInFlight; i++)
                 collectionObj->removeCollectionTypeInstance <Renderer::VKBuffer>     (
                     "F_DEFAULT_MESH_INSTANCE_" + std::to_string (i)
@@ -4818,9 +5276,14 @@ namespace SandBox {
             collectionObj->removeCollectionTypeInstance <Renderer::VKRenderPass>     ("G");
 
             collectionObj->removeCollectionTypeInstance <Renderer::VKSampler>        ("G_DEFAULT_TEXTURE");
-            for (auto const& [idx, info]: stdTexturePool)
+            for (auto const& info: stdTexturePool)
+                collectionObj->removeCollectionTypeInstance <Renderer::VKImage>      (
+                    "G_DEFAULT_TEXTURE_"       + std::to_string (info.idx)
+                );
+            /* Note that, the views of packed textures are destroyed (above) before the texture arrays */
+            for (auto const& [arrayIdx, textureIdxs]: resource.stdTexturePoolObj->getTextureArrays())
                 collectionObj->removeCollectionTypeInstance <Renderer::VKImage>      (
-                    "G_DEFAULT_TEXTURE_"       + std::to_string (idx)
+                    "G_DEFAULT_TEXTURE_ARRAY_" + std::to_string (arrayIdx)
                 );
             collectionObj->removeCollectionTypeInstance <Renderer::VKImage>          ("G_DEFAULT_DEPTH");
             collectionObj->removeCollectionTypeInstance <Renderer::VKImage>          ("G_DEFAULT_COLOR_2");
@@ -4829,6 +5292,10 @@ namespace SandBox {
             collectionObj->removeCollectionTypeInstance <Renderer::VKImage>          ("G_DEFAULT_POSITION");
             collectionObj->removeCollectionTypeInstance <Renderer::VKImage>          ("G_DEFAULT_NORMAL");
 
+            for (uint32_t i = 0; i < g_maxFramesInFlight; i++)
+                collectionObj->removeCollectionTypeInstance <Renderer::VKBuffer>     (
+                    "G_DEFAULT_MATERIAL_"      + std::to_string (i)
+                );
             for (uint32_t i = 0; i < g_maxFramesInFlight; i++)
                 collectionObj->removeCollectionTypeInstance <Renderer::VKBuffer>     (
                     "G_DEFAULT_MESH_INSTANCE_" + std::to_string (i)
@@ -4881,6 +5348,7 @@ namespace SandBox {
                     "S_DEFAULT_MESH_INSTANCE_" + std::to_string (i)
                 );
             collectionObj->removeCollectionTypeInstance <Renderer::VKBuffer>          ("S_DEFAULT_INDEX");
+            collectionObj->removeCollectionTypeInstance <Renderer::VKBuffer>          ("S_DEFAULT_POSITION");
             collectionObj->removeCollectionTypeInstance <Renderer::VKBuffer>          ("S_DEFAULT_VERTEX");
         }
         {   /* Core */
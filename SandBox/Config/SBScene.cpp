@@ -2,6 +2,7 @@
 #include "../../Backend/Common.h"
 #include "../../Backend/Scene/SNImpl.h"
 #include "../System/Loading/SYMeshLoading.h"
+#include "../System/Bounding/SYMeshBounding.h"
 #include "../System/Batching/SYMeshBatching.h"
 #include "../System/Batching/SYStdMeshInstanceBatching.h"
 #include "../System/Batching/SYWireMeshInstanceBatching.h"
@@ -22,6 +23,7 @@
 #include "../System/Rendering/SYGuiRendering.h"
 #include "../SBImpl.h"
 #include "../../Backend/Scene/SNType.h"
+#include "../System/SYConfig.h"
 #include "../SBComponentType.h"
 #include "../SBRendererType.h"
 
@@ -52,9 +54,11 @@ namespace SandBox {
             sceneObj->registerComponent <StdAlphaTagComponent>();
             sceneObj->registerComponent <WireTagComponent>();
             sceneObj->registerComponent <SkyBoxTagComponent>();
+            sceneObj->registerComponent <BoundsComponent>();
         }
         {   /* Register systems */
             auto meshLoadingObj              = sceneObj->registerSystem <SYMeshLoading>();
+            auto meshBoundingObj             = sceneObj->registerSystem <SYMeshBounding>();
             auto meshBatchingObj             = sceneObj->registerSystem <SYMeshBatching>();
             auto stdMeshInstanceBatchingObj  = sceneObj->registerSystem <SYStdMeshInstanceBatching>();
             auto wireMeshInstanceBatchingObj = sceneObj->registerSystem <SYWireMeshInstanceBatching>();
@@ -75,98 +79,114 @@ namespace SandBox {
             auto guiRenderingObj             = sceneObj->registerSystem <SYGuiRendering>();
 
             /* Set system signature
-             *                          +---+---+---+---+---+---+---+---+---+---+---+---+
-             *                          | M | M | L | C | T | T | C | R | S | S | W | S |
-             *                          | E | E | I | A | R | E | O | E | T | T | I | K |
-             *                          | T | S | G | M | A | X | L | N | D | D | R | Y |
-             *                          | A | H | H | E | N | T | O | D |   |   | E |   |
-             *                          |   |   | T | R | S | U | R | E | N | A |   | B |
-             *                          |   |   |   | A | F | R |   | R | O | L | T | O |
-             *                          |   |   |   |   | O | E |   |   |   | P | A | X |
-             *                          |   |   |   |   | R |   |   |   | A | H | G |   |
-             *                          |   |   |   |   | M | I |   |   | L | A |   | T |
-             *                          |   |   |   |   |   | D |   |   | P |   |   | A |
-             *                          |   |   |   |   |   | X |   |   | H | T |   | G |
-             *                          |   |   |   |   |   |   |   |   | A | A |   |   |
-             *                          |   |   |   |   |   | O |   |   |   | G |   |   |
-             *                          |   |   |   |   |   | F |   |   | T |   |   |   |
-             *                          |   |   |   |   |   | F |   |   | A |   |   |   |
-             *                          |   |   |   |   |   | S |   |   | G |   |   |   |
-             *                          |   |   |   |   |   | E |   |   |   |   |   |   |
-             *                          |   |   |   |   |   | T |   |   |   |   |   |   |
-             *  +-----------------------+---+---+---+---+---+---+---+---+---+---+---+---+
-             *  |                       Pre-renderer-config systems                     |
-             *  +-----------------------+---+---+---+---+---+---+---+---+---+---+---+---+
-             *  | Mesh                  |   |[o]|   |   |   |   |   |   |   |   |   |   |
-             *  | loading               |   |   |   |   |   |   |   |   |   |   |   |   |
-             *  +-----------------------+---+---+---+---+---+---+---+---+---+---+---+---+
-             *  | Mesh                  |[o]|[o]|   |   |   |   |   |[o]|   |   |   |   |
-             *  | batching              |   |   |   |   |   |   |   |   |   |   |   |   |
-             *  +-----------------------+---+---+---+---+---+---+---+---+---+---+---+---+
-             *  | Std mesh instance     |[o]|   |   |   |[o]|[o]|   |   |   |   |   |   |
-             *  | batching              |   |   |   |   |   |   |   |   |   |   |   |   |
-             *  +-----------------------+---+---+---+---+---+---+---+---+---+---+---+---+
-             *  | Wire mesh instance    |   |   |   |   |[o]|   |[o]|   |   |   |   |   |
-             *  | batching              |   |   |   |   |   |   |   |   |   |   |   |   |
-             *  +-----------------------+---+---+---+---+---+---+---+---+---+---+---+---+
-             *  | Light instance        |   |   |[o]|   |[o]|   |   |   |   |   |   |   |
-             *  | batching              |   |   |   |   |   |   |   |   |   |   |   |   |
-             *  +-----------------------+---+---+---+---+---+---+---+---+---+---+---+---+
-             *  |                       Post-renderer-config systems                    |
-             *  +-----------------------+---+---+---+---+---+---+---+---+---+---+---+---+
-             *  | Camera                |   |   |   |[o]|[o]|   |   |   |   |   |   |   |
-             *  | controller            |   |   |   |   |   |   |   |   |   |   |   |   |
-             *  +-----------------------+---+---+---+---+---+---+---+---+---+---+---+---+
-             *  | Scene                 |                                               |
-             *  | view                  |                       ~                       |
-             *  +-----------------------+-----------------------------------------------+
-             *  | Entity collection     |                                               |
-             *  | view                  |                       ~                       |
-             *  +-----------------------+-----------------------------------------------+
-             *  | Component editor      |                                               |
-             *  | view                  |                       ~                       |
-             *  +-----------------------+-----------------------------------------------+
-             *  | Config                |                                               |
-             *  | view                  |                       ~                       |
-             *  +-----------------------+---+---+---+---+---+---+---+---+---+---+---+---+
-             *  | Shadow                |   |   |   |   |   |   |   |[o]|[o]|   |   |   |
-             *  | rendering             |   |   |   |   |   |   |   |   |   |   |   |   |
-             *  +-----------------------+---+---+---+---+---+---+---+---+---+---+---+---+
-             *  | Shadow cube           |   |   |   |   |   |   |   |[o]|[o]|   |   |   |
-             *  | rendering             |   |   |   |   |   |   |   |   |   |   |   |   |
-             *  +-----------------------+---+---+---+---+---+---+---+---+---+---+---+---+
-             *  | G default             |   |   |   |   |   |   |   |[o]|[o]|   |   |   |
-             *  | rendering             |   |   |   |   |   |   |   |   |   |   |   |   |
-             *  +-----------------------+---+---+---+---+---+---+---+---+---+---+---+---+
-             *  | Light                 |                                               |
-             *  | rendering             |                       ~                       |
-             *  +-----------------------+---+---+---+---+---+---+---+---+---+---+---+---+
-             *  | Wire                  |   |   |   |   |   |   |   |[o]|   |   |[o]|   |
-             *  | rendering             |   |   |   |   |   |   |   |   |   |   |   |   |
-             *  +-----------------------+---+---+---+---+---+---+---+---+---+---+---+---+
-             *  | Sky box               |   |   |   |   |   |   |   |[o]|   |   |   |[o]|
-             *  | rendering             |   |   |   |   |   |   |   |   |   |   |   |   |
-             *  +-----------------------+---+---+---+---+---+---+---+---+---+---+---+---+
-             *  | F default             |   |   |   |   |   |   |   |[o]|   |[o]|   |   |
-             *  | rendering             |   |   |   |   |   |   |   |   |   |   |   |   |
-             *  +-----------------------+---+---+---+---+---+---+---+---+---+---+---+---+
-             *  | Debug                 |                                               |
-             *  | rendering             |                       ~                       |
-             *  +-----------------------+-----------------------------------------------+
-             *  | Gui                   |                                               |
-             *  | rendering             |                       ~                       |
-             *  +-----------------------+-----------------------------------------------+
+             *                          +---+---+---+---+---+---+---+---+---+---+---+---+---+
+             *                          | M | M | L | C | T | T | C | R | S | S | W | S | B |
+             *                          | E | E | I | A | R | E | O | E | T | T | I | K | O |
+             *                          | T | S | G | M | A | X | L | N | D | D | R | Y | U |
+             *                          | A | H | H | E | N | T | O | D |   |   | E |   | N |
+             *                          |   |   | T | R | S | U | R | E | N | A |   | B | D |
+             *                          |   |   |   | A | F | R |   | R | O | L | T | O | S |
+             *                          |   |   |   |   | O | E |   |   |   | P | A | X |   |
+             *                          |   |   |   |   | R |   |   |   | A | H | G |   |   |
+             *                          |   |   |   |   | M | I |   |   | L | A |   | T |   |
+             *                          |   |   |   |   |   | D |   |   | P |   |   | A |   |
+             *                          |   |   |   |   |   | X |   |   | H | T |   | G |   |
+             *                          |   |   |   |   |   |   |   |   | A | A |   |   |   |
+             *                          |   |   |   |   |   | O |   |   |   | G |   |   |   |
+             *                          |   |   |   |   |   | F |   |   | T |   |   |   |   |
+             *                          |   |   |   |   |   | F |   |   | A |   |   |   |   |
+             *                          |   |   |   |   |   | S |   |   | G |   |   |   |   |
+             *                          |   |   |   |   |   | E |   |   |   |   |   |   |   |
+             *                          |   |   |   |   |   | T |   |   |   |   |   |   |   |
+             *  +-----------------------+---+---+---+---+---+---+---+---+---+---+---+---+---+
+             *  |                         Pre-renderer-config systems                       |
+             *  +-----------------------+---+---+---+---+---+---+---+---+---+---+---+---+---+
+             *  | Mesh                  |   |[o]|   |   |   |   |   |   |   |   |   |   |   |
+             *  | loading               |   |   |   |   |   |   |   |   |   |   |   |   |   |
+             *  +-----------------------+---+---+---+---+---+---+---+---+---+---+---+---+---+
+             *  | Mesh                  |   |[o]|   |   |[o]|   |   |   |   |   |   |   |[o]|
+             *  | bounding              |   |   |   |   |   |   |   |   |   |   |   |   |   |
+             *  +-----------------------+---+---+---+---+---+---+---+---+---+---+---+---+---+
+             *  | Mesh                  |[o]|[o]|   |   |   |   |   |[o]|   |   |   |   |   |
+             *  | batching              |   |   |   |   |   |   |   |   |   |   |   |   |   |
+             *  +-----------------------+---+---+---+---+---+---+---+---+---+---+---+---+---+
+             *  | Std mesh instance     |[o]|   |   |   |[o]|[o]|   |   |   |   |   |   |[o]|
+             *  | batching              |   |   |   |   |   |   |   |   |   |   |   |   |   |
+             *  +-----------------------+---+---+---+---+---+---+---+---+---+---+---+---+---+
+             *  | Wire mesh instance    |   |   |   |   |[o]|   |[o]|   |   |   |   |   |   |
+             *  | batching              |   |   |   |   |   |   |   |   |   |   |   |   |   |
+             *  +-----------------------+---+---+---+---+---+---+---+---+---+---+---+---+---+
+             *  | Light instance        |   |   |[o]|   |[o]|   |   |   |   |   |   |   |   |
+             *  | batching              |   |   |   |   |   |   |   |   |   |   |   |   |   |
+             *  +-----------------------+---+---+---+---+---+---+---+---+---+---+---+---+---+
+             *  |                         Post-renderer-config systems                      |
+             *  +-----------------------+---+---+---+---+---+---+---+---+---+---+---+---+---+
+             *  | Camera                |   |   |   |[o]|[o]|   |   |   |   |   |   |   |   |
+             *  | controller            |   |   |   |   |   |   |   |   |   |   |   |   |   |
+             *  +-----------------------+---+---+---+---+---+---+---+---+---+---+---+---+---+
+             *  | Scene                 |                                                   |
+             *  | view                  |                         ~                         |
+             *  +-----------------------+---------------------------------------------------+
+             *  | Entity collection     |                                                   |
+             *  | view                  |                         ~                         |
+             *  +-----------------------+---------------------------------------------------+
+             *  | Component editor      |                                                   |
+             *  | view                  |                         ~                         |
+             *  +-----------------------+---------------------------------------------------+
+             *  | Config                |                                                   |
+             *  | view                  |                         ~                         |
+             *  +-----------------------+---+---+---+---+---+---+---+---+---+---+---+---+---+
+             *  | Shadow                |   |   |   |   |   |   |   |[o]|[o]|   |   |   |   |
+             *  | rendering             |   |   |   |   |   |   |   |   |   |   |   |   |   |
+             *  +-----------------------+---+---+---+---+---+---+---+---+---+---+---+---+---+
+             *  | Shadow cube           |   |   |   |   |   |   |   |[o]|[o]|   |   |   |   |
+             *  | rendering             |   |   |   |   |   |   |   |   |   |   |   |   |   |
+             *  +-----------------------+---+---+---+---+---+---+---+---+---+---+---+---+---+
+             *  | G default             |   |   |   |   |   |   |   |[o]|[o]|   |   |   |   |
+             *  | rendering             |   |   |   |   |   |   |   |   |   |   |   |   |   |
+             *  +-----------------------+---+---+---+---+---+---+---+---+---+---+---+---+---+
+             *  | Light                 |                                                   |
+             *  | rendering             |                         ~                         |
+             *  +-----------------------+---+---+---+---+---+---+---+---+---+---+---+---+---+
+             *  | Wire                  |   |   |   |   |   |   |   |[o]|   |   |[o]|   |   |
+             *  | rendering             |   |   |   |   |   |   |   |   |   |   |   |   |   |
+             *  +-----------------------+---+---+---+---+---+---+---+---+---+---+---+---+---+
+             *  | Sky box               |   |   |   |   |   |   |   |[o]|   |   |   |[o]|   |
+             *  | rendering             |   |   |   |   |   |   |   |   |   |   |   |   |   |
+             *  +-----------------------+---+---+---+---+---+---+---+---+---+---+---+---+---+
+             *  | F default             |   |   |   |   |   |   |   |[o]|   |[o]|   |   |   |
+             *  | rendering             |   |   |   |   |   |   |   |   |   |   |   |   |   |
+             *  +-----------------------+---+---+---+---+---+---+---+---+---+---+---+---+---+
+             *  | Debug                 |                                                   |
+             *  | rendering             |                         ~                         |
+             *  +-----------------------+---------------------------------------------------+
+             *  | Gui                   |                                                   |
+             *  | rendering             |                         ~                         |
+             *  +-----------------------+---------------------------------------------------+
             */
             {   /* Mesh loading system */
-                meshLoadingObj->initMeshLoadingInfo (sceneObj, resource.stdTexturePoolObj);
+                meshLoadingObj->initMeshLoadingInfo (sceneObj,
+                                                     resource.jobPoolObj,
+                                                     resource.stdTexturePoolObj,
+                                                     resource.meshPoolObj);
 
                 Scene::Signature systemSignature;
                 systemSignature.set (sceneObj->getComponentType <MeshComponent>());
 
                 sceneObj->setSystemSignature <SYMeshLoading> (systemSignature);
             }
+            {   /* Mesh bounding system */
+                meshBoundingObj->initMeshBoundingInfo (sceneObj, resource.meshPoolObj);
+
+                Scene::Signature systemSignature;
+                systemSignature.set (sceneObj->getComponentType <MeshComponent>());
+                systemSignature.set (sceneObj->getComponentType <TransformComponent>());
+                systemSignature.set (sceneObj->getComponentType <BoundsComponent>());
+
+                sceneObj->setSystemSignature <SYMeshBounding> (systemSignature);
+            }
             {   /* Mesh batching system */
-                meshBatchingObj->initMeshBatchingInfo (sceneObj);
+                meshBatchingObj->initMeshBatchingInfo (sceneObj, resource.meshPoolObj);
 
                 Scene::Signature systemSignature;
                 systemSignature.set (sceneObj->getComponentType <MetaComponent>());
@@ -176,8 +196,9 @@ namespace SandBox {
                 sceneObj->setSystemSignature <SYMeshBatching> (systemSignature);
             }
             {   /* Std mesh instance batching system */
-                stdMeshInstanceBatchingObj->initStdMeshInstanceBatchingInfo (sceneObj);
+                stdMeshInstanceBatchingObj->initStdMeshInstanceBatchingInfo (sceneObj, resource.meshPoolObj);
 
+                /* Children (instances without a mesh) are batched along with their parent */
                 Scene::Signature systemSignature;
                 systemSignature.set (sceneObj->getComponentType <MetaComponent>());
                 systemSignature.set (sceneObj->getComponentType <TransformComponent>());
@@ -320,14 +341,11 @@ namespace SandBox {
                         for (auto const& vertexData: entityData["mesh"]["vertices"]) {
                             Vertex vertex;
 
-                            vertex.meta.uv                     = {0.0f, 0.0f};
-                            vertex.meta.normal                 = {0.0f, 0.0f, 0.0f};
-                            vertex.meta.position               = {vertexData[0], vertexData[1], vertexData[2]};
-
-                            vertex.material.diffuseTextureIdx  = 0;
-                            vertex.material.specularTextureIdx = 0;
-                            vertex.material.emissionTextureIdx = 0;
-                            vertex.material.shininess          = 0;
+                            vertex.meta.uv       = {0.0f, 0.0f};
+                            vertex.meta.normal   = {0.0f, 0.0f, 0.0f};
+                            vertex.meta.position = {vertexData[0], vertexData[1], vertexData[2]};
+                            /* See SBMeshPool::addMesh */
+                            vertex.materialIdx   = 0;
 
                             vertices.push_back (vertex);
                         }
@@ -439,6 +457,11 @@ namespace SandBox {
                 if (!entityData["skyBoxTag"].is_null() && entityData["skyBoxTag"])
                     sceneObj->addComponent (entity, SkyBoxTagComponent());
             }
+            {   /* Bounds component */
+                /* Not read from the scene data file, the bounds are derived from the mesh (see SYMeshBounding) */
+                if (!entityData["mesh"].is_null())
+                    sceneObj->addComponent (entity, BoundsComponent());
+            }
 
             /* Parse helper */
             if (!entityData["parseHelper"].is_null()) {
@@ -469,6 +492,7 @@ namespace SandBox {
 
         {   /* Run pre-renderer-config systems */
             auto meshLoadingObj              = sceneObj->getSystem <SYMeshLoading>();
+            auto meshBoundingObj             = sceneObj->getSystem <SYMeshBounding>();
             auto meshBatchingObj             = sceneObj->getSystem <SYMeshBatching>();
             auto stdMeshInstanceBatchingObj  = sceneObj->getSystem <SYStdMeshInstanceBatching>();
             auto wireMeshInstanceBatchingObj = sceneObj->getSystem <SYWireMeshInstanceBatching>();
@@ -477,9 +501,14 @@ namespace SandBox {
             {   /* Mesh loading system */
                 meshLoadingObj->update();
             }
+            {   /* Mesh bounding system */
+                meshBoundingObj->update();
+            }
             {   /* Mesh batching system */
                 meshBatchingObj->update();
                 meshBatchingObj->generateReport();
+                if (g_systemConfig.report.geometryExport)
+                    meshBatchingObj->exportGeometry (g_systemConfig.report.geometryExportPath);
             }
             {   /* Std mesh instance batching system */
                 stdMeshInstanceBatchingObj->update();
@@ -88,12 +88,20 @@ namespace SandBox {
     struct MeshComponent {
         public:
             bool m_loadPending                 = true;
-            /* The paths indicate the model file this mesh belongs to */
+            /* The paths indicate the model file (.obj or .glb) this mesh belongs to, the mtl file dir path is where
+             * the images referred to by a .glb file are looked up
+            */
             std::string m_modelFilePath        = "Asset/Model/Debug_Cube.obj";
             std::string m_mtlFileDirPath       = "Asset/Model/";
-            /* Note that the attributes are combined into one array of vertices (interleaving vertex attributes) */
+            /* Note that the attributes are combined into one array of vertices (interleaving vertex attributes). These
+             * only hold manually populated geometry, which is moved into the mesh pool once loaded
+            */
             std::vector <Vertex>    m_vertices = {};
             std::vector <IndexType> m_indices  = {};
+            /* Loaded geometry lives in the mesh pool (see SBMeshPool), shared by every entity using the same model
+             * and mapped in from the mesh cache where possible. The idx is invalid (max) until the mesh is loaded
+            */
+            uint32_t m_meshIdx                 = std::numeric_limits <uint32_t>::max();
 
             MeshComponent (void) = default;
             MeshComponent (const std::string modelFilePath, const std::string mtlFileDirPath) {
@@ -445,6 +453,9 @@ namespace SandBox {
             }
     };
 
+    /* The index ranges that are drawn for a view (the selected level of detail, and its visible meshlets) are relative
+     * to the first index idx, see SYStdMeshInstanceBatching
+    */
     struct RenderComponent {
         public:
             uint32_t m_firstIndexIdx    = 0;
@@ -452,6 +463,11 @@ namespace SandBox {
             int32_t  m_vertexOffset     = 0;
             uint32_t m_firstInstanceIdx = 0;
             uint32_t m_instancesCount   = 1;
+            /* Std meshes are batched with either 16 or 32 bit indices, in which case the first index idx counts from
+             * the index buffer offset
+            */
+            VkIndexType  m_indexType         = VK_INDEX_TYPE_UINT32;
+            VkDeviceSize m_indexBufferOffset = 0;
 
             RenderComponent (void) = default;
             RenderComponent (const uint32_t instancesCount) {
@@ -459,6 +475,32 @@ namespace SandBox {
             }
     };
 
+    /* Bounds of a mesh, an axis aligned box and a sphere, in model space (copied from the mesh pool once the mesh is
+     * loaded) and in world space. The world bounds are only recomputed when the transform differs from the one they
+     * were last computed for, see SYMeshBounding
+    */
+    struct BoundsComponent {
+        public:
+            glm::vec3 m_localMinPosition  = {0.0f, 0.0f, 0.0f};
+            glm::vec3 m_localMaxPosition  = {0.0f, 0.0f, 0.0f};
+            glm::vec3 m_localCenter       = {0.0f, 0.0f, 0.0f};
+            float m_localRadius           = 0.0f;
+
+            glm::vec3 m_worldMinPosition  = {0.0f, 0.0f, 0.0f};
+            glm::vec3 m_worldMaxPosition  = {0.0f, 0.0f, 0.0f};
+            glm::vec3 m_worldCenter       = {0.0f, 0.0f, 0.0f};
+            float m_worldRadius           = 0.0f;
+            /* The mesh and transform that the bounds were computed for. The idx is invalid (max) until the local bounds
+             * are populated
+            */
+            uint32_t m_meshIdx            = std::numeric_limits <uint32_t>::max();
+            glm::vec3 m_position          = {0.0f, 0.0f, 0.0f};
+            glm::quat m_orientation       = {1.0f, 0.0f, 0.0f, 0.0f};
+            glm::vec3 m_scale             = {1.0f, 1.0f, 1.0f};
+
+            BoundsComponent (void) = default;
+    };
+
     struct StdNoAlphaTagComponent {
         public:
             StdNoAlphaTagComponent (void) = default;
@@ -0,0 +1,573 @@
+#pragma once
+#include <json/single_include/nlohmann/json.hpp>
+#include "../Backend/Common.h"
+#include "../Backend/Log/LGImpl.h"
+/* In-engine parser for binary glTF 2.0 (.glb) model files. The model file is mapped and only the JSON chunk (which is
+ * small next to the geometry) is parsed, the accessors are handed out as views into the mapped BIN chunk so that their
+ * elements are read straight into the vertices and indices of the mesh (see readAccessorFloats, readAccessorIdx),
+ * without going through any intermediate copy
+ *
+ * The subset supported is what maps onto the mesh pool, triangle list primitives with a position, normal and texcoord
+ * (set 0) accessor and (optionally) an index accessor, placed by the node hierarchy of the default scene. Buffers other
+ * than the BIN chunk, sparse accessors and data uris are not supported
+*/
+namespace SandBox {
+    const uint32_t g_glbFileMagic       = 0x46546C67;     /* "glTF" */
+    const uint32_t g_glbFileVersion     = 2;
+    const uint32_t g_glbJSONChunkType   = 0x4E4F534A;     /* "JSON" */
+    const uint32_t g_glbBINChunkType    = 0x004E4942;     /* "BIN\0" */
+
+    enum GLBComponentType {
+        GLB_COMPONENT_TYPE_BYTE           = 5120,
+        GLB_COMPONENT_TYPE_UNSIGNED_BYTE  = 5121,
+        GLB_COMPONENT_TYPE_SHORT          = 5122,
+        GLB_COMPONENT_TYPE_UNSIGNED_SHORT = 5123,
+        GLB_COMPONENT_TYPE_UNSIGNED_INT   = 5125,
+        GLB_COMPONENT_TYPE_FLOAT          = 5126
+    };
+
+    /* View of an accessor in the mapped BIN chunk, where the elements are stride bytes apart. Absent accessors have no
+     * data
+    */
+    struct GLBAccessorInfo {
+        const uint8_t* data;
+        uint32_t count;
+        uint32_t stride;
+        uint32_t componentType;
+        uint32_t componentsCount;
+        bool normalized;
+    };
+
+    /* Primitives of a mesh that is used by more than one node are listed once per node, each with the model matrix
+     * of its node (relative to the scene)
+    */
+    struct GLBPrimitiveInfo {
+        GLBAccessorInfo positions;
+        GLBAccessorInfo normals;
+        GLBAccessorInfo texCoords;
+        GLBAccessorInfo indices;
+        int32_t materialIdx;
+        glm::mat4 modelMatrix;
+    };
+
+    /* Images are either referred to by a file path (relative to the image search path) or embedded in the BIN chunk,
+     * in which case the file path is empty
+    */
+    struct GLBImageInfo {
+        std::string filePath;
+        const uint8_t* data;
+        size_t size;
+        std::string mimeType;
+    };
+
+    /* Image indices are -1 if the texture is absent */
+    struct GLBMaterialInfo {
+        std::string name;
+        int32_t baseColorImageIdx;
+        int32_t emissiveImageIdx;
+        float roughnessFactor;
+    };
+
+    /* The accessors and embedded images view the mapped model file, which stays mapped until the model info is
+     * released (see SBGLBParser::releaseModel)
+    */
+    struct GLBModelInfo {
+        std::vector <GLBPrimitiveInfo> primitives;
+        std::vector <GLBMaterialInfo> materials;
+        std::vector <GLBImageInfo> images;
+        const char* mappedData;
+        size_t mappedSize;
+    };
+
+    /* Integer components are converted as is, or to [0, 1] ([-1, 1] if signed) if the accessor is normalized */
+    void readAccessorFloats (const GLBAccessorInfo& accessorInfo,
+                             const uint32_t elementIdx,
+                             float* values,
+                             const uint32_t valuesCount) {
+
+        auto element = accessorInfo.data + static_cast <size_t> (elementIdx) * accessorInfo.stride;
+        for (uint32_t i = 0; i < valuesCount; i++) {
+            switch (accessorInfo.componentType) {
+                case GLB_COMPONENT_TYPE_FLOAT: {
+                    std::memcpy (&values[i], element + i * sizeof (float), sizeof (float));
+                    break;
+                }
+                case GLB_COMPONENT_TYPE_UNSIGNED_BYTE: {
+                    float value = static_cast <float> (element[i]);
+                    values[i]   = accessorInfo.normalized ? value / 255.0f: value;
+                    break;
+                }
+                case GLB_COMPONENT_TYPE_BYTE: {
+                    float value = static_cast <float> (static_cast <int8_t> (element[i]));
+                    values[i]   = accessorInfo.normalized ? std::max (value / 127.0f, -1.0f): value;
+                    break;
+                }
+                case GLB_COMPONENT_TYPE_UNSIGNED_SHORT: {
+                    uint16_t component;
+                    std::memcpy (&component, element + i * sizeof (component), sizeof (component));
+                    float value = static_cast <float> (component);
+                    values[i]   = accessorInfo.normalized ? value / 65535.0f: value;
+                    break;
+                }
+                case GLB_COMPONENT_TYPE_SHORT: {
+                    int16_t component;
+                    std::memcpy (&component, element + i * sizeof (component), sizeof (component));
+                    float value = static_cast <float> (component);
+                    values[i]   = accessorInfo.normalized ? std::max (value / 32767.0f, -1.0f): value;
+                    break;
+                }
+                default: {
+                    uint32_t component;
+                    std::memcpy (&component, element + i * sizeof (component), sizeof (component));
+                    values[i]   = static_cast <float> (component);
+                    break;
+                }
+            }
+        }
+    }
+
+    uint32_t readAccessorIdx (const GLBAccessorInfo& accessorInfo, const uint32_t elementIdx) {
+        auto element = accessorInfo.data + static_cast <size_t> (elementIdx) * accessorInfo.stride;
+        if (accessorInfo.componentType == GLB_COMPONENT_TYPE_UNSIGNED_BYTE)
+            return element[0];
+        if (accessorInfo.componentType == GLB_COMPONENT_TYPE_UNSIGNED_SHORT) {
+            uint16_t idx;
+            std::memcpy (&idx, element, sizeof (idx));
+            return idx;
+        }
+        uint32_t idx;
+        std::memcpy (&idx, element, sizeof (idx));
+        return idx;
+    }
+
+    class SBGLBParser {
+        private:
+            /* Byte range of a buffer view in the mapped BIN chunk */
+            struct BufferViewInfo {
+                const uint8_t* data;
+                size_t size;
+                uint32_t stride;
+            };
+
+            struct GLBParserInfo {
+                struct Resource {
+                    Log::LGImpl* logObj;
+                } resource;
+            } m_glbParserInfo;
+
+            /* The mapping stays valid after the file is closed. An empty file is mapped to nullptr */
+            bool mapFile (const std::string filePath, const char*& mappedData, size_t& mappedSize) {
+                int fileDescriptor = open (filePath.c_str(), O_RDONLY);
+                if (fileDescriptor == -1)
+                    return false;
+
+                struct stat fileStat;
+                bool fileMapped    = fstat (fileDescriptor, &fileStat) == 0;
+                mappedData         = nullptr;
+                mappedSize         = fileMapped ? static_cast <size_t> (fileStat.st_size): 0;
+                if (mappedSize > 0) {
+                    void* data     = mmap (nullptr, mappedSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+                    fileMapped     = data != MAP_FAILED;
+                    mappedData     = fileMapped ? static_cast <const char*> (data): nullptr;
+                }
+                close (fileDescriptor);
+                return fileMapped;
+            }
+
+            uint32_t readUInt32 (const char* ptr) {
+                uint32_t value;
+                std::memcpy (&value, ptr, sizeof (value));
+                return value;
+            }
+
+            [[noreturn]] void throwInvalidModel (const std::string modelFilePath, const char* message) {
+                LOG_ERROR (m_glbParserInfo.resource.logObj) << message
+                                                            << " "
+                                                            << "[" << modelFilePath << "]"
+                                                            << std::endl;
+                throw std::runtime_error (message);
+            }
+
+            /* Empty if the key is absent (or not an array), without copying the array */
+            const nlohmann::json& getArray (const nlohmann::json& data, const char* key) {
+                static const nlohmann::json emptyArray = nlohmann::json::array();
+                auto it = data.find (key);
+                return it != data.end() && it->is_array() ? *it: emptyArray;
+            }
+
+            const nlohmann::json& getObject (const nlohmann::json& data, const char* key) {
+                static const nlohmann::json emptyObject = nlohmann::json::object();
+                auto it = data.find (key);
+                return it != data.end() && it->is_object() ? *it: emptyObject;
+            }
+
+            uint32_t getComponentSize (const uint32_t componentType) {
+                switch (componentType) {
+                    case GLB_COMPONENT_TYPE_BYTE:
+                    case GLB_COMPONENT_TYPE_UNSIGNED_BYTE:  return 1;
+                    case GLB_COMPONENT_TYPE_SHORT:
+                    case GLB_COMPONENT_TYPE_UNSIGNED_SHORT: return 2;
+                    case GLB_COMPONENT_TYPE_UNSIGNED_INT:
+                    case GLB_COMPONENT_TYPE_FLOAT:          return 4;
+                    default:                                return 0;
+                }
+            }
+
+            uint32_t getComponentsCount (const std::string& type) {
+                if      (type == "SCALAR")  return 1;
+                else if (type == "VEC2")    return 2;
+                else if (type == "VEC3")    return 3;
+                else if (type == "VEC4")    return 4;
+                return 0;
+            }
+
+            /* Only the first buffer can be backed by the BIN chunk, buffers that refer to a uri have no data */
+            std::vector <BufferViewInfo> getBufferViewInfos (const std::string modelFilePath,
+                                                             const nlohmann::json& modelData,
+                                                             const uint8_t* binData,
+                                                             const size_t binSize) {
+
+                std::vector <BufferViewInfo> bufferViewInfos;
+                auto& buffersData = getArray (modelData, "buffers");
+                for (auto const& bufferViewData: getArray (modelData, "bufferViews")) {
+                    auto bufferIdx   = bufferViewData.value ("buffer",     std::numeric_limits <size_t>::max());
+                    auto byteOffset  = bufferViewData.value ("byteOffset", static_cast <size_t> (0));
+                    auto byteLength  = bufferViewData.value ("byteLength", static_cast <size_t> (0));
+                    auto byteStride  = bufferViewData.value ("byteStride", static_cast <uint32_t> (0));
+
+                    bool bufferValid = bufferIdx == 0 && bufferIdx < buffersData.size() &&
+                                       !buffersData[bufferIdx].contains ("uri");
+                    if (!bufferValid) {
+                        bufferViewInfos.push_back ({nullptr, 0, 0});
+                        continue;
+                    }
+                    if (byteOffset > binSize || byteLength > binSize - byteOffset)
+                        throwInvalidModel (modelFilePath, "Invalid buffer view");
+                    bufferViewInfos.push_back ({binData + byteOffset, byteLength, byteStride});
+                }
+                return bufferViewInfos;
+            }
+
+            /* Absent accessors (accessorIdx of -1) are returned without data, whereas an accessor that can't be viewed
+             * or whose elements run past the end of its buffer view is an error
+            */
+            GLBAccessorInfo getAccessorInfo (const std::string modelFilePath,
+                                             const nlohmann::json& modelData,
+                                             const std::vector <BufferViewInfo>& bufferViewInfos,
+                                             const int64_t accessorIdx,
+                                             const uint32_t minComponentsCount) {
+
+                GLBAccessorInfo accessorInfo = {nullptr, 0, 0, 0, 0, false};
+                if (accessorIdx == -1)
+                    return accessorInfo;
+
+                auto& accessorsData = getArray (modelData, "accessors");
+                if (accessorIdx < 0 || static_cast <size_t> (accessorIdx) >= accessorsData.size())
+                    throwInvalidModel (modelFilePath, "Invalid accessor");
+
+                auto& accessorData           = accessorsData[static_cast <size_t> (accessorIdx)];
+                auto bufferViewIdx           = accessorData.value ("bufferView", std::numeric_limits <size_t>::max());
+                auto byteOffset              = accessorData.value ("byteOffset", static_cast <size_t> (0));
+                accessorInfo.count           = accessorData.value ("count", static_cast <uint32_t> (0));
+                accessorInfo.componentType   = accessorData.value ("componentType", static_cast <uint32_t> (0));
+                accessorInfo.componentsCount = getComponentsCount (accessorData.value ("type", std::string()));
+                accessorInfo.normalized      = accessorData.value ("normalized", false);
+
+                if (accessorData.contains ("sparse") || bufferViewIdx >= bufferViewInfos.size() ||
+                    bufferViewInfos[bufferViewIdx].data == nullptr)
+                    throwInvalidModel (modelFilePath, "Unsupported accessor");
+
+                auto& bufferViewInfo         = bufferViewInfos[bufferViewIdx];
+                size_t elementSize           = static_cast <size_t> (getComponentSize (accessorInfo.componentType)) *
+                                               accessorInfo.componentsCount;
+                accessorInfo.stride          = bufferViewInfo.stride != 0 ? bufferViewInfo.stride:
+                                                                            static_cast <uint32_t> (elementSize);
+                accessorInfo.data            = bufferViewInfo.data + byteOffset;
+
+                bool accessorValid           = elementSize > 0                                    &&
+                                               accessorInfo.componentsCount >= minComponentsCount &&
+                                               byteOffset <= bufferViewInfo.size;
+                if (accessorValid && accessorInfo.count > 0) {
+                    size_t lastElementEnd    = static_cast <size_t> (accessorInfo.count - 1) * accessorInfo.stride +
+                                               elementSize;
+                    accessorValid            = lastElementEnd <= bufferViewInfo.size - byteOffset;
+                }
+                if (!accessorValid)
+                    throwInvalidModel (modelFilePath, "Invalid accessor");
+                return accessorInfo;
+            }
+
+            /* Local transform of a node, given either as a matrix (column major) or as translation, rotation and scale
+             * which are applied in the order T * R * S
+            */
+            glm::mat4 getNodeMatrix (const nlohmann::json& nodeData) {
+                glm::mat4 matrix = glm::mat4 (1.0f);
+                if (nodeData.contains ("matrix")) {
+                    auto& values = nodeData["matrix"];
+                    for (uint32_t i = 0; i < 16 && i < values.size(); i++)
+                        matrix[i / 4][i % 4] = values[i].get <float>();
+                    return matrix;
+                }
+                if (nodeData.contains ("translation")) {
+                    auto& values = nodeData["translation"];
+                    matrix       = glm::translate (matrix, glm::vec3 (values[0].get <float>(),
+                                                                      values[1].get <float>(),
+                                                                      values[2].get <float>()));
+                }
+                if (nodeData.contains ("rotation")) {
+                    auto& values = nodeData["rotation"];
+                    /* Stored as x, y, z, w */
+                    matrix       = matrix * glm::mat4_cast (glm::quat (values[3].get <float>(),
+                                                                       values[0].get <float>(),
+                                                                       values[1].get <float>(),
+                                                                       values[2].get <float>()));
+                }
+                if (nodeData.contains ("scale")) {
+                    auto& values = nodeData["scale"];
+                    matrix       = glm::scale (matrix, glm::vec3 (values[0].get <float>(),
+                                                                  values[1].get <float>(),
+                                                                  values[2].get <float>()));
+                }
+                return matrix;
+            }
+
+            void populatePrimitives (const std::string modelFilePath,
+                                     const nlohmann::json& modelData,
+                                     const std::vector <BufferViewInfo>& bufferViewInfos,
+                                     const size_t meshIdx,
+                                     const glm::mat4& modelMatrix,
+                                     std::vector <GLBPrimitiveInfo>& primitives) {
+
+                auto& meshesData = getArray (modelData, "meshes");
+                if (meshIdx >= meshesData.size())
+                    throwInvalidModel (modelFilePath, "Invalid mesh");
+
+                for (auto const& primitiveData: getArray (meshesData[meshIdx], "primitives")) {
+                    /* Points, lines and strips/fans are not part of the mesh */
+                    if (primitiveData.value ("mode", 4) != 4) {
+                        LOG_WARNING (m_glbParserInfo.resource.logObj) << "Skipped non triangle list primitive"
+                                                                      << " "
+                                                                      << "[" << modelFilePath << "]"
+                                                                      << std::endl;
+                        continue;
+                    }
+                    auto& attributesData = getObject (primitiveData, "attributes");
+                    if (!attributesData.contains ("POSITION"))
+                        throwInvalidModel (modelFilePath, "Primitive without positions");
+
+                    GLBPrimitiveInfo primitiveInfo;
+                    primitiveInfo.positions   = getAccessorInfo (modelFilePath, modelData, bufferViewInfos,
+                                                                 attributesData.value ("POSITION",   -1), 3);
+                    primitiveInfo.normals     = getAccessorInfo (modelFilePath, modelData, bufferViewInfos,
+                                                                 attributesData.value ("NORMAL",     -1), 3);
+                    primitiveInfo.texCoords   = getAccessorInfo (modelFilePath, modelData, bufferViewInfos,
+                                                                 attributesData.value ("TEXCOORD_0", -1), 2);
+                    primitiveInfo.indices     = getAccessorInfo (modelFilePath, modelData, bufferViewInfos,
+                                                                 primitiveData.value  ("indices",    -1), 1);
+                    primitiveInfo.materialIdx = primitiveData.value ("material", -1);
+                    primitiveInfo.modelMatrix = modelMatrix;
+
+                    auto& positions           = primitiveInfo.positions;
+                    bool attributesValid      = positions.componentType == GLB_COMPONENT_TYPE_FLOAT &&
+                                                (primitiveInfo.normals.data   == nullptr ||
+                                                 primitiveInfo.normals.count  >= positions.count)   &&
+                                                (primitiveInfo.texCoords.data == nullptr ||
+                                                 primitiveInfo.texCoords.count >= positions.count);
+                    auto& indices             = primitiveInfo.indices;
+                    bool indicesValid         = indices.data == nullptr                                    ||
+                                                indices.componentType == GLB_COMPONENT_TYPE_UNSIGNED_BYTE  ||
+                                                indices.componentType == GLB_COMPONENT_TYPE_UNSIGNED_SHORT ||
+                                                indices.componentType == GLB_COMPONENT_TYPE_UNSIGNED_INT;
+                    if (!attributesValid || !indicesValid)
+                        throwInvalidModel (modelFilePath, "Invalid primitive");
+                    primitives.push_back (primitiveInfo);
+                }
+            }
+
+            /* Depth first over the node hierarchy. The depth is bounded by the nodes count, so that a (malformed)
+             * cyclic hierarchy fails instead of recursing forever
+            */
+            void populateNode (const std::string modelFilePath,
+                               const nlohmann::json& modelData,
+                               const std::vector <BufferViewInfo>& bufferViewInfos,
+                               const size_t nodeIdx,
+                               const glm::mat4& parentMatrix,
+                               const size_t depth,
+                               std::vector <GLBPrimitiveInfo>& primitives) {
+
+                auto& nodesData = getArray (modelData, "nodes");
+                if (nodeIdx >= nodesData.size() || depth > nodesData.size())
+                    throwInvalidModel (modelFilePath, "Invalid node");
+
+                auto& nodeData  = nodesData[nodeIdx];
+                auto matrix     = parentMatrix * getNodeMatrix (nodeData);
+                if (nodeData.contains ("mesh"))
+                    populatePrimitives (modelFilePath, modelData, bufferViewInfos, nodeData["mesh"].get <size_t>(),
+                                        matrix,
+                                        primitives);
+                for (auto const& childData: getArray (nodeData, "children"))
+                    populateNode (modelFilePath, modelData, bufferViewInfos, childData.get <size_t>(),
+                                  matrix,
+                                  depth + 1,
+                                  primitives);
+            }
+
+            /* Textures are resolved to their source image, which is the only part of a texture the texture pool uses
+             * (samplers are shared)
+            */
+            int32_t getImageIdx (const nlohmann::json& modelData, const nlohmann::json& textureInfoData) {
+                auto textureIdx    = textureInfoData.value ("index", std::numeric_limits <size_t>::max());
+                auto& texturesData = getArray (modelData, "textures");
+                if (textureIdx >= texturesData.size())
+                    return -1;
+                return texturesData[textureIdx].value ("source", -1);
+            }
+
+            void populateMaterials (const nlohmann::json& modelData, std::vector <GLBMaterialInfo>& materials) {
+                for (auto const& materialData: getArray (modelData, "materials")) {
+                    auto& pbrData = getObject (materialData, "pbrMetallicRoughness");
+                    materials.push_back ({
+                        materialData.value ("name", std::string()),
+                        getImageIdx (modelData, getObject (pbrData, "baseColorTexture")),
+                        getImageIdx (modelData, getObject (materialData, "emissiveTexture")),
+                        pbrData.value ("roughnessFactor", 1.0f)
+                    });
+                }
+            }
+
+            void populateImages (const std::string modelFilePath,
+                                 const std::string imageDirPath,
+                                 const nlohmann::json& modelData,
+                                 const std::vector <BufferViewInfo>& bufferViewInfos,
+                                 std::vector <GLBImageInfo>& images) {
+
+                std::string dirPath = imageDirPath;
+                if (dirPath.empty() && modelFilePath.find_last_of ('/') != std::string::npos)
+                    dirPath = modelFilePath.substr (0, modelFilePath.find_last_of ('/') + 1);
+                if (!dirPath.empty() && dirPath.back() != '/')
+                    dirPath += '/';
+
+                for (auto const& imageData: getArray (modelData, "images")) {
+                    GLBImageInfo imageInfo = {"", nullptr, 0, imageData.value ("mimeType", std::string())};
+                    auto uri               = imageData.value ("uri", std::string());
+                    auto bufferViewIdx     = imageData.value ("bufferView", std::numeric_limits <size_t>::max());
+
+                    if (!uri.empty() && uri.compare (0, 5, "data:") != 0)
+                        imageInfo.filePath = dirPath + uri;
+                    else if (bufferViewIdx < bufferViewInfos.size() && bufferViewInfos[bufferViewIdx].data != nullptr) {
+                        imageInfo.data     = bufferViewInfos[bufferViewIdx].data;
+                        imageInfo.size     = bufferViewInfos[bufferViewIdx].size;
+                    }
+                    else {
+                        LOG_WARNING (m_glbParserInfo.resource.logObj) << "Unsupported image"
+                                                                      << " "
+                                                                      << "[" << modelFilePath << "]"
+                                                                      << std::endl;
+                    }
+                    images.push_back (imageInfo);
+                }
+            }
+
+            void populateModel (const std::string modelFilePath,
+                                const std::string imageDirPath,
+                                GLBModelInfo& modelInfo) {
+
+                auto data       = modelInfo.mappedData;
+                auto size       = modelInfo.mappedSize;
+                /* Header (magic, version, length) followed by the JSON chunk and the (optional) BIN chunk, each with a
+                 * length and type
+                */
+                if (size < 20 || readUInt32 (data) != g_glbFileMagic || readUInt32 (data + 4) != g_glbFileVersion)
+                    throwInvalidModel (modelFilePath, "Invalid model file header");
+
+                size             = std::min (size, static_cast <size_t> (readUInt32 (data + 8)));
+                size_t jsonSize  = readUInt32 (data + 12);
+                if (readUInt32 (data + 16) != g_glbJSONChunkType || jsonSize > size - 20)
+                    throwInvalidModel (modelFilePath, "Invalid model file JSON chunk");
+
+                const uint8_t* binData = nullptr;
+                size_t binSize         = 0;
+                size_t binOffset       = 20 + jsonSize;
+                if (binOffset + 8 <= size && readUInt32 (data + binOffset + 4) == g_glbBINChunkType) {
+                    binSize            = std::min (static_cast <size_t> (readUInt32 (data + binOffset)),
+                                                   size - binOffset - 8);
+                    binData            = reinterpret_cast <const uint8_t*> (data + binOffset + 8);
+                }
+
+                auto modelData         = nlohmann::json::parse (data + 20, data + 20 + jsonSize, nullptr, false);
+                if (modelData.is_discarded() || !modelData.is_object())
+                    throwInvalidModel (modelFilePath, "Invalid model file JSON chunk");
+
+                auto bufferViewInfos   = getBufferViewInfos (modelFilePath, modelData, binData, binSize);
+                /* Without a scene to place the nodes, every mesh is imported once as is */
+                auto& scenesData       = getArray (modelData, "scenes");
+                auto sceneIdx          = modelData.value ("scene", static_cast <size_t> (0));
+                if (sceneIdx < scenesData.size()) {
+                    for (auto const& nodeIdxData: getArray (scenesData[sceneIdx], "nodes"))
+                        populateNode (modelFilePath, modelData, bufferViewInfos, nodeIdxData.get <size_t>(),
+                                      glm::mat4 (1.0f),
+                                      0,
+                                      modelInfo.primitives);
+                }
+                else {
+                    for (size_t meshIdx = 0; meshIdx < getArray (modelData, "meshes").size(); meshIdx++)
+                        populatePrimitives (modelFilePath, modelData, bufferViewInfos, meshIdx,
+                                            glm::mat4 (1.0f),
+                                            modelInfo.primitives);
+                }
+                populateMaterials (modelData, modelInfo.materials);
+                populateImages    (modelFilePath, imageDirPath, modelData, bufferViewInfos, modelInfo.images);
+            }
+
+        public:
+            SBGLBParser (void) {
+                m_glbParserInfo = {};
+
+                auto& logObj = m_glbParserInfo.resource.logObj;
+                logObj       = new Log::LGImpl();
+                logObj->initLogInfo     ("Build/Log/SandBox",     __FILE__);
+                logObj->updateLogConfig (Log::LEVEL_TYPE_INFO,    Log::SINK_TYPE_FILE);
+                logObj->updateLogConfig (Log::LEVEL_TYPE_WARNING, Log::SINK_TYPE_CONSOLE | Log::SINK_TYPE_FILE);
+                logObj->updateLogConfig (Log::LEVEL_TYPE_ERROR,   Log::SINK_TYPE_CONSOLE | Log::SINK_TYPE_FILE);
+            }
+
+            /* Safe to call from multiple threads at once. An empty image dir path looks up images next to the model
+             * file. The model info has to be released once its accessors and images have been read
+            */
+            void importModel (const std::string modelFilePath,
+                              const std::string imageDirPath,
+                              GLBModelInfo& modelInfo) {
+
+                modelInfo = {};
+                if (!mapFile (modelFilePath, modelInfo.mappedData, modelInfo.mappedSize)) {
+                    LOG_ERROR (m_glbParserInfo.resource.logObj) << "Failed to open model file"
+                                                                << " "
+                                                                << "[" << modelFilePath << "]"
+                                                                << std::endl;
+                    throw std::runtime_error ("Failed to open model file");
+                }
+                /* Values of an unexpected type (a string for an index etc.) are reported by the json library */
+                try {
+                    populateModel (modelFilePath, imageDirPath, modelInfo);
+                }
+                catch (const nlohmann::json::exception&) {
+                    releaseModel (modelInfo);
+                    throwInvalidModel (modelFilePath, "Invalid model file JSON chunk");
+                }
+                catch (...) {
+                    releaseModel (modelInfo);
+                    throw;
+                }
+            }
+
+            void releaseModel (GLBModelInfo& modelInfo) {
+                if (modelInfo.mappedData != nullptr)
+                    munmap (const_cast <char*> (modelInfo.mappedData), modelInfo.mappedSize);
+                modelInfo = {};
+            }
+
+            ~SBGLBParser (void) {
+                delete m_glbParserInfo.resource.logObj;
+            }
+    };
+}   // namespace SandBox
\ No newline at end of file
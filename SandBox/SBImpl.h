@@ -2,10 +2,13 @@
 #include "../Backend/Common.h"
 #include "../Backend/Scene/SNImpl.h"
 #include "../Backend/Collection/CNImpl.h"
+#include "../Backend/Job/JBPool.h"
 #include "../Backend/Renderer/VKWindow.h"
 #include "../Backend/Renderer/VKLogDevice.h"
+#include "../Backend/Renderer/VKSwapChain.h"
 #include "../Backend/Renderer/VKRenderer.h"
 #include "../Backend/Renderer/VKGui.h"
+#include "System/Bounding/SYMeshBounding.h"
 #include "System/Batching/SYStdMeshInstanceBatching.h"
 #include "System/Batching/SYWireMeshInstanceBatching.h"
 #include "System/Batching/SYLightInstanceBatching.h"
@@ -24,6 +27,8 @@
 #include "System/Rendering/SYDebugRendering.h"
 #include "System/Rendering/SYGuiRendering.h"
 #include "SBTexturePool.h"
+#include "SBTextureResidency.h"
+#include "SBMeshPool.h"
 #include "../Backend/Scene/SNType.h"
 #include "System/SYConfig.h"
 #include "SBComponentType.h"
@@ -49,8 +54,11 @@ namespace SandBox {
                 struct Resource {
                     Scene::SNImpl* sceneObj;
                     Collection::CNImpl* collectionObj;
+                    Job::JBPool* jobPoolObj;
                     SBTexturePool* stdTexturePoolObj;
                     SBTexturePool* skyBoxTexturePoolObj;
+                    SBTextureResidency* textureResidencyObj;
+                    SBMeshPool* meshPoolObj;
                 } resource;
             } m_sandBoxInfo;
 
@@ -61,6 +69,7 @@ namespace SandBox {
             void configRendererFPass   (void);      /* Forward  (F) pass */
             void configRendererGuiPass (void);      /* Gui          pass */
             void configRendererOps     (void);
+            void streamTextures        (void);
             void destroyRenderer       (void);
 
         public:
@@ -71,12 +80,48 @@ namespace SandBox {
                 m_sandBoxInfo.resource.sceneObj->initSceneInfo();
                 m_sandBoxInfo.resource.collectionObj        = new Collection::CNImpl();
                 m_sandBoxInfo.resource.collectionObj->initCollectionInfo();
+                m_sandBoxInfo.resource.jobPoolObj           = new Job::JBPool();
+                m_sandBoxInfo.resource.jobPoolObj->initPoolInfo();
+                /* Textures up to 64x64 texels are packed into texture arrays. These are never streamed anyway (see the
+                 * texture residency below), since they fit in the resident tail
+                */
                 m_sandBoxInfo.resource.stdTexturePoolObj    = new SBTexturePool();
-                m_sandBoxInfo.resource.stdTexturePoolObj->initTexturePoolInfo();
+                m_sandBoxInfo.resource.stdTexturePoolObj->initTexturePoolInfo (
+                    m_sandBoxInfo.resource.jobPoolObj,
+                    "Build/Cache/Texture",
+                    false,
+                    64
+                );
+                /* Sky box faces are never minified, and so are cached without mip levels. They are uploaded as layers
+                 * of a cube map, and so are not packed
+                */
                 m_sandBoxInfo.resource.skyBoxTexturePoolObj = new SBTexturePool();
-                m_sandBoxInfo.resource.skyBoxTexturePoolObj->initTexturePoolInfo();
+                m_sandBoxInfo.resource.skyBoxTexturePoolObj->initTexturePoolInfo (
+                    m_sandBoxInfo.resource.jobPoolObj,
+                    "Build/Cache/Texture",
+                    true,
+                    0
+                );
+                /* Mip levels of the std pool textures are streamed in within a 256 MiB budget, starting out with the
+                 * levels that fit in 64x64 texels, and at most 4 textures change per frame. See SBTextureResidency
+                */
+                m_sandBoxInfo.resource.textureResidencyObj  = new SBTextureResidency();
+                m_sandBoxInfo.resource.textureResidencyObj->initTextureResidencyInfo (
+                    256 * 1024 * 1024,
+                    64,
+                    4
+                );
+                /* Imported meshes are cached after their first import, and are mapped in on later runs instead of
+                 * being parsed again. See SBMeshPool
+                */
+                m_sandBoxInfo.resource.meshPoolObj          = new SBMeshPool();
+                m_sandBoxInfo.resource.meshPoolObj->initMeshPoolInfo ("Build/Cache/Mesh");
 
-                /* Add default textures */
+                /* Add default textures. Note that, textures are decoded in the background (see addTexture) and are
+                 * only waited on when the renderer first reads the pool, so decoding overlaps with scene loading and
+                 * renderer setup. Textures seen on a previous run are mapped from the texture cache instead of being
+                 * decoded
+                */
                 m_sandBoxInfo.resource.stdTexturePoolObj->addTexture ("Asset/Texture/[D]_Simple_#FF00FF.png");  /* #0 */
                 m_sandBoxInfo.resource.stdTexturePoolObj->addTexture ("Asset/Texture/[S]_Simple_#000000.png");  /* #1 */
                 m_sandBoxInfo.resource.stdTexturePoolObj->addTexture ("Asset/Texture/[D]_Gui_No_Info.png");     /* #2 */
@@ -135,6 +180,8 @@ namespace SandBox {
 
                 auto windowObj                   = resource.collectionObj->getCollectionTypeInstance
                                                    <Renderer::VKWindow>    ("CORE");
+                auto swapChainObj                = resource.collectionObj->getCollectionTypeInstance
+                                                   <Renderer::VKSwapChain> ("CORE");
                 auto logDeviceObj                = resource.collectionObj->getCollectionTypeInstance
                                                    <Renderer::VKLogDevice> ("CORE");
                 auto rendererObj                 = resource.collectionObj->getCollectionTypeInstance
@@ -143,6 +190,7 @@ namespace SandBox {
                                                    <Renderer::VKGui>       ("DRAW_OPS");
 
                 auto skyBoxTransformComponent    = resource.sceneObj->getComponent <TransformComponent> (meta.skyBoxEntity);
+                auto meshBoundingObj             = resource.sceneObj->getSystem    <SYMeshBounding>();
                 auto stdMeshInstanceBatchingObj  = resource.sceneObj->getSystem    <SYStdMeshInstanceBatching>();
                 auto wireMeshInstanceBatchingObj = resource.sceneObj->getSystem    <SYWireMeshInstanceBatching>();
                 auto lightInstanceBatchingObj    = resource.sceneObj->getSystem    <SYLightInstanceBatching>();
@@ -186,7 +234,8 @@ namespace SandBox {
                 );
                 componentEditorViewObj->initComponentEditorViewInfo   (
                     resource.sceneObj,
-                    resource.collectionObj
+                    resource.collectionObj,
+                    resource.meshPoolObj
                 );
                 configViewObj->initConfigViewInfo                     (
                     resource.collectionObj,
@@ -231,6 +280,7 @@ namespace SandBox {
                 while (!windowObj->isWindowClosed()) {
                     glfwPollEvents();
                     auto startOfFrameTime = PROFILE_CAPTURE;
+                    Log::LGImpl::updateFrameIdx();
 
                     {   /* Data update */
                         /* Handle window events */
@@ -239,11 +289,21 @@ namespace SandBox {
                         /* Controller updates */
                         cameraControllerObj->update (frameDelta, meta.activeCameraEntity);
 
+                        /* Bounds updates, only the entities whose transform changed are touched */
+                        meshBoundingObj->update();
+
                         /* Batched updates */
-                        stdMeshInstanceBatchingObj->update();
+                        stdMeshInstanceBatchingObj->update (
+                            cameraControllerObj->getActiveCamera(),
+                            static_cast <float> (swapChainObj->getSwapChainExtent()->height)
+                        );
                         wireMeshInstanceBatchingObj->update();
                         lightInstanceBatchingObj->update (meta.shadowImageWidth /
                                                           static_cast <float> (meta.shadowImageHeight));
+                        stdMeshInstanceBatchingObj->updateShadowDrawRanges (
+                            lightInstanceBatchingObj->getBatchedActiveLights(),
+                            static_cast <float> (meta.shadowImageHeight)
+                        );
 
                         /* Un-batched updates */
                         skyBoxMeshInstance.modelMatrix = skyBoxTransformComponent->createModelMatrix();
@@ -251,15 +311,25 @@ namespace SandBox {
                         shadowConfig.minDepthBias      = shadow.minDepthBias;
                         shadowConfig.maxDepthBias      = shadow.maxDepthBias;
                     }
+                    {   /* Texture residency update */
+                        for (auto const& [idx, screenSize]: stdMeshInstanceBatchingObj->getTextureIdxToScreenSizeMap())
+                            resource.textureResidencyObj->requestTexture (idx, screenSize);
+                        streamTextures();
+                    }
                     /* Frame update */
                     if (rendererObj->beginFrame()) {
                         {   /* S pass */
                             size_t activeLightIdx = 0;
 
                             for (uint32_t i = 0; i < otherLightsCount; i++) {
+                                auto& drawRangesInfo = stdMeshInstanceBatchingObj->getBatchedShadowDrawRanges (
+                                    static_cast <uint32_t> (activeLightIdx)
+                                );
                                 shadowRenderingObj->update (
                                     static_cast <uint32_t> (activeLightIdx),
                                     stdMeshInstanceBatchingObj->getBatchedMeshInstancesLite (TAG_TYPE_STD_NO_ALPHA).data(),
+                                    drawRangesInfo.firstRangeIdxs.data(),
+                                    drawRangesInfo.indexRanges.data(),
                                     &lightInstanceBatchingObj->getBatchedActiveLights()[activeLightIdx]
                                 );
                                 ++activeLightIdx;
@@ -267,9 +337,14 @@ namespace SandBox {
 
                             for (uint32_t i = 0; i < pointLightsCount; i++) {
                             for (uint32_t cubeFaceIdx = 0; cubeFaceIdx < 6; cubeFaceIdx++) {
+                                auto& drawRangesInfo = stdMeshInstanceBatchingObj->getBatchedShadowDrawRanges (
+                                    static_cast <uint32_t> (activeLightIdx)
+                                );
                                 shadowCubeRenderingObj->update (
                                     static_cast <uint32_t> (activeLightIdx),
                                     stdMeshInstanceBatchingObj->getBatchedMeshInstancesLite (TAG_TYPE_STD_NO_ALPHA).data(),
+                                    drawRangesInfo.firstRangeIdxs.data(),
+                                    drawRangesInfo.indexRanges.data(),
                                     &lightInstanceBatchingObj->getBatchedActiveLights()[activeLightIdx]
                                 );
                                 ++activeLightIdx;
@@ -277,12 +352,21 @@ namespace SandBox {
                             }
                         }
                         {   /* G pass */
+                            auto& drawRangesInfo = stdMeshInstanceBatchingObj->getBatchedDrawRanges (
+                                TAG_TYPE_STD_NO_ALPHA
+                            );
                             gDefaultRenderingObj->update (
                                 stdMeshInstanceBatchingObj->getBatchedMeshInstances (TAG_TYPE_STD_NO_ALPHA).data(),
+                                drawRangesInfo.firstRangeIdxs.data(),
+                                drawRangesInfo.indexRanges.data(),
+                                resource.meshPoolObj->getMaterials().data(),
                                 cameraControllerObj->getActiveCamera()
                             );
                         }
                         {   /* F pass */
+                            auto& drawRangesInfo = stdMeshInstanceBatchingObj->getBatchedDrawRanges (
+                                TAG_TYPE_STD_ALPHA
+                            );
                             lightRenderingObj->update    (
                                 lightInstanceBatchingObj->getBatchedLightInstances().data(),
                                 &shadowConfig,
@@ -299,6 +383,9 @@ namespace SandBox {
                             );
                             fDefaultRenderingObj->update (
                                 stdMeshInstanceBatchingObj->getBatchedMeshInstances (TAG_TYPE_STD_ALPHA).data(),
+                                drawRangesInfo.firstRangeIdxs.data(),
+                                drawRangesInfo.indexRanges.data(),
+                                resource.meshPoolObj->getMaterials().data(),
                                 cameraControllerObj->getActiveCamera()
                             );
                             debugRenderingObj->update();
@@ -343,12 +430,17 @@ namespace SandBox {
                 resource.collectionObj->generateReport();
                 resource.stdTexturePoolObj->generateReport();
                 resource.skyBoxTexturePoolObj->generateReport();
+                resource.textureResidencyObj->generateReport();
+                resource.meshPoolObj->generateReport();
             }
 
             ~SBImpl (void) {
                 auto& resource = m_sandBoxInfo.resource;
+                delete resource.meshPoolObj;
+                delete resource.textureResidencyObj;
                 delete resource.skyBoxTexturePoolObj;
                 delete resource.stdTexturePoolObj;
+                delete resource.jobPoolObj;
                 delete resource.collectionObj;
                 delete resource.sceneObj;
             }
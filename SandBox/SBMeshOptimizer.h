@@ -0,0 +1,390 @@
+#pragma once
+#include "../Backend/Common.h"
+#include "SBRendererType.h"
+/* Load time reordering of triangle meshes, run in the following order
+ *
+ *  Vertex cache    Triangles are reordered for the post-transform vertex cache (Forsyth, "Linear-Speed Vertex Cache
+ *                  Optimisation"). Vertices are scored by their position in a simulated LRU cache and by the number of
+ *                  triangles still using them, and the best scoring triangle next to the cache is emitted next
+ *  Overdraw        The cache optimized triangles are split into clusters wherever that costs little in cache misses
+ *                  (the ACMR of a cluster stays within a threshold of its parent), and clusters that face away from the
+ *                  center of the mesh are drawn first, since those are more likely to occlude the rest (Sander et al,
+ *                  "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw")
+ *  Vertex fetch    Vertices are remapped into the order they are first used in, so that vertex fetches walk the vertex
+ *                  buffer (mostly) linearly
+ *
+ * None of these change what is drawn, only the order it is drawn in. The effect is measured without a GPU (see
+ * getMeshStats), by simulating a FIFO vertex cache and rasterizing the mesh in software from the 6 axis directions
+*/
+namespace SandBox {
+    /* Size of the LRU cache used for scoring, which is larger than the FIFO cache simulated for the stats since the
+     * scores only need to rank vertices
+    */
+    const uint32_t g_scoringCacheSize        = 32;
+    const uint32_t g_simulatedCacheSize      = 16;
+    /* A cluster may have up to 5% more cache misses per triangle than the cluster it is split off from */
+    const float g_overdrawClusterThreshold   = 1.05f;
+    /* Resolution of the software rasterizer used for the overdraw stats */
+    const uint32_t g_overdrawGridSize        = 256;
+
+    struct MeshStatsInfo {
+        /* Average cache miss ratio, vertices transformed per triangle (0.5 at best, 3 at worst) */
+        float acmr;
+        /* Average transformed vertex ratio, vertices transformed per unique vertex (1 at best) */
+        float atvr;
+        /* Fragments shaded per covered pixel (1 at best) */
+        float overdraw;
+    };
+
+    float getVertexScore (const int32_t cachePosition, const uint32_t remainingTrianglesCount) {
+        if (remainingTrianglesCount == 0)
+            return -1.0f;
+
+        float score = 0.0f;
+        /* The last triangle's vertices get a fixed score, so that the next triangle doesn't simply reuse 2 of them
+         * every time
+        */
+        if (cachePosition >= 0 && cachePosition < 3)
+            score = 0.75f;
+        else if (cachePosition >= 3)
+            score = std::pow (1.0f - static_cast <float> (cachePosition - 3) / (g_scoringCacheSize - 3), 1.5f);
+        /* Vertices with few triangles left are boosted, so that they are finished off instead of being left behind */
+        return score + 2.0f * std::pow (static_cast <float> (remainingTrianglesCount), -0.5f);
+    }
+
+    void optimizeVertexCache (std::vector <IndexType>& indices, const size_t verticesCount) {
+        size_t trianglesCount = indices.size() / 3;
+        if (trianglesCount == 0)
+            return;
+        /* Triangles that use each vertex, the ones still to be emitted are kept at the front of each range */
+        std::vector <uint32_t> remainingTrianglesCounts (verticesCount, 0);
+        for (auto const& index: indices)
+            ++remainingTrianglesCounts[index];
+
+        std::vector <uint32_t> adjacencyOffsets (verticesCount + 1, 0);
+        for (size_t i = 0; i < verticesCount; i++)
+            adjacencyOffsets[i + 1] = adjacencyOffsets[i] + remainingTrianglesCounts[i];
+
+        std::vector <uint32_t> adjacentTriangles (indices.size());
+        std::vector <uint32_t> adjacencyFills (adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (size_t i = 0; i < indices.size(); i++)
+            adjacentTriangles[adjacencyFills[indices[i]]++] = static_cast <uint32_t> (i / 3);
+
+        std::vector <int32_t> cachePositions (verticesCount, -1);
+        std::vector <float> vertexScores (verticesCount);
+        for (size_t i = 0; i < verticesCount; i++)
+            vertexScores[i] = getVertexScore (-1, remainingTrianglesCounts[i]);
+
+        std::vector <float> triangleScores (trianglesCount);
+        std::vector <uint8_t> trianglesEmitted (trianglesCount, 0);
+        int64_t bestTriangleIdx = 0;
+        for (size_t i = 0; i < trianglesCount; i++) {
+            triangleScores[i]   = vertexScores[indices[i * 3 + 0]] +
+                                  vertexScores[indices[i * 3 + 1]] +
+                                  vertexScores[indices[i * 3 + 2]];
+            if (triangleScores[i] > triangleScores[bestTriangleIdx])
+                bestTriangleIdx = static_cast <int64_t> (i);
+        }
+
+        std::vector <IndexType> optimizedIndices;
+        std::vector <uint32_t> cache, nextCache;
+        optimizedIndices.reserve (indices.size());
+        size_t scanIdx = 0;
+
+        while (optimizedIndices.size() < indices.size()) {
+            /* Nothing next to the cache is left, restart from the first triangle that hasn't been emitted */
+            if (bestTriangleIdx == -1) {
+                while (trianglesEmitted[scanIdx] != 0)
+                    ++scanIdx;
+                bestTriangleIdx = static_cast <int64_t> (scanIdx);
+            }
+            auto triangleIdx = static_cast <size_t> (bestTriangleIdx);
+            auto triangle    = &indices[triangleIdx * 3];
+            trianglesEmitted[triangleIdx] = 1;
+            optimizedIndices.insert (optimizedIndices.end(), triangle, triangle + 3);
+
+            for (uint32_t i = 0; i < 3; i++) {
+                uint32_t vertexIdx = triangle[i];
+                auto begin         = adjacentTriangles.begin() + adjacencyOffsets[vertexIdx];
+                auto end           = begin + remainingTrianglesCounts[vertexIdx];
+                auto it            = std::find (begin, end, static_cast <uint32_t> (triangleIdx));
+                /* A degenerate triangle lists the same vertex more than once */
+                if (it != end) {
+                    std::iter_swap (it, end - 1);
+                    --remainingTrianglesCounts[vertexIdx];
+                }
+            }
+            /* Move the triangle's vertices to the front of the (LRU) cache */
+            nextCache.clear();
+            for (uint32_t i = 0; i < 3; i++) {
+                if (std::find (nextCache.begin(), nextCache.end(), triangle[i]) == nextCache.end())
+                    nextCache.push_back (triangle[i]);
+            }
+            for (auto const& vertexIdx: cache) {
+                if (std::find (nextCache.begin(), nextCache.end(), vertexIdx) == nextCache.end())
+                    nextCache.push_back (vertexIdx);
+            }
+            for (size_t i = 0; i < nextCache.size(); i++) {
+                uint32_t vertexIdx         = nextCache[i];
+                cachePositions[vertexIdx]  = i < g_scoringCacheSize ? static_cast <int32_t> (i): -1;
+                vertexScores[vertexIdx]    = getVertexScore (cachePositions[vertexIdx],
+                                                             remainingTrianglesCounts[vertexIdx]);
+            }
+            /* Only the triangles next to the cache (including the vertices that just fell out of it) change score */
+            bestTriangleIdx    = -1;
+            float bestScore    = -1.0f;
+            for (auto const& vertexIdx: nextCache) {
+                uint32_t offset = adjacencyOffsets[vertexIdx];
+                for (uint32_t i = 0; i < remainingTrianglesCounts[vertexIdx]; i++) {
+                    uint32_t adjacentTriangleIdx         = adjacentTriangles[offset + i];
+                    triangleScores[adjacentTriangleIdx]  = vertexScores[indices[adjacentTriangleIdx * 3 + 0]] +
+                                                           vertexScores[indices[adjacentTriangleIdx * 3 + 1]] +
+                                                           vertexScores[indices[adjacentTriangleIdx * 3 + 2]];
+                    if (triangleScores[adjacentTriangleIdx] > bestScore) {
+                        bestScore       = triangleScores[adjacentTriangleIdx];
+                        bestTriangleIdx = adjacentTriangleIdx;
+                    }
+                }
+            }
+            if (nextCache.size() > g_scoringCacheSize)
+                nextCache.resize (g_scoringCacheSize);
+            std::swap (cache, nextCache);
+        }
+        indices = optimizedIndices;
+    }
+
+    /* Simulate a FIFO cache (cache hits do not refresh an entry), returns the number of cache misses of the triangle.
+     * The cache is reset by moving the time stamp past the cache size
+    */
+    uint32_t updateSimulatedCache (const IndexType* triangle,
+                                   std::vector <uint32_t>& cacheTimeStamps,
+                                   uint32_t& timeStamp) {
+
+        uint32_t missesCount = 0;
+        for (uint32_t i = 0; i < 3; i++) {
+            if (timeStamp - cacheTimeStamps[triangle[i]] > g_simulatedCacheSize) {
+                cacheTimeStamps[triangle[i]] = timeStamp++;
+                ++missesCount;
+            }
+        }
+        return missesCount;
+    }
+
+    void optimizeOverdraw (std::vector <IndexType>& indices,
+                           const std::vector <Vertex>& vertices,
+                           const float threshold) {
+
+        size_t trianglesCount = indices.size() / 3;
+        if (trianglesCount == 0)
+            return;
+
+        std::vector <uint32_t> cacheTimeStamps (vertices.size(), 0);
+        uint32_t timeStamp    = g_simulatedCacheSize + 1;
+        /* Hard boundaries are where the vertex cache optimizer started over (every vertex of the triangle misses), and
+         * clusters between them can be drawn in any order without costing cache misses
+        */
+        std::vector <size_t> hardBoundaries;
+        for (size_t i = 0; i < trianglesCount; i++) {
+            if (updateSimulatedCache (&indices[i * 3], cacheTimeStamps, timeStamp) == 3)
+                hardBoundaries.push_back (i);
+        }
+        hardBoundaries.push_back (trianglesCount);
+        /* Soft boundaries split a hard cluster wherever the ACMR of the part so far is within the threshold of the
+         * whole cluster's ACMR
+        */
+        std::vector <size_t> clusterBegins;
+        for (size_t i = 0; i + 1 < hardBoundaries.size(); i++) {
+            size_t begin         = hardBoundaries[i];
+            size_t end           = hardBoundaries[i + 1];
+            uint32_t missesCount = 0;
+            timeStamp           += g_simulatedCacheSize + 1;
+            for (size_t j = begin; j < end; j++)
+                missesCount     += updateSimulatedCache (&indices[j * 3], cacheTimeStamps, timeStamp);
+
+            float maxACMR        = threshold * missesCount / (end - begin);
+            size_t clusterBegin  = begin;
+            missesCount          = 0;
+            timeStamp           += g_simulatedCacheSize + 1;
+            clusterBegins.push_back (begin);
+            for (size_t j = begin; j + 1 < end; j++) {
+                missesCount     += updateSimulatedCache (&indices[j * 3], cacheTimeStamps, timeStamp);
+                if (static_cast <float> (missesCount) / (j + 1 - clusterBegin) <= maxACMR) {
+                    clusterBegin = j + 1;
+                    missesCount  = 0;
+                    timeStamp   += g_simulatedCacheSize + 1;
+                    clusterBegins.push_back (clusterBegin);
+                }
+            }
+        }
+        clusterBegins.push_back (trianglesCount);
+
+        glm::vec3 meshCentroid = {0.0f, 0.0f, 0.0f};
+        for (auto const& vertex: vertices)
+            meshCentroid += vertex.meta.position;
+        meshCentroid          /= static_cast <float> (std::max (vertices.size(), static_cast <size_t> (1)));
+        /* Clusters are sorted by how far they face away from the center of the mesh, the area weighted centroid and
+         * normal of a cluster stand in for its position and direction
+        */
+        std::vector <std::pair <float, size_t>> clusterSortKeys;
+        for (size_t i = 0; i + 1 < clusterBegins.size(); i++) {
+            glm::vec3 centroid = {0.0f, 0.0f, 0.0f};
+            glm::vec3 normal   = {0.0f, 0.0f, 0.0f};
+            float area         = 0.0f;
+            for (size_t j = clusterBegins[i]; j < clusterBegins[i + 1]; j++) {
+                auto& position0             = vertices[indices[j * 3 + 0]].meta.position;
+                auto& position1             = vertices[indices[j * 3 + 1]].meta.position;
+                auto& position2             = vertices[indices[j * 3 + 2]].meta.position;
+                glm::vec3 triangleNormal    = glm::cross (position1 - position0, position2 - position0);
+                float triangleArea          = glm::length (triangleNormal);
+
+                centroid                   += (position0 + position1 + position2) * (triangleArea / 3.0f);
+                normal                     += triangleNormal;
+                area                       += triangleArea;
+            }
+            float normalLength = glm::length (normal);
+            float sortKey      = 0.0f;
+            if (area > 0.0f && normalLength > 0.0f)
+                sortKey        = glm::dot (centroid / area - meshCentroid, normal / normalLength);
+            clusterSortKeys.push_back ({sortKey, i});
+        }
+        std::stable_sort (clusterSortKeys.begin(), clusterSortKeys.end(), [](auto const& a, auto const& b) {
+            return a.first > b.first;
+        });
+
+        std::vector <IndexType> optimizedIndices;
+        optimizedIndices.reserve (indices.size());
+        for (auto const& [sortKey, clusterIdx]: clusterSortKeys)
+            optimizedIndices.insert (optimizedIndices.end(), indices.begin() + clusterBegins[clusterIdx]     * 3,
+                                                             indices.begin() + clusterBegins[clusterIdx + 1] * 3);
+        indices = optimizedIndices;
+    }
+
+    /* Vertices that are not used by any triangle are dropped */
+    void optimizeVertexFetch (std::vector <Vertex>& vertices, std::vector <IndexType>& indices) {
+        std::vector <IndexType> oldToNewIdxMap (vertices.size(), std::numeric_limits <IndexType>::max());
+        std::vector <Vertex> optimizedVertices;
+        optimizedVertices.reserve (vertices.size());
+
+        for (auto& index: indices) {
+            if (oldToNewIdxMap[index] == std::numeric_limits <IndexType>::max()) {
+                oldToNewIdxMap[index] = static_cast <IndexType> (optimizedVertices.size());
+                optimizedVertices.push_back (vertices[index]);
+            }
+            index = oldToNewIdxMap[index];
+        }
+        vertices = optimizedVertices;
+    }
+
+    /* Orthographic views along +/- x, y and z, with back faces (clockwise as seen from the view) culled. A fragment is
+     * shaded whenever it passes the depth test at the time it is drawn, so drawing back to front shades every layer
+    */
+    float getOverdraw (const std::vector <Vertex>& vertices, const std::vector <IndexType>& indices) {
+        if (vertices.empty() || indices.empty())
+            return 1.0f;
+
+        glm::vec3 minPosition = vertices[0].meta.position;
+        glm::vec3 maxPosition = vertices[0].meta.position;
+        for (auto const& vertex: vertices) {
+            minPosition = glm::min (minPosition, vertex.meta.position);
+            maxPosition = glm::max (maxPosition, vertex.meta.position);
+        }
+        glm::vec3 extent      = maxPosition - minPosition;
+        float maxExtent       = std::max (extent.x, std::max (extent.y, extent.z));
+        if (maxExtent <= 0.0f)
+            return 1.0f;
+
+        float scale           = (g_overdrawGridSize - 1) / maxExtent;
+        std::vector <float> depths (g_overdrawGridSize * g_overdrawGridSize);
+        size_t shadedFragmentsCount = 0;
+        size_t coveredPixelsCount   = 0;
+
+        for (uint32_t axisIdx = 0; axisIdx < 3; axisIdx++) {
+            /* (u, v, axis) is right handed, so counter clockwise triangles facing +axis are counter clockwise in uv */
+            uint32_t uIdx = (axisIdx + 1) % 3;
+            uint32_t vIdx = (axisIdx + 2) % 3;
+            for (float direction: {1.0f, -1.0f}) {
+                std::fill (depths.begin(), depths.end(), std::numeric_limits <float>::max());
+
+                for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+                    glm::vec3 corners[3];
+                    for (uint32_t j = 0; j < 3; j++) {
+                        auto& position = vertices[indices[i + j]].meta.position;
+                        corners[j]     = {
+                            (position[uIdx] - minPosition[uIdx]) * scale,
+                            (position[vIdx] - minPosition[vIdx]) * scale,
+                            /* Closer to the viewer (placed at direction * infinity) is smaller */
+                            -direction * position[axisIdx]
+                        };
+                    }
+                    float area = (corners[1].x - corners[0].x) * (corners[2].y - corners[0].y) -
+                                 (corners[1].y - corners[0].y) * (corners[2].x - corners[0].x);
+                    if (area * direction <= 0.0f)
+                        continue;
+
+                    auto minX = static_cast <int32_t> (std::min ({corners[0].x, corners[1].x, corners[2].x}));
+                    auto minY = static_cast <int32_t> (std::min ({corners[0].y, corners[1].y, corners[2].y}));
+                    auto maxX = static_cast <int32_t> (std::max ({corners[0].x, corners[1].x, corners[2].x}));
+                    auto maxY = static_cast <int32_t> (std::max ({corners[0].y, corners[1].y, corners[2].y}));
+                    maxX      = std::min (maxX, static_cast <int32_t> (g_overdrawGridSize - 1));
+                    maxY      = std::min (maxY, static_cast <int32_t> (g_overdrawGridSize - 1));
+
+                    for (int32_t y = std::max (minY, 0); y <= maxY; y++) {
+                        for (int32_t x = std::max (minX, 0); x <= maxX; x++) {
+                            float px     = x + 0.5f;
+                            float py     = y + 0.5f;
+                            /* Barycentric weights (scaled by the area), all of them share the sign of the area inside
+                             * the triangle
+                            */
+                            float weights[3];
+                            for (uint32_t j = 0; j < 3; j++) {
+                                auto& a    = corners[(j + 1) % 3];
+                                auto& b    = corners[(j + 2) % 3];
+                                weights[j] = ((b.x - a.x) * (py - a.y) - (b.y - a.y) * (px - a.x)) / area;
+                            }
+                            if (weights[0] < 0.0f || weights[1] < 0.0f || weights[2] < 0.0f)
+                                continue;
+
+                            float depth  = weights[0] * corners[0].z + weights[1] * corners[1].z +
+                                           weights[2] * corners[2].z;
+                            auto& pixel  = depths[y * g_overdrawGridSize + x];
+                            if (depth < pixel) {
+                                pixel    = depth;
+                                ++shadedFragmentsCount;
+                            }
+                        }
+                    }
+                }
+                for (auto const& depth: depths) {
+                    if (depth != std::numeric_limits <float>::max())
+                        ++coveredPixelsCount;
+                }
+            }
+        }
+        return coveredPixelsCount == 0 ? 1.0f:
+               static_cast <float> (shadedFragmentsCount) / static_cast <float> (coveredPixelsCount);
+    }
+
+    MeshStatsInfo getMeshStats (const std::vector <Vertex>& vertices, const std::vector <IndexType>& indices) {
+        MeshStatsInfo statsInfo = {0.0f, 0.0f, 1.0f};
+        size_t trianglesCount   = indices.size() / 3;
+        if (trianglesCount == 0)
+            return statsInfo;
+
+        std::vector <uint32_t> cacheTimeStamps (vertices.size(), 0);
+        std::vector <uint8_t> verticesUsed     (vertices.size(), 0);
+        uint32_t timeStamp      = g_simulatedCacheSize + 1;
+        uint32_t missesCount    = 0;
+        size_t usedVerticesCount = 0;
+        for (size_t i = 0; i < trianglesCount; i++)
+            missesCount        += updateSimulatedCache (&indices[i * 3], cacheTimeStamps, timeStamp);
+        for (auto const& index: indices) {
+            usedVerticesCount  += verticesUsed[index] == 0 ? 1: 0;
+            verticesUsed[index] = 1;
+        }
+
+        statsInfo.acmr          = static_cast <float> (missesCount) / static_cast <float> (trianglesCount);
+        statsInfo.atvr          = static_cast <float> (missesCount) / static_cast <float> (usedVerticesCount);
+        statsInfo.overdraw      = getOverdraw (vertices, indices);
+        return statsInfo;
+    }
+}   // namespace SandBox
\ No newline at end of file
@@ -0,0 +1,587 @@
+#pragma once
+#include "../Backend/Common.h"
+#include "../Backend/Log/LGImpl.h"
+#include "SBRendererType.h"
+#include "SBMeshOptimizer.h"
+#include "SBMeshSimplifier.h"
+#include "SBMeshletBuilder.h"
+
+namespace SandBox {
+    /* Mesh cache file layout
+     *  +-----------+-----------+-----------+-----------+-----------+-----------+-----------+
+     *  |  Header   | Vertices  |  Indices  |   Lods    | Meshlets  | Materials |  Strings  |
+     *  +-----------+-----------+-----------+-----------+-----------+-----------+-----------+
+     *
+     *  Header      magic, version, content hash, dependencies hash, counts, bounds, stats, strings size
+     *  Vertices    Vertex array, material indices are into the materials of the mesh
+     *  Indices     IndexType array, every level of detail one after the other
+     *  Lods        LodInfo array, the index and meshlet range of each level of detail
+     *  Meshlets    MeshletInfo array, the index range and bounds of each meshlet, every level one after the other
+     *  Materials   Material array, texture indices are slots into the texture names (see SYMeshLoading::ImportInfo)
+     *  Strings     uint32_t length followed by the characters, the dependency (mtl file, or written out image) paths
+     *              and then the texture names
+     *
+     * The vertices and indices are the optimized (see SBMeshOptimizer, SBMeshSimplifier, SBMeshletBuilder) result of
+     * importing the model file, and are viewed in place once the file is mapped. Cache files are named after the
+     * content hash of the model file (and the mtl search path). The files it depends on are only known after parsing,
+     * and so are validated against the dependencies hash once mapped
+    */
+    const char* g_meshCacheFileMagic      = "MSC1";
+    const char* g_meshCacheFileExtension  = ".msc";
+    const uint32_t g_meshCacheFileVersion = 5;
+
+    /* Imported geometry, shared by every mesh component that refers to it. Meshes imported from a model file are keyed
+     * by the file path along with the import options (mtl search path), so that each file is only parsed once no matter
+     * how many entities use it
+    */
+    class SBMeshPool {
+        public:
+            /* The vertices and indices view a memory mapped cache file, or the owned vertices and indices otherwise
+             * (manually populated meshes, or a cache miss). Note that, moving a mesh info keeps the views valid but
+             * copying it does not
+            */
+            struct MeshInfo {
+                std::span <Vertex> vertices;
+                std::span <IndexType> indices;
+                std::vector <Vertex> ownedVertices;
+                std::vector <IndexType> ownedIndices;
+                /* Level 0 is the full resolution range, and is the only level of manually populated meshes */
+                std::vector <LodInfo> lodInfos;
+                /* Meshlets of every level of detail, see SBMeshletBuilder */
+                std::vector <MeshletInfo> meshletInfos;
+                /* Materials as imported, which are copied into the material table once the mesh is added (at
+                 * firstMaterialIdx). Edits are made to the material table
+                */
+                std::vector <Material> materials;
+                uint32_t firstMaterialIdx;
+                void* mappedData;
+                size_t mappedSize;
+                /* Empty for manually populated meshes */
+                std::string key;
+                /* Bounds in model space, an axis aligned box and a sphere centered on the box. The radius reaches the
+                 * farthest vertex rather than the corners of the box, which is tighter for round meshes
+                */
+                glm::vec3 minPosition;
+                glm::vec3 maxPosition;
+                glm::vec3 center;
+                float radius;
+                /* Stats before and after the load time optimizations, only recorded for meshes imported from a model
+                 * file
+                */
+                MeshStatsInfo unoptimizedStatsInfo;
+                MeshStatsInfo optimizedStatsInfo;
+                /* Time taken (in milliseconds) to import the mesh, and whether it was mapped from the mesh cache rather
+                 * than parsed. Not cached, and zero for manually populated meshes
+                */
+                float importTime;
+                bool cacheHit;
+            };
+
+        private:
+            struct CacheFileHeader {
+                char magic[4];
+                uint32_t version;
+                uint64_t contentHash;
+                uint64_t dependenciesHash;
+                uint32_t verticesCount;
+                uint32_t indicesCount;
+                uint32_t lodsCount;
+                uint32_t meshletsCount;
+                uint32_t materialsCount;
+                uint32_t dependenciesCount;
+                uint32_t textureNamesCount;
+                float minPosition[3];
+                float maxPosition[3];
+                float center[3];
+                float radius;
+                MeshStatsInfo unoptimizedStatsInfo;
+                MeshStatsInfo optimizedStatsInfo;
+                uint64_t stringsSize;
+            };
+
+            struct MeshPoolInfo {
+                struct Meta {
+                    std::unordered_map <std::string, uint32_t> keyToIdxMap;
+                    /* Indexed by mesh idx */
+                    std::vector <MeshInfo> meshInfos;
+                    /* Materials of every mesh, one after the other in the order the meshes were added */
+                    std::vector <Material> materials;
+                    std::string cacheDirPath;
+                } meta;
+
+                struct Resource {
+                    Log::LGImpl* logObj;
+                } resource;
+            } m_meshPoolInfo;
+
+            std::string getMeshKey (const std::string modelFilePath, const std::string mtlFileDirPath) {
+                return modelFilePath + "|" + mtlFileDirPath;
+            }
+
+            /* FNV-1a */
+            void updateHash (const void* data, const size_t size, uint64_t& hash) {
+                auto bytes = static_cast <const uint8_t*> (data);
+                for (size_t i = 0; i < size; i++) {
+                    hash  ^= bytes[i];
+                    hash  *= 1099511628211ull;
+                }
+            }
+
+            /* Returns false (leaving the hash as is) if the file can't be read */
+            bool updateFileHash (const std::string filePath, uint64_t& hash) {
+                int fileDescriptor = open (filePath.c_str(), O_RDONLY);
+                if (fileDescriptor == -1)
+                    return false;
+
+                struct stat fileStat;
+                bool fileHashed    = fstat (fileDescriptor, &fileStat) == 0;
+                size_t fileSize    = fileHashed ? static_cast <size_t> (fileStat.st_size): 0;
+                if (fileSize > 0) {
+                    void* data     = mmap (nullptr, fileSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+                    fileHashed     = data != MAP_FAILED;
+                    if (fileHashed) {
+                        updateHash (data, fileSize, hash);
+                        munmap (data, fileSize);
+                    }
+                }
+                close (fileDescriptor);
+                return fileHashed;
+            }
+
+            /* Missing dependencies are hashed as well, so that an mtl file showing up later invalidates the cache */
+            uint64_t getDependenciesHash (const std::vector <std::string>& dependencyPaths) {
+                uint64_t hash = 14695981039346656037ull;
+                for (auto const& dependencyPath: dependencyPaths) {
+                    updateHash (dependencyPath.data(), dependencyPath.size(), hash);
+                    uint8_t fileFound = updateFileHash (dependencyPath, hash) ? 1: 0;
+                    updateHash (&fileFound, sizeof (fileFound), hash);
+                }
+                return hash;
+            }
+
+            std::string getCacheFilePath (const uint64_t contentHash) {
+                char fileName[17];
+                snprintf (fileName, sizeof (fileName), "%016" PRIx64, contentHash);
+                return m_meshPoolInfo.meta.cacheDirPath + "/" + fileName + g_meshCacheFileExtension;
+            }
+
+            /* Returns false if the string runs past the end */
+            bool readString (const uint8_t*& ptr, const uint8_t* end, std::string& value) {
+                uint32_t length;
+                if (static_cast <size_t> (end - ptr) < sizeof (length))
+                    return false;
+                std::memcpy (&length, ptr, sizeof (length));
+                ptr += sizeof (length);
+                if (static_cast <size_t> (end - ptr) < length)
+                    return false;
+                value.assign (reinterpret_cast <const char*> (ptr), length);
+                ptr += length;
+                return true;
+            }
+
+            void writeString (std::ofstream& file, const std::string& value) {
+                auto length = static_cast <uint32_t> (value.size());
+                file.write (reinterpret_cast <const char*> (&length), sizeof (length));
+                file.write (value.data(), static_cast <std::streamsize> (length));
+            }
+
+            void unmapMesh (MeshInfo& meshInfo) {
+                if (meshInfo.mappedData != nullptr)
+                    munmap (meshInfo.mappedData, meshInfo.mappedSize);
+                meshInfo.mappedData = nullptr;
+                meshInfo.mappedSize = 0;
+            }
+
+        public:
+            SBMeshPool (void) {
+                m_meshPoolInfo = {};
+
+                auto& logObj = m_meshPoolInfo.resource.logObj;
+                logObj       = new Log::LGImpl();
+                logObj->initLogInfo     ("Build/Log/SandBox",     __FILE__);
+                logObj->updateLogConfig (Log::LEVEL_TYPE_INFO,    Log::SINK_TYPE_FILE);
+                logObj->updateLogConfig (Log::LEVEL_TYPE_WARNING, Log::SINK_TYPE_CONSOLE | Log::SINK_TYPE_FILE);
+                logObj->updateLogConfig (Log::LEVEL_TYPE_ERROR,   Log::SINK_TYPE_CONSOLE | Log::SINK_TYPE_FILE);
+            }
+
+            /* Imported meshes are cached under cacheDirPath, see g_meshCacheFileMagic */
+            void initMeshPoolInfo (const std::string cacheDirPath) {
+                auto& meta        = m_meshPoolInfo.meta;
+                meta.keyToIdxMap  = {};
+                meta.meshInfos    = {};
+                meta.materials    = {};
+                meta.cacheDirPath = cacheDirPath;
+            }
+
+            bool isMeshAdded (const std::string modelFilePath, const std::string mtlFileDirPath) {
+                auto& keyToIdxMap = m_meshPoolInfo.meta.keyToIdxMap;
+                return keyToIdxMap.find (getMeshKey (modelFilePath, mtlFileDirPath)) != keyToIdxMap.end();
+            }
+
+            uint32_t getMeshIdx (const std::string modelFilePath, const std::string mtlFileDirPath) {
+                auto& keyToIdxMap = m_meshPoolInfo.meta.keyToIdxMap;
+                auto key          = getMeshKey (modelFilePath, mtlFileDirPath);
+                if (keyToIdxMap.find (key) == keyToIdxMap.end()) {
+                    LOG_ERROR (m_meshPoolInfo.resource.logObj) << "Mesh does not exist"
+                                                               << " "
+                                                               << "[" << key << "]"
+                                                               << std::endl;
+                    throw std::runtime_error ("Mesh does not exist");
+                }
+                return keyToIdxMap[key];
+            }
+
+            MeshInfo& getMeshInfo (const uint32_t meshIdx) {
+                auto& meshInfos = m_meshPoolInfo.meta.meshInfos;
+                if (meshIdx >= meshInfos.size()) {
+                    LOG_ERROR (m_meshPoolInfo.resource.logObj) << "Mesh info does not exist"
+                                                               << " "
+                                                               << "[" << meshIdx << "]"
+                                                               << std::endl;
+                    throw std::runtime_error ("Mesh info does not exist");
+                }
+                return meshInfos[meshIdx];
+            }
+
+            /* The functions below (up until addMesh) only touch the given mesh info and the cache files, and so are
+             * safe to call from the job pool workers
+            */
+            void updateBounds (MeshInfo& meshInfo) {
+                meshInfo.minPosition     = {0.0f, 0.0f, 0.0f};
+                meshInfo.maxPosition     = {0.0f, 0.0f, 0.0f};
+                meshInfo.center          = {0.0f, 0.0f, 0.0f};
+                meshInfo.radius          = 0.0f;
+                if (meshInfo.vertices.empty())
+                    return;
+
+                meshInfo.minPosition     = meshInfo.vertices[0].meta.position;
+                meshInfo.maxPosition     = meshInfo.vertices[0].meta.position;
+                for (auto const& vertex: meshInfo.vertices) {
+                    meshInfo.minPosition = glm::min (meshInfo.minPosition, vertex.meta.position);
+                    meshInfo.maxPosition = glm::max (meshInfo.maxPosition, vertex.meta.position);
+                }
+
+                float maxDistance2       = 0.0f;
+                meshInfo.center          = (meshInfo.minPosition + meshInfo.maxPosition) * 0.5f;
+                for (auto const& vertex: meshInfo.vertices) {
+                    glm::vec3 offset     = vertex.meta.position - meshInfo.center;
+                    maxDistance2         = std::max (maxDistance2, glm::dot (offset, offset));
+                }
+                meshInfo.radius          = std::sqrt (maxDistance2);
+            }
+
+            /* FNV-1a over the model file bytes along with the mtl search path, returns false if the model file can't be
+             * read
+            */
+            bool getContentHash (const std::string modelFilePath,
+                                 const std::string mtlFileDirPath,
+                                 uint64_t& contentHash) {
+
+                contentHash = 14695981039346656037ull;
+                if (!updateFileHash (modelFilePath, contentHash))
+                    return false;
+                updateHash (mtlFileDirPath.data(), mtlFileDirPath.size(), contentHash);
+                return true;
+            }
+
+            /* Map the cache file (if any) and validate it against the content hash and the dependencies. Anything
+             * unexpected is treated as a miss, and the file is overwritten once the model is imported again. The
+             * mapping is read only, since texture slots are only resolved in the (copied) materials, see
+             * SYMeshLoading::publishModel
+            */
+            bool readCacheFile (const uint64_t contentHash,
+                                MeshInfo& meshInfo,
+                                std::vector <std::string>& textureNames) {
+
+                int fileDescriptor = open (getCacheFilePath (contentHash).c_str(), O_RDONLY);
+                if (fileDescriptor == -1)
+                    return false;
+
+                struct stat fileStat;
+                void* mappedData   = MAP_FAILED;
+                size_t mappedSize  = 0;
+                if (fstat (fileDescriptor, &fileStat) == 0 && fileStat.st_size > 0) {
+                    mappedSize     = static_cast <size_t> (fileStat.st_size);
+                    mappedData     = mmap (nullptr,
+                                           mappedSize,
+                                           PROT_READ,
+                                           MAP_PRIVATE,
+                                           fileDescriptor,
+                                           0);
+                }
+                /* The mapping stays valid after the file is closed */
+                close (fileDescriptor);
+                if (mappedData == MAP_FAILED)
+                    return false;
+
+                CacheFileHeader header;
+                size_t verticesOffset  = sizeof (header);
+                size_t indicesOffset   = 0;
+                size_t lodsOffset      = 0;
+                size_t meshletsOffset  = 0;
+                size_t materialsOffset = 0;
+                size_t stringsOffset   = 0;
+                bool cacheFileValid    = mappedSize >= sizeof (header);
+                if (cacheFileValid) {
+                    std::memcpy (&header, mappedData, sizeof (header));
+                    indicesOffset      = verticesOffset  + header.verticesCount  * sizeof (Vertex);
+                    lodsOffset         = indicesOffset   + header.indicesCount   * sizeof (IndexType);
+                    meshletsOffset     = lodsOffset      + header.lodsCount      * sizeof (LodInfo);
+                    materialsOffset    = meshletsOffset  + header.meshletsCount  * sizeof (MeshletInfo);
+                    stringsOffset      = materialsOffset + header.materialsCount * sizeof (Material);
+                    cacheFileValid     = std::memcmp (header.magic, g_meshCacheFileMagic, 4) == 0 &&
+                                         header.version     == g_meshCacheFileVersion             &&
+                                         header.contentHash == contentHash                        &&
+                                         header.lodsCount   >= 1                                  &&
+                                         header.lodsCount   <= g_maxLodsCount                     &&
+                                         stringsOffset + header.stringsSize == mappedSize;
+                }
+                std::vector <std::string> dependencyPaths    (cacheFileValid ? header.dependenciesCount: 0);
+                std::vector <std::string> cachedTextureNames (cacheFileValid ? header.textureNamesCount: 0);
+                if (cacheFileValid) {
+                    auto ptr = static_cast <const uint8_t*> (mappedData) + stringsOffset;
+                    auto end = static_cast <const uint8_t*> (mappedData) + mappedSize;
+                    for (auto& dependencyPath: dependencyPaths)
+                        cacheFileValid = cacheFileValid && readString (ptr, end, dependencyPath);
+                    for (auto& textureName: cachedTextureNames)
+                        cacheFileValid = cacheFileValid && readString (ptr, end, textureName);
+                    cacheFileValid     = cacheFileValid && ptr == end &&
+                                         getDependenciesHash (dependencyPaths) == header.dependenciesHash;
+                }
+                if (!cacheFileValid) {
+                    munmap (mappedData, mappedSize);
+                    return false;
+                }
+
+                auto data                     = static_cast <uint8_t*> (mappedData);
+                meshInfo.vertices             = {reinterpret_cast <Vertex*>    (data + verticesOffset),
+                                                 header.verticesCount};
+                meshInfo.indices              = {reinterpret_cast <IndexType*> (data + indicesOffset),
+                                                 header.indicesCount};
+                meshInfo.ownedVertices        = {};
+                meshInfo.ownedIndices         = {};
+                meshInfo.lodInfos.resize (header.lodsCount);
+                std::memcpy (meshInfo.lodInfos.data(), data + lodsOffset, header.lodsCount * sizeof (LodInfo));
+                meshInfo.meshletInfos.resize (header.meshletsCount);
+                std::memcpy (meshInfo.meshletInfos.data(),
+                             data + meshletsOffset,
+                             header.meshletsCount * sizeof (MeshletInfo));
+                meshInfo.materials.resize (header.materialsCount);
+                std::memcpy (meshInfo.materials.data(),
+                             data + materialsOffset,
+                             header.materialsCount * sizeof (Material));
+                meshInfo.mappedData           = mappedData;
+                meshInfo.mappedSize           = mappedSize;
+                meshInfo.minPosition          = {header.minPosition[0], header.minPosition[1], header.minPosition[2]};
+                meshInfo.maxPosition          = {header.maxPosition[0], header.maxPosition[1], header.maxPosition[2]};
+                meshInfo.center               = {header.center[0],      header.center[1],      header.center[2]};
+                meshInfo.radius               = header.radius;
+                meshInfo.unoptimizedStatsInfo = header.unoptimizedStatsInfo;
+                meshInfo.optimizedStatsInfo   = header.optimizedStatsInfo;
+                textureNames                  = cachedTextureNames;
+                return true;
+            }
+
+            /* The file is written under a temporary name and renamed into place, so that a reader never maps a
+             * partially written file
+            */
+            bool writeCacheFile (const uint64_t contentHash,
+                                 const std::vector <std::string>& dependencyPaths,
+                                 const MeshInfo& meshInfo,
+                                 const std::vector <std::string>& textureNames) {
+
+                CacheFileHeader header;
+                /* Zero the padding as well, since the header is written as is */
+                std::memset (&header, 0, sizeof (header));
+                std::memcpy (header.magic, g_meshCacheFileMagic, 4);
+                header.version              = g_meshCacheFileVersion;
+                header.contentHash          = contentHash;
+                header.dependenciesHash     = getDependenciesHash (dependencyPaths);
+                header.verticesCount        = static_cast <uint32_t> (meshInfo.vertices.size());
+                header.indicesCount         = static_cast <uint32_t> (meshInfo.indices.size());
+                header.lodsCount            = static_cast <uint32_t> (meshInfo.lodInfos.size());
+                header.meshletsCount        = static_cast <uint32_t> (meshInfo.meshletInfos.size());
+                header.materialsCount       = static_cast <uint32_t> (meshInfo.materials.size());
+                header.dependenciesCount    = static_cast <uint32_t> (dependencyPaths.size());
+                header.textureNamesCount    = static_cast <uint32_t> (textureNames.size());
+                header.unoptimizedStatsInfo = meshInfo.unoptimizedStatsInfo;
+                header.optimizedStatsInfo   = meshInfo.optimizedStatsInfo;
+                for (uint32_t i = 0; i < 3; i++) {
+                    header.minPosition[i]   = meshInfo.minPosition[i];
+                    header.maxPosition[i]   = meshInfo.maxPosition[i];
+                    header.center[i]        = meshInfo.center[i];
+                }
+                header.radius               = meshInfo.radius;
+                for (auto const& dependencyPath: dependencyPaths)
+                    header.stringsSize     += sizeof (uint32_t) + dependencyPath.size();
+                for (auto const& textureName: textureNames)
+                    header.stringsSize     += sizeof (uint32_t) + textureName.size();
+
+                auto cacheFilePath       = getCacheFilePath (contentHash);
+                std::string tempFilePath = cacheFilePath + "." + std::to_string (
+                    std::hash <std::thread::id>{} (std::this_thread::get_id())
+                );
+                std::ofstream file (tempFilePath, std::ios::binary);
+                if (!file.is_open()) {
+                    LOG_WARNING (m_meshPoolInfo.resource.logObj) << "Failed to open mesh cache file"
+                                                                 << " "
+                                                                 << "[" << tempFilePath << "]"
+                                                                 << std::endl;
+                    return false;
+                }
+                file.write (reinterpret_cast <const char*> (&header), sizeof (header));
+                file.write (reinterpret_cast <const char*> (meshInfo.vertices.data()),
+                            static_cast <std::streamsize> (meshInfo.vertices.size_bytes()));
+                file.write (reinterpret_cast <const char*> (meshInfo.indices.data()),
+                            static_cast <std::streamsize> (meshInfo.indices.size_bytes()));
+                file.write (reinterpret_cast <const char*> (meshInfo.lodInfos.data()),
+                            static_cast <std::streamsize> (meshInfo.lodInfos.size() * sizeof (LodInfo)));
+                file.write (reinterpret_cast <const char*> (meshInfo.meshletInfos.data()),
+                            static_cast <std::streamsize> (meshInfo.meshletInfos.size() * sizeof (MeshletInfo)));
+                file.write (reinterpret_cast <const char*> (meshInfo.materials.data()),
+                            static_cast <std::streamsize> (meshInfo.materials.size() * sizeof (Material)));
+                for (auto const& dependencyPath: dependencyPaths)
+                    writeString (file, dependencyPath);
+                for (auto const& textureName: textureNames)
+                    writeString (file, textureName);
+                file.close();
+
+                if (!file || std::rename (tempFilePath.c_str(), cacheFilePath.c_str()) != 0) {
+                    LOG_WARNING (m_meshPoolInfo.resource.logObj) << "Failed to write mesh cache file"
+                                                                 << " "
+                                                                 << "[" << cacheFilePath << "]"
+                                                                 << std::endl;
+                    std::remove (tempFilePath.c_str());
+                    return false;
+                }
+                return true;
+            }
+
+            /* Images embedded in a model file (see SBGLBParser) are written out next to the cache files, since the
+             * texture pool only loads images from a file. They are named after the content hash of the image, and so
+             * an image that has already been written out (by an earlier run, or another model) is not written again
+            */
+            bool writeImageFile (const uint8_t* data,
+                                 const size_t size,
+                                 const std::string fileExtension,
+                                 std::string& imageFilePath) {
+
+                uint64_t hash = 14695981039346656037ull;
+                updateHash (data, size, hash);
+                char fileName[17];
+                snprintf (fileName, sizeof (fileName), "%016" PRIx64, hash);
+                imageFilePath = m_meshPoolInfo.meta.cacheDirPath + "/" + fileName + fileExtension;
+                if (access (imageFilePath.c_str(), F_OK) == 0)
+                    return true;
+
+                std::string tempFilePath = imageFilePath + "." + std::to_string (
+                    std::hash <std::thread::id>{} (std::this_thread::get_id())
+                );
+                std::ofstream file (tempFilePath, std::ios::binary);
+                if (file.is_open()) {
+                    file.write (reinterpret_cast <const char*> (data), static_cast <std::streamsize> (size));
+                    file.close();
+                }
+                if (!file || std::rename (tempFilePath.c_str(), imageFilePath.c_str()) != 0) {
+                    LOG_WARNING (m_meshPoolInfo.resource.logObj) << "Failed to write image file"
+                                                                 << " "
+                                                                 << "[" << imageFilePath << "]"
+                                                                 << std::endl;
+                    std::remove (tempFilePath.c_str());
+                    return false;
+                }
+                return true;
+            }
+
+            /* Add a mesh imported from a model file, returns the existing mesh if the model has already been added */
+            uint32_t addMesh (const std::string modelFilePath,
+                              const std::string mtlFileDirPath,
+                              MeshInfo&& meshInfo) {
+
+                auto& meta = m_meshPoolInfo.meta;
+                auto key   = getMeshKey (modelFilePath, mtlFileDirPath);
+                if (meta.keyToIdxMap.find (key) != meta.keyToIdxMap.end()) {
+                    unmapMesh (meshInfo);
+                    return meta.keyToIdxMap[key];
+                }
+
+                meshInfo.key              = key;
+                meshInfo.firstMaterialIdx = static_cast <uint32_t> (meta.materials.size());
+                meta.materials.insert (meta.materials.end(), meshInfo.materials.begin(), meshInfo.materials.end());
+                meta.keyToIdxMap[key]     = static_cast <uint32_t> (meta.meshInfos.size());
+                meta.meshInfos.push_back (std::move (meshInfo));
+                return meta.keyToIdxMap[key];
+            }
+
+            /* Add a manually populated mesh, these are never shared (or cached). The vertices refer to a single
+             * material that uses the first texture in the pool for every texture type
+            */
+            uint32_t addMesh (std::vector <Vertex>&& vertices, std::vector <IndexType>&& indices) {
+                auto& meta                = m_meshPoolInfo.meta;
+                MeshInfo meshInfo         = {};
+                meshInfo.ownedVertices    = std::move (vertices);
+                meshInfo.ownedIndices     = std::move (indices);
+                meshInfo.vertices         = meshInfo.ownedVertices;
+                meshInfo.indices          = meshInfo.ownedIndices;
+                meshInfo.lodInfos         = {{0, static_cast <uint32_t> (meshInfo.indices.size()), 0.0f, 0, 0}};
+                meshInfo.materials        = {{0, 0, 0, 0}};
+                generateMeshlets (meshInfo.ownedVertices,
+                                  meshInfo.ownedIndices,
+                                  meshInfo.lodInfos,
+                                  meshInfo.meshletInfos);
+                meshInfo.firstMaterialIdx = static_cast <uint32_t> (meta.materials.size());
+                meta.materials.insert (meta.materials.end(), meshInfo.materials.begin(), meshInfo.materials.end());
+                updateBounds (meshInfo);
+
+                meta.meshInfos.push_back (std::move (meshInfo));
+                return static_cast <uint32_t> (meta.meshInfos.size() - 1);
+            }
+
+            /* Indexed by the first material idx of a mesh plus the material idx of its vertices */
+            std::vector <Material>& getMaterials (void) {
+                return m_meshPoolInfo.meta.materials;
+            }
+
+            void generateReport (void) {
+                auto& meshInfos = m_meshPoolInfo.meta.meshInfos;
+                auto& logObj    = m_meshPoolInfo.resource.logObj;
+
+                LOG_LITE_INFO (logObj)     << "{"                                  << std::endl;
+                for (uint32_t i = 0; i < meshInfos.size(); i++) {
+                    LOG_LITE_INFO (logObj) << "\t" << ALIGN_AND_PAD_S << i                             << ", "
+                                                   << ALIGN_AND_PAD_S << meshInfos[i].vertices.size()  << ", "
+                                                   << ALIGN_AND_PAD_S << meshInfos[i].indices.size()   << ", "
+                                                   << ALIGN_AND_PAD_S << meshInfos[i].materials.size() << ", "
+                                                   << ALIGN_AND_PAD_S << (meshInfos[i].mappedData != nullptr ?
+                                                                          "MAPPED": "OWNED")           << ", "
+                                                   << meshInfos[i].key << std::endl;
+                    if (meshInfos[i].key.empty())
+                        continue;
+                    /* ACMR, ATVR and overdraw, before -> after the load time optimizations */
+                    auto& unoptimizedStatsInfo = meshInfos[i].unoptimizedStatsInfo;
+                    auto& optimizedStatsInfo   = meshInfos[i].optimizedStatsInfo;
+                    LOG_LITE_INFO (logObj) << "\t" << ALIGN_AND_PAD_S << ""                            << ", "
+                                                   << ALIGN_AND_PAD_S << unoptimizedStatsInfo.acmr     << " -> "
+                                                   << optimizedStatsInfo.acmr                          << ", "
+                                                   << ALIGN_AND_PAD_S << unoptimizedStatsInfo.atvr     << " -> "
+                                                   << optimizedStatsInfo.atvr                          << ", "
+                                                   << ALIGN_AND_PAD_S << unoptimizedStatsInfo.overdraw << " -> "
+                                                   << optimizedStatsInfo.overdraw                      << std::endl;
+                    /* Indices count, meshlets count and error of each level of detail */
+                    for (auto const& lodInfo: meshInfos[i].lodInfos) {
+                        LOG_LITE_INFO (logObj) << "\t" << ALIGN_AND_PAD_S << ""                        << ", "
+                                                       << ALIGN_AND_PAD_S << lodInfo.indicesCount      << ", "
+                                                       << ALIGN_AND_PAD_S << lodInfo.meshletsCount     << ", "
+                                                       << lodInfo.error                                << std::endl;
+                    }
+                }
+                LOG_LITE_INFO (logObj)     << "}"                                  << std::endl;
+            }
+
+            ~SBMeshPool (void) {
+                for (auto& meshInfo: m_meshPoolInfo.meta.meshInfos)
+                    unmapMesh (meshInfo);
+                delete m_meshPoolInfo.resource.logObj;
+            }
+    };
+}   // namespace SandBox
\ No newline at end of file
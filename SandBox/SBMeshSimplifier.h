@@ -0,0 +1,364 @@
+#pragma once
+#include "../Backend/Common.h"
+#include "SBRendererType.h"
+#include "SBMeshOptimizer.h"
+/* Load time generation of the level of detail chain of a triangle mesh. Each level is produced by collapsing edges of
+ * the full resolution mesh in the order of their quadric error (Garland and Heckbert, "Surface Simplification Using
+ * Quadric Error Metrics"), onto one of their existing end points. As a result no vertices are added, and every level
+ * is only another range of indices into the same vertices
+ *
+ * Vertices are welded on their position first, since the imported meshes split vertices along normal and texture
+ * coordinate seams. A corner that is moved onto another position takes the vertex there with the closest attributes,
+ * and vertices on a seam (or on the border of the mesh) may only be collapsed onto other seam (or border) vertices
+*/
+namespace SandBox {
+    /* Each level targets half the triangles of the previous one, and has to remove at least 10% of them, otherwise the
+     * chain ends there
+    */
+    const float g_lodTrianglesRatio   = 0.5f;
+    const float g_minLodReduction     = 0.1f;
+    /* Largest simplification error of any level, relative to the diagonal of the mesh bounds */
+    const float g_maxLodRelativeError = 0.05f;
+    /* Border edges are held in place by planes perpendicular to their triangle, weighted by this */
+    const float g_lodBorderWeight     = 10.0f;
+
+    /* Range of a level of detail within the indices of a mesh. The error is the distance (in model space) by which the
+     * level deviates from the full resolution surface. The meshlets of the level (see SBMeshletBuilder) cover its index
+     * range
+    */
+    struct LodInfo {
+        uint32_t firstIndexIdx;
+        uint32_t indicesCount;
+        float error;
+        uint32_t firstMeshletIdx;
+        uint32_t meshletsCount;
+    };
+
+    /* Symmetric 4x4 matrix (A, b, c) of the sum of squared distances to a set of planes, along with the sum of the
+     * plane weights so that the error is a weighted mean
+    */
+    struct QuadricInfo {
+        double a00, a01, a02, a11, a12, a22;
+        double b0, b1, b2;
+        double c;
+        double weight;
+    };
+
+    void addPlaneQuadric (QuadricInfo& quadricInfo,
+                          const glm::vec3& normal,
+                          const glm::vec3& point,
+                          const double weight) {
+
+        double nx = normal.x, ny = normal.y, nz = normal.z;
+        double d  = -(nx * point.x + ny * point.y + nz * point.z);
+        quadricInfo.a00    += weight * nx * nx;
+        quadricInfo.a01    += weight * nx * ny;
+        quadricInfo.a02    += weight * nx * nz;
+        quadricInfo.a11    += weight * ny * ny;
+        quadricInfo.a12    += weight * ny * nz;
+        quadricInfo.a22    += weight * nz * nz;
+        quadricInfo.b0     += weight * nx * d;
+        quadricInfo.b1     += weight * ny * d;
+        quadricInfo.b2     += weight * nz * d;
+        quadricInfo.c      += weight * d  * d;
+        quadricInfo.weight += weight;
+    }
+
+    QuadricInfo getQuadricSum (const QuadricInfo& a, const QuadricInfo& b) {
+        return {
+            a.a00 + b.a00, a.a01 + b.a01, a.a02 + b.a02, a.a11 + b.a11, a.a12 + b.a12, a.a22 + b.a22,
+            a.b0  + b.b0,  a.b1  + b.b1,  a.b2  + b.b2,
+            a.c   + b.c,
+            a.weight + b.weight
+        };
+    }
+
+    /* Mean squared distance of the point to the planes */
+    double getQuadricError (const QuadricInfo& quadricInfo, const glm::vec3& point) {
+        double x = point.x, y = point.y, z = point.z;
+        double error = quadricInfo.a00 * x * x + quadricInfo.a11 * y * y + quadricInfo.a22 * z * z +
+                       2.0 * (quadricInfo.a01 * x * y + quadricInfo.a02 * x * z + quadricInfo.a12 * y * z) +
+                       2.0 * (quadricInfo.b0  * x     + quadricInfo.b1  * y     + quadricInfo.b2  * z)     +
+                       quadricInfo.c;
+        return std::max (error, 0.0) / std::max (quadricInfo.weight, std::numeric_limits <double>::min());
+    }
+
+    /* Returns the surviving triangles once the indices count drops to the target, or once the next collapse would
+     * exceed the max error. The error of the result is the largest error of any collapse made
+    */
+    std::vector <IndexType> simplifyMesh (const std::vector <Vertex>& vertices,
+                                          const std::vector <IndexType>& indices,
+                                          const size_t targetIndicesCount,
+                                          const float maxError,
+                                          float& resultError) {
+
+        resultError            = 0.0f;
+        size_t trianglesCount  = indices.size() / 3;
+        /* Weld vertices on their position */
+        std::unordered_map <glm::vec3, uint32_t> positionToIdxMap;
+        std::vector <uint32_t> positionIdxs (vertices.size());
+        std::vector <glm::vec3> positions;
+        std::vector <std::vector <uint32_t>> positionIdxToVertexIdxsMap;
+        for (size_t i = 0; i < vertices.size(); i++) {
+            auto& position = vertices[i].meta.position;
+            auto it        = positionToIdxMap.find (position);
+            if (it == positionToIdxMap.end()) {
+                it         = positionToIdxMap.insert ({position, static_cast <uint32_t> (positions.size())}).first;
+                positions.push_back (position);
+                positionIdxToVertexIdxsMap.push_back ({});
+            }
+            positionIdxs[i] = it->second;
+            positionIdxToVertexIdxsMap[it->second].push_back (static_cast <uint32_t> (i));
+        }
+
+        std::vector <IndexType> triangles (indices);
+        std::vector <uint8_t> trianglesRemoved (trianglesCount, 0);
+        std::vector <std::vector <uint32_t>> positionIdxToTriangleIdxsMap (positions.size());
+        /* Edges used by a single triangle make up the border of the mesh */
+        std::unordered_map <uint64_t, uint32_t> edgeToUsesCountMap;
+        auto getEdgeKey = [](uint32_t a, uint32_t b) {
+            return (static_cast <uint64_t> (std::min (a, b)) << 32) | std::max (a, b);
+        };
+        for (size_t i = 0; i < trianglesCount; i++) {
+            for (uint32_t j = 0; j < 3; j++) {
+                uint32_t a = positionIdxs[triangles[i * 3 + j]];
+                uint32_t b = positionIdxs[triangles[i * 3 + (j + 1) % 3]];
+                positionIdxToTriangleIdxsMap[a].push_back (static_cast <uint32_t> (i));
+                if (a != b)
+                    ++edgeToUsesCountMap[getEdgeKey (a, b)];
+            }
+        }
+
+        std::vector <QuadricInfo> quadricInfos (positions.size(), QuadricInfo {});
+        std::vector <uint8_t> positionsOnBorder (positions.size(), 0);
+        for (size_t i = 0; i < trianglesCount; i++) {
+            uint32_t corners[3] = {
+                positionIdxs[triangles[i * 3 + 0]],
+                positionIdxs[triangles[i * 3 + 1]],
+                positionIdxs[triangles[i * 3 + 2]]
+            };
+            glm::vec3 normal = glm::cross (positions[corners[1]] - positions[corners[0]],
+                                           positions[corners[2]] - positions[corners[0]]);
+            float length     = glm::length (normal);
+            if (length == 0.0f)
+                continue;
+            normal          /= length;
+            /* Planes are weighted by the area of their triangle */
+            for (uint32_t j = 0; j < 3; j++)
+                addPlaneQuadric (quadricInfos[corners[j]], normal, positions[corners[0]], length * 0.5);
+
+            for (uint32_t j = 0; j < 3; j++) {
+                uint32_t a = corners[j];
+                uint32_t b = corners[(j + 1) % 3];
+                if (a == b || edgeToUsesCountMap[getEdgeKey (a, b)] != 1)
+                    continue;
+
+                glm::vec3 edge       = positions[b] - positions[a];
+                glm::vec3 edgeNormal = glm::cross (normal, edge);
+                float edgeLength     = glm::length (edge);
+                if (edgeLength == 0.0f)
+                    continue;
+                edgeNormal          /= edgeLength;
+                double weight        = edgeLength * edgeLength * g_lodBorderWeight;
+                addPlaneQuadric (quadricInfos[a], edgeNormal, positions[a], weight);
+                addPlaneQuadric (quadricInfos[b], edgeNormal, positions[a], weight);
+                positionsOnBorder[a] = 1;
+                positionsOnBorder[b] = 1;
+            }
+        }
+
+        auto isCollapseAllowed = [&](uint32_t from, uint32_t to) {
+            if (positionsOnBorder[from] != 0 && positionsOnBorder[to] == 0)
+                return false;
+            if (positionIdxToVertexIdxsMap[from].size() > 1 && positionIdxToVertexIdxsMap[to].size() < 2)
+                return false;
+            return true;
+        };
+
+        struct CollapseInfo {
+            double cost;
+            uint32_t from;
+            uint32_t to;
+            uint32_t fromVersion;
+            uint32_t toVersion;
+
+            bool operator > (const CollapseInfo& other) const {
+                return cost > other.cost;
+            }
+        };
+        std::priority_queue <CollapseInfo, std::vector <CollapseInfo>, std::greater <CollapseInfo>> collapseInfos;
+        std::vector <uint32_t> versions (positions.size(), 0);
+        std::vector <uint8_t> positionsRemoved (positions.size(), 0);
+
+        auto pushCollapse = [&](uint32_t a, uint32_t b) {
+            auto quadricInfo = getQuadricSum (quadricInfos[a], quadricInfos[b]);
+            CollapseInfo collapseInfo = {std::numeric_limits <double>::max(), 0, 0, 0, 0};
+            if (isCollapseAllowed (a, b))
+                collapseInfo = {getQuadricError (quadricInfo, positions[b]), a, b, versions[a], versions[b]};
+            if (isCollapseAllowed (b, a)) {
+                double cost  = getQuadricError (quadricInfo, positions[a]);
+                if (cost < collapseInfo.cost)
+                    collapseInfo = {cost, b, a, versions[b], versions[a]};
+            }
+            if (collapseInfo.cost != std::numeric_limits <double>::max())
+                collapseInfos.push (collapseInfo);
+        };
+        auto pushCollapses = [&](uint32_t positionIdx) {
+            for (auto const& triangleIdx: positionIdxToTriangleIdxsMap[positionIdx]) {
+                if (trianglesRemoved[triangleIdx] != 0)
+                    continue;
+                for (uint32_t j = 0; j < 3; j++) {
+                    uint32_t other = positionIdxs[triangles[triangleIdx * 3 + j]];
+                    if (other != positionIdx)
+                        pushCollapse (positionIdx, other);
+                }
+            }
+        };
+        for (size_t i = 0; i < trianglesCount; i++) {
+            for (uint32_t j = 0; j < 3; j++) {
+                uint32_t a = positionIdxs[triangles[i * 3 + j]];
+                uint32_t b = positionIdxs[triangles[i * 3 + (j + 1) % 3]];
+                if (a < b)
+                    pushCollapse (a, b);
+            }
+        }
+
+        /* The vertex at the target position with the closest attributes (and the same material) takes the place of
+         * the vertex at the collapsed position
+        */
+        auto getClosestVertexIdx = [&](uint32_t vertexIdx, uint32_t positionIdx) {
+            auto& vertex          = vertices[vertexIdx];
+            uint32_t closestIdx   = positionIdxToVertexIdxsMap[positionIdx][0];
+            float closestDistance = std::numeric_limits <float>::max();
+            for (auto const& candidateIdx: positionIdxToVertexIdxsMap[positionIdx]) {
+                auto& candidate   = vertices[candidateIdx];
+                glm::vec2 uvDelta = candidate.meta.uv     - vertex.meta.uv;
+                glm::vec3 nDelta  = candidate.meta.normal - vertex.meta.normal;
+                float distance    = uvDelta.x * uvDelta.x + uvDelta.y * uvDelta.y + glm::dot (nDelta, nDelta);
+                if (candidate.materialIdx != vertex.materialIdx)
+                    distance     += 1000.0f;
+                if (distance < closestDistance) {
+                    closestDistance = distance;
+                    closestIdx      = candidateIdx;
+                }
+            }
+            return closestIdx;
+        };
+
+        size_t indicesCount = indices.size();
+        double maxCost      = static_cast <double> (maxError) * maxError;
+        while (indicesCount > targetIndicesCount && !collapseInfos.empty()) {
+            auto collapseInfo = collapseInfos.top();
+            collapseInfos.pop();
+            uint32_t from     = collapseInfo.from;
+            uint32_t to       = collapseInfo.to;
+            if (positionsRemoved[from] != 0 || positionsRemoved[to] != 0 ||
+                versions[from] != collapseInfo.fromVersion || versions[to] != collapseInfo.toVersion)
+                continue;
+            /* Collapses are popped in the order of their cost, and so none of the remaining ones are within the max
+             * error either
+            */
+            if (collapseInfo.cost > maxCost)
+                break;
+            /* Reject the collapse if it flips any of the triangles that remain */
+            bool trianglesFlipped = false;
+            for (auto const& triangleIdx: positionIdxToTriangleIdxsMap[from]) {
+                if (trianglesRemoved[triangleIdx] != 0)
+                    continue;
+                uint32_t corners[3] = {
+                    positionIdxs[triangles[triangleIdx * 3 + 0]],
+                    positionIdxs[triangles[triangleIdx * 3 + 1]],
+                    positionIdxs[triangles[triangleIdx * 3 + 2]]
+                };
+                if (corners[0] == to || corners[1] == to || corners[2] == to)
+                    continue;
+
+                glm::vec3 before[3], after[3];
+                for (uint32_t j = 0; j < 3; j++) {
+                    before[j]  = positions[corners[j]];
+                    after[j]   = corners[j] == from ? positions[to]: positions[corners[j]];
+                }
+                glm::vec3 beforeNormal = glm::cross (before[1] - before[0], before[2] - before[0]);
+                glm::vec3 afterNormal  = glm::cross (after[1]  - after[0],  after[2]  - after[0]);
+                if (glm::dot (beforeNormal, afterNormal) <= 0.0f) {
+                    trianglesFlipped   = true;
+                    break;
+                }
+            }
+            if (trianglesFlipped)
+                continue;
+
+            for (auto const& triangleIdx: positionIdxToTriangleIdxsMap[from]) {
+                if (trianglesRemoved[triangleIdx] != 0)
+                    continue;
+                auto triangle     = &triangles[triangleIdx * 3];
+                bool triangleDegenerate = positionIdxs[triangle[0]] == to ||
+                                          positionIdxs[triangle[1]] == to ||
+                                          positionIdxs[triangle[2]] == to;
+                if (triangleDegenerate) {
+                    trianglesRemoved[triangleIdx] = 1;
+                    indicesCount                 -= 3;
+                    continue;
+                }
+                for (uint32_t j = 0; j < 3; j++) {
+                    if (positionIdxs[triangle[j]] == from)
+                        triangle[j] = getClosestVertexIdx (triangle[j], to);
+                }
+                positionIdxToTriangleIdxsMap[to].push_back (triangleIdx);
+            }
+            quadricInfos[to]       = getQuadricSum (quadricInfos[to], quadricInfos[from]);
+            positionsRemoved[from] = 1;
+            ++versions[to];
+            resultError            = std::max (resultError, static_cast <float> (std::sqrt (collapseInfo.cost)));
+            pushCollapses (to);
+        }
+
+        std::vector <IndexType> simplifiedIndices;
+        simplifiedIndices.reserve (indicesCount);
+        for (size_t i = 0; i < trianglesCount; i++) {
+            if (trianglesRemoved[i] == 0)
+                simplifiedIndices.insert (simplifiedIndices.end(), &triangles[i * 3], &triangles[i * 3] + 3);
+        }
+        return simplifiedIndices;
+    }
+
+    /* Level 0 is the given (full resolution) indices. Every other level is simplified from level 0, optimized for the
+     * vertex cache and appended to the indices
+    */
+    void generateLods (const std::vector <Vertex>& vertices,
+                       std::vector <IndexType>& indices,
+                       std::vector <LodInfo>& lodInfos) {
+
+        lodInfos = {{0, static_cast <uint32_t> (indices.size()), 0.0f, 0, 0}};
+        if (vertices.empty() || indices.empty())
+            return;
+
+        glm::vec3 minPosition = vertices[0].meta.position;
+        glm::vec3 maxPosition = vertices[0].meta.position;
+        for (auto const& vertex: vertices) {
+            minPosition = glm::min (minPosition, vertex.meta.position);
+            maxPosition = glm::max (maxPosition, vertex.meta.position);
+        }
+        float maxError  = g_maxLodRelativeError * glm::length (maxPosition - minPosition);
+
+        std::vector <IndexType> fullIndices (indices);
+        for (uint32_t i = 1; i < g_maxLodsCount; i++) {
+            auto previousLodInfo = lodInfos.back();
+            auto targetIndicesCount = static_cast <size_t> (previousLodInfo.indicesCount * g_lodTrianglesRatio) / 3 * 3;
+            float error;
+            auto lodIndices = simplifyMesh (vertices, fullIndices, targetIndicesCount, maxError, error);
+            if (lodIndices.size() > previousLodInfo.indicesCount * (1.0f - g_minLodReduction))
+                break;
+
+            optimizeVertexCache (lodIndices, vertices.size());
+            lodInfos.push_back ({
+                static_cast <uint32_t> (indices.size()),
+                static_cast <uint32_t> (lodIndices.size()),
+                std::max (error, previousLodInfo.error),
+                0,
+                0
+            });
+            indices.insert (indices.end(), lodIndices.begin(), lodIndices.end());
+        }
+    }
+}   // namespace SandBox
\ No newline at end of file
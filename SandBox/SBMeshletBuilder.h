@@ -0,0 +1,251 @@
+#pragma once
+#include "../Backend/Common.h"
+#include "SBRendererType.h"
+#include "SBMeshSimplifier.h"
+/* Load time splitting of each level of detail of a triangle mesh into meshlets, small clusters of triangles that are
+ * culled on their own (see SBMeshletCuller). A meshlet is grown from the first triangle not yet taken (in the order
+ * left by SBMeshOptimizer), by repeatedly taking the neighbouring triangle that adds the fewest vertices, and among
+ * those the one closest to the meshlet that faces the most like it. The meshlet ends once it is full or has no
+ * neighbours left. Triangles are neighbours if they share a position rather than a vertex, so that meshes with split
+ * normals or texture seams (flat shaded meshes in particular) still grow meshlets across them
+ *
+ * The triangles of a meshlet are then written out one meshlet after the other, keeping their previous order within the
+ * meshlet, so that each meshlet is a contiguous range of indices that is drawn as is. Every meshlet records a bounding
+ * sphere and a cone that bounds the normals of its triangles, which is used to reject meshlets that only hold back
+ * faces for a view (Shirman and Abi-Ezzi, "The Cone of Normals Technique for Fast Processing of Curved Patches")
+*/
+namespace SandBox {
+    /* Matches the limits commonly used for mesh shaders, even though meshlets are only culled on the CPU here */
+    const uint32_t g_maxMeshletVerticesCount  = 64;
+    const uint32_t g_maxMeshletTrianglesCount = 124;
+    /* How much facing alike is weighted against being close by, when picking the next triangle of a meshlet */
+    const float g_meshletConeWeight           = 0.5f;
+
+    /* Range of a meshlet within the indices of a mesh, along with its bounds in model space. The cone cutoff is the
+     * sine of the largest angle between the cone axis and the normal of any triangle in the meshlet, and is 1 when the
+     * normals spread too wide to ever cull the meshlet as a whole
+    */
+    struct MeshletInfo {
+        uint32_t firstIndexIdx;
+        uint32_t indicesCount;
+        glm::vec3 center;
+        float radius;
+        glm::vec3 coneAxis;
+        float coneCutoff;
+    };
+
+    /* Unit normal of a triangle, or zero for degenerate triangles */
+    glm::vec3 getTriangleNormal (const std::vector <Vertex>& vertices, const IndexType* triangle) {
+        auto& position0  = vertices[triangle[0]].meta.position;
+        auto& position1  = vertices[triangle[1]].meta.position;
+        auto& position2  = vertices[triangle[2]].meta.position;
+        glm::vec3 normal = glm::cross (position1 - position0, position2 - position0);
+        float length     = glm::length (normal);
+        return length > 0.0f ? normal / length: glm::vec3 (0.0f);
+    }
+
+    void updateMeshletBounds (const std::vector <Vertex>& vertices,
+                              const std::vector <IndexType>& indices,
+                              MeshletInfo& meshletInfo) {
+
+        auto triangles        = indices.data() + meshletInfo.firstIndexIdx;
+        size_t trianglesCount = meshletInfo.indicesCount / 3;
+        glm::vec3 minPosition = vertices[triangles[0]].meta.position;
+        glm::vec3 maxPosition = minPosition;
+        for (uint32_t i = 0; i < meshletInfo.indicesCount; i++) {
+            minPosition       = glm::min (minPosition, vertices[triangles[i]].meta.position);
+            maxPosition       = glm::max (maxPosition, vertices[triangles[i]].meta.position);
+        }
+        meshletInfo.center    = (minPosition + maxPosition) * 0.5f;
+        meshletInfo.radius    = 0.0f;
+        for (uint32_t i = 0; i < meshletInfo.indicesCount; i++)
+            meshletInfo.radius = std::max (meshletInfo.radius,
+                                           glm::length (vertices[triangles[i]].meta.position - meshletInfo.center));
+
+        glm::vec3 coneAxis    = {0.0f, 0.0f, 0.0f};
+        for (size_t i = 0; i < trianglesCount; i++)
+            coneAxis         += getTriangleNormal (vertices, &triangles[i * 3]);
+
+        float coneAxisLength  = glm::length (coneAxis);
+        meshletInfo.coneAxis  = coneAxisLength > 0.0f ? coneAxis / coneAxisLength: glm::vec3 (0.0f, 0.0f, 1.0f);
+        meshletInfo.coneCutoff = 1.0f;
+        if (coneAxisLength == 0.0f)
+            return;
+        /* Degenerate triangles are never drawn, and so do not widen the cone */
+        float minDot          = 1.0f;
+        for (size_t i = 0; i < trianglesCount; i++) {
+            glm::vec3 normal  = getTriangleNormal (vertices, &triangles[i * 3]);
+            if (normal != glm::vec3 (0.0f))
+                minDot        = std::min (minDot, glm::dot (normal, meshletInfo.coneAxis));
+        }
+        /* Cones wider than (close to) a half space can't be told apart from one facing every way */
+        if (minDot > 0.1f)
+            meshletInfo.coneCutoff = std::sqrt (1.0f - minDot * minDot);
+    }
+
+    /* Idx of the (unique) position of each vertex, returns the number of unique positions */
+    uint32_t getPositionIdxs (const std::vector <Vertex>& vertices, std::vector <uint32_t>& positionIdxs) {
+        std::unordered_map <glm::vec3, uint32_t> positionToIdxMap;
+        positionIdxs.resize (vertices.size());
+        for (size_t i = 0; i < vertices.size(); i++) {
+            auto it         = positionToIdxMap.emplace (vertices[i].meta.position,
+                                                        static_cast <uint32_t> (positionToIdxMap.size())).first;
+            positionIdxs[i] = it->second;
+        }
+        return static_cast <uint32_t> (positionToIdxMap.size());
+    }
+
+    /* Splits the triangles in [firstIndexIdx, firstIndexIdx + indicesCount) into meshlets, rewriting that range of the
+     * indices in meshlet order
+    */
+    void buildMeshlets (const std::vector <Vertex>& vertices,
+                        const std::vector <uint32_t>& positionIdxs,
+                        const uint32_t positionsCount,
+                        std::vector <IndexType>& indices,
+                        const uint32_t firstIndexIdx,
+                        const uint32_t indicesCount,
+                        std::vector <MeshletInfo>& meshletInfos) {
+
+        uint32_t trianglesCount = indicesCount / 3;
+        auto triangles          = indices.data() + firstIndexIdx;
+        if (trianglesCount == 0)
+            return;
+        /* Triangles using each position, laid out one position after the other */
+        std::vector <uint32_t> firstAdjacencyIdxs (positionsCount + 1, 0);
+        std::vector <uint32_t> adjacentTriangleIdxs (trianglesCount * 3);
+        for (uint32_t i = 0; i < trianglesCount * 3; i++)
+            ++firstAdjacencyIdxs[positionIdxs[triangles[i]] + 1];
+        for (size_t i = 1; i < firstAdjacencyIdxs.size(); i++)
+            firstAdjacencyIdxs[i] += firstAdjacencyIdxs[i - 1];
+
+        std::vector <uint32_t> adjacencyFillCounts (positionsCount, 0);
+        std::vector <glm::vec3> triangleNormals    (trianglesCount);
+        std::vector <glm::vec3> triangleCentroids  (trianglesCount);
+        for (uint32_t i = 0; i < trianglesCount; i++) {
+            for (uint32_t j = 0; j < 3; j++) {
+                uint32_t positionIdx = positionIdxs[triangles[i * 3 + j]];
+                adjacentTriangleIdxs[firstAdjacencyIdxs[positionIdx] + adjacencyFillCounts[positionIdx]++] = i;
+            }
+            triangleNormals[i]   = getTriangleNormal (vertices, &triangles[i * 3]);
+            triangleCentroids[i] = (vertices[triangles[i * 3 + 0]].meta.position +
+                                    vertices[triangles[i * 3 + 1]].meta.position +
+                                    vertices[triangles[i * 3 + 2]].meta.position) / 3.0f;
+        }
+        /* A vertex belongs to the meshlet being built if its stamp matches the meshlet's */
+        std::vector <uint32_t> vertexStamps (vertices.size(), 0);
+        std::vector <bool> trianglesTaken   (trianglesCount, false);
+        std::vector <std::vector <uint32_t>> meshletTriangleIdxs;
+        uint32_t seedTriangleIdx = 0;
+
+        while (true) {
+            while (seedTriangleIdx < trianglesCount && trianglesTaken[seedTriangleIdx])
+                ++seedTriangleIdx;
+            if (seedTriangleIdx == trianglesCount)
+                break;
+
+            uint32_t stamp            = static_cast <uint32_t> (meshletTriangleIdxs.size()) + 1;
+            uint32_t verticesCount    = 0;
+            glm::vec3 centroidSum     = {0.0f, 0.0f, 0.0f};
+            glm::vec3 normalSum       = {0.0f, 0.0f, 0.0f};
+            float radius              = 0.0f;
+            std::vector <uint32_t> triangleIdxs;
+            std::vector <uint32_t> candidateTriangleIdxs;
+
+            uint32_t nextTriangleIdx  = seedTriangleIdx;
+            while (nextTriangleIdx != std::numeric_limits <uint32_t>::max()) {
+                trianglesTaken[nextTriangleIdx] = true;
+                triangleIdxs.push_back (nextTriangleIdx);
+                centroidSum          += triangleCentroids[nextTriangleIdx];
+                normalSum            += triangleNormals  [nextTriangleIdx];
+                glm::vec3 centroid    = centroidSum / static_cast <float> (triangleIdxs.size());
+                radius                = std::max (radius, glm::length (triangleCentroids[nextTriangleIdx] - centroid));
+                for (uint32_t j = 0; j < 3; j++) {
+                    IndexType index   = triangles[nextTriangleIdx * 3 + j];
+                    if (vertexStamps[index] == stamp)
+                        continue;
+
+                    vertexStamps[index] = stamp;
+                    ++verticesCount;
+                    uint32_t positionIdx = positionIdxs[index];
+                    for (uint32_t k = firstAdjacencyIdxs[positionIdx]; k < firstAdjacencyIdxs[positionIdx + 1]; k++) {
+                        if (!trianglesTaken[adjacentTriangleIdxs[k]])
+                            candidateTriangleIdxs.push_back (adjacentTriangleIdxs[k]);
+                    }
+                }
+                nextTriangleIdx       = std::numeric_limits <uint32_t>::max();
+                if (triangleIdxs.size() == g_maxMeshletTrianglesCount)
+                    break;
+                /* The score is the number of vertices a triangle adds, plus a fraction (below 1) for how far it is from
+                 * the meshlet and how differently it faces, so that the vertex count always comes first
+                */
+                float normalLength    = glm::length (normalSum);
+                glm::vec3 normal      = normalLength > 0.0f ? normalSum / normalLength: glm::vec3 (0.0f);
+                float bestScore       = std::numeric_limits <float>::max();
+                size_t liveCandidates = 0;
+                for (auto const& triangleIdx: candidateTriangleIdxs) {
+                    if (trianglesTaken[triangleIdx])
+                        continue;
+                    candidateTriangleIdxs[liveCandidates++] = triangleIdx;
+
+                    uint32_t newVerticesCount = 0;
+                    for (uint32_t j = 0; j < 3; j++)
+                        newVerticesCount += vertexStamps[triangles[triangleIdx * 3 + j]] == stamp ? 0: 1;
+                    if (verticesCount + newVerticesCount > g_maxMeshletVerticesCount)
+                        continue;
+
+                    float distance    = glm::length (triangleCentroids[triangleIdx] - centroid);
+                    float coneScore   = (1.0f - glm::dot (triangleNormals[triangleIdx], normal)) * 0.5f;
+                    float score       = static_cast <float> (newVerticesCount) +
+                                        0.5f * g_meshletConeWeight * coneScore +
+                                        0.5f * (1.0f - g_meshletConeWeight) * distance / (distance + radius + 1e-6f);
+                    if (score < bestScore) {
+                        bestScore       = score;
+                        nextTriangleIdx = triangleIdx;
+                    }
+                }
+                candidateTriangleIdxs.resize (liveCandidates);
+            }
+            /* Keep the previous (vertex cache) order within the meshlet */
+            std::sort (triangleIdxs.begin(), triangleIdxs.end());
+            meshletTriangleIdxs.push_back (std::move (triangleIdxs));
+        }
+
+        std::vector <IndexType> meshletIndices;
+        meshletIndices.reserve (indicesCount);
+        for (auto const& triangleIdxs: meshletTriangleIdxs) {
+            MeshletInfo meshletInfo   = {};
+            meshletInfo.firstIndexIdx = firstIndexIdx + static_cast <uint32_t> (meshletIndices.size());
+            meshletInfo.indicesCount  = static_cast <uint32_t> (triangleIdxs.size() * 3);
+            for (auto const& triangleIdx: triangleIdxs)
+                meshletIndices.insert (meshletIndices.end(),
+                                       &triangles[triangleIdx * 3],
+                                       &triangles[triangleIdx * 3 + 3]);
+            meshletInfos.push_back (meshletInfo);
+        }
+        std::copy (meshletIndices.begin(), meshletIndices.end(), indices.begin() + firstIndexIdx);
+    }
+
+    /* Runs after the levels of detail are generated, and builds the meshlets of every level one after the other */
+    void generateMeshlets (const std::vector <Vertex>& vertices,
+                           std::vector <IndexType>& indices,
+                           std::vector <LodInfo>& lodInfos,
+                           std::vector <MeshletInfo>& meshletInfos) {
+
+        std::vector <uint32_t> positionIdxs;
+        uint32_t positionsCount = getPositionIdxs (vertices, positionIdxs);
+        meshletInfos.clear();
+        for (auto& lodInfo: lodInfos) {
+            lodInfo.firstMeshletIdx = static_cast <uint32_t> (meshletInfos.size());
+            buildMeshlets (vertices,
+                           positionIdxs,
+                           positionsCount,
+                           indices,
+                           lodInfo.firstIndexIdx,
+                           lodInfo.indicesCount,
+                           meshletInfos);
+            lodInfo.meshletsCount   = static_cast <uint32_t> (meshletInfos.size()) - lodInfo.firstMeshletIdx;
+        }
+        for (auto& meshletInfo: meshletInfos)
+            updateMeshletBounds (vertices, indices, meshletInfo);
+    }
+}   // namespace SandBox
\ No newline at end of file
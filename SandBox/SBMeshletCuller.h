@@ -0,0 +1,149 @@
+#pragma once
+#include "../Backend/Common.h"
+#include "SBMeshletBuilder.h"
+/* CPU culling of the meshlets (see SBMeshletBuilder) of a mesh instance against a view, which leaves out the meshlets
+ * that are outside the view frustum, or whose triangles all face away from the view (cone culling). It runs on the CPU
+ * rather than in a task/mesh shader, since the renderer has to run on devices without mesh shaders (lavapipe), and the
+ * visible meshlets are drawn as index ranges instead
+ *
+ * The view is brought into the model space of the instance once, so that the meshlet bounds are tested as is. The
+ * bounds are laid out in blocks of 4 meshlets (structure of arrays), so that a block is tested at once using the
+ * compiler's vector extensions, which are lowered to SSE or NEON depending on the target
+*/
+namespace SandBox {
+    typedef float   Float4 __attribute__ ((vector_size (16)));
+    typedef int32_t Int4   __attribute__ ((vector_size (16)));
+    const uint32_t g_meshletBoundsBlockSize = 4;
+
+    struct MeshletBoundsBlock {
+        Float4 centerX;
+        Float4 centerY;
+        Float4 centerZ;
+        Float4 radius;
+        Float4 coneAxisX;
+        Float4 coneAxisY;
+        Float4 coneAxisZ;
+        Float4 coneCutoff;
+    };
+
+    /* Frustum planes (pointing inwards, normalized) and view position/direction, all in model space */
+    struct ViewCullInfo {
+        glm::vec4 planes[6];
+        glm::vec3 viewPosition;
+        glm::vec3 viewDirection;
+        bool orthographic;
+        bool coneCulling;
+    };
+
+    /* Blocks of the meshlets in [firstMeshletIdx, firstMeshletIdx + meshletsCount) are appended to the blocks. The
+     * unused lanes of the last block are never visible
+    */
+    void createMeshletBoundsBlocks (const std::vector <MeshletInfo>& meshletInfos,
+                                    const uint32_t firstMeshletIdx,
+                                    const uint32_t meshletsCount,
+                                    std::vector <MeshletBoundsBlock>& blocks) {
+
+        for (uint32_t i = 0; i < meshletsCount; i += g_meshletBoundsBlockSize) {
+            MeshletBoundsBlock block;
+            for (uint32_t j = 0; j < g_meshletBoundsBlockSize; j++) {
+                if (i + j >= meshletsCount) {
+                    block.centerX[j]    = 0.0f;
+                    block.centerY[j]    = 0.0f;
+                    block.centerZ[j]    = 0.0f;
+                    block.radius[j]     = -std::numeric_limits <float>::max();
+                    block.coneAxisX[j]  = 0.0f;
+                    block.coneAxisY[j]  = 0.0f;
+                    block.coneAxisZ[j]  = 1.0f;
+                    block.coneCutoff[j] = 1.0f;
+                    continue;
+                }
+                auto& meshletInfo   = meshletInfos[firstMeshletIdx + i + j];
+                block.centerX[j]    = meshletInfo.center.x;
+                block.centerY[j]    = meshletInfo.center.y;
+                block.centerZ[j]    = meshletInfo.center.z;
+                block.radius[j]     = meshletInfo.radius;
+                block.coneAxisX[j]  = meshletInfo.coneAxis.x;
+                block.coneAxisY[j]  = meshletInfo.coneAxis.y;
+                block.coneAxisZ[j]  = meshletInfo.coneAxis.z;
+                block.coneCutoff[j] = meshletInfo.coneCutoff;
+            }
+            blocks.push_back (block);
+        }
+    }
+
+    /* The planes are extracted from the rows of the model view projection matrix (Gribb and Hartmann, "Fast
+     * Extraction of Viewing Frustum Planes from the World-View-Projection Matrix"), where the near plane is z >= 0
+     * since the depth range is [0, 1]. Cone culling is turned off for mirrored instances, since their triangles are
+     * wound the other way
+    */
+    ViewCullInfo createViewCullInfo (const glm::mat4& modelMatrix,
+                                     const glm::mat4& viewMatrix,
+                                     const glm::mat4& projectionMatrix,
+                                     const bool coneCulling) {
+        ViewCullInfo viewCullInfo;
+        glm::mat4 matrix       = glm::transpose (projectionMatrix * viewMatrix * modelMatrix);
+        viewCullInfo.planes[0] = matrix[3] + matrix[0];
+        viewCullInfo.planes[1] = matrix[3] - matrix[0];
+        viewCullInfo.planes[2] = matrix[3] + matrix[1];
+        viewCullInfo.planes[3] = matrix[3] - matrix[1];
+        viewCullInfo.planes[4] = matrix[2];
+        viewCullInfo.planes[5] = matrix[3] - matrix[2];
+        for (auto& plane: viewCullInfo.planes) {
+            float length = glm::length (glm::vec3 (plane));
+            plane        = length > 0.0f ? plane / length: plane;
+        }
+
+        glm::mat4 inverseMatrix    = glm::inverse (viewMatrix * modelMatrix);
+        viewCullInfo.viewPosition  = glm::vec3 (inverseMatrix * glm::vec4 (0.0f, 0.0f,  0.0f, 1.0f));
+        viewCullInfo.viewDirection = glm::normalize (glm::vec3 (inverseMatrix * glm::vec4 (0.0f, 0.0f, -1.0f, 0.0f)));
+        viewCullInfo.orthographic  = projectionMatrix[3][3] == 1.0f;
+        viewCullInfo.coneCulling   = coneCulling && glm::determinant (glm::mat3 (modelMatrix)) > 0.0f;
+        return viewCullInfo;
+    }
+
+    bool isSphereVisible (const ViewCullInfo& viewCullInfo, const glm::vec3 center, const float radius) {
+        for (auto const& plane: viewCullInfo.planes) {
+            if (glm::dot (glm::vec3 (plane), center) + plane.w < -radius)
+                return false;
+        }
+        return true;
+    }
+
+    /* Returns the visibility of the meshlets in the block, one bit per meshlet. The cone test is from meshoptimizer
+     * (meshopt_computeClusterBounds), the meshlet is back facing from the view position if
+     * dot (center - position, axis) >= cutoff * length (center - position) + radius, which is squared here to do
+     * without the square root. From an orthographic view, every triangle faces the same direction, so the meshlet is
+     * back facing if dot (direction, axis) > cutoff
+    */
+    uint32_t cullMeshletBoundsBlock (const ViewCullInfo& viewCullInfo, const MeshletBoundsBlock& block) {
+        Int4 visible = {-1, -1, -1, -1};
+        for (auto const& plane: viewCullInfo.planes) {
+            Float4 distance = block.centerX * plane.x + block.centerY * plane.y + block.centerZ * plane.z + plane.w;
+            visible        &= distance >= -block.radius;
+        }
+
+        if (viewCullInfo.coneCulling) {
+            if (viewCullInfo.orthographic) {
+                auto& direction = viewCullInfo.viewDirection;
+                Float4 dot      = block.coneAxisX * direction.x +
+                                  block.coneAxisY * direction.y +
+                                  block.coneAxisZ * direction.z;
+                visible        &= ~(dot > block.coneCutoff);
+            }
+            else {
+                auto& position  = viewCullInfo.viewPosition;
+                Float4 x        = block.centerX - position.x;
+                Float4 y        = block.centerY - position.y;
+                Float4 z        = block.centerZ - position.z;
+                Float4 dot      = x * block.coneAxisX + y * block.coneAxisY + z * block.coneAxisZ - block.radius;
+                Float4 cutoff   = block.coneCutoff * block.coneCutoff * (x * x + y * y + z * z);
+                visible        &= ~((dot >= 0.0f) & (dot * dot > cutoff));
+            }
+        }
+
+        uint32_t mask = 0;
+        for (uint32_t i = 0; i < g_meshletBoundsBlockSize; i++)
+            mask     |= visible[i] != 0 ? 1u << i: 0u;
+        return mask;
+    }
+}   // namespace SandBox
\ No newline at end of file
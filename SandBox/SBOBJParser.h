@@ -0,0 +1,641 @@
+#pragma once
+#include "../Backend/Common.h"
+#include "../Backend/Log/LGImpl.h"
+#include "../Backend/Job/JBPool.h"
+/* In-engine parser for the subset of the OBJ/MTL formats used by the model assets (v, vt, vn, f, usemtl, mtllib and
+ * newmtl, Ns, map_Kd, map_Ks, map_Ke). The model file is mapped instead of read through a stream, and split into
+ * chunks at line boundaries that are parsed in parallel on the job pool. Numbers are parsed in place, 8 digits at a
+ * time (SWAR, see parseEightDigits) with a fall back to strtof for anything unusual (more than 19 significant digits,
+ * large exponents, inf/nan etc.)
+ *
+ * Faces are triangulated the same way tinyobjloader does it, a quad is split along its shorter diagonal, and larger
+ * polygons (not present in the assets) are fanned out from their first corner
+*/
+namespace SandBox {
+    /* Target size of each chunk the model file is split into, smaller files are parsed in one go */
+    const size_t g_objChunkSize = 64 * 1024;
+
+    /* Indices that are absent (a corner without a normal or a texcoord, a face without a material) are set to -1 */
+    struct OBJCornerInfo {
+        int32_t positionIdx;
+        int32_t normalIdx;
+        int32_t texCoordIdx;
+        int32_t materialIdx;
+    };
+
+    struct OBJMaterialInfo {
+        std::string name;
+        std::string diffuseTextureName;
+        std::string specularTextureName;
+        std::string emissionTextureName;
+        float shininess;
+    };
+
+    /* Every 3 indices make up a triangle, and each index refers to a unique corner */
+    struct OBJModelInfo {
+        std::vector <glm::vec3> positions;
+        std::vector <glm::vec3> normals;
+        std::vector <glm::vec2> texCoords;
+        std::vector <OBJCornerInfo> corners;
+        std::vector <uint32_t> indices;
+        std::vector <OBJMaterialInfo> materials;
+        /* Every mtl file looked up (found or not), in order. The import depends on these along with the model file */
+        std::vector <std::string> mtlFilePaths;
+    };
+
+    class SBOBJParser {
+        private:
+            /* Faces keep their corners (position, texcoord and normal indices, in file order) until every chunk is
+             * parsed, since a quad may need positions from another chunk to be triangulated. Relative (negative)
+             * indices are resolved against the counts within the chunk, and offset by the counts of the preceding
+             * chunks once they are known
+            */
+            struct ChunkInfo {
+                std::vector <glm::vec3> positions;
+                std::vector <glm::vec3> normals;
+                std::vector <glm::vec2> texCoords;
+                std::vector <std::array <int32_t, 3>> corners;
+                std::vector <uint32_t> faceCornersCounts;
+                /* Corner idx and attribute (0 = position, 1 = texcoord, 2 = normal) of every relative index */
+                std::vector <std::pair <uint32_t, uint32_t>> relativeIdxs;
+                /* Face idx (within the chunk) from which each material is used */
+                std::vector <std::pair <uint32_t, std::string>> materialSwitches;
+                /* Candidate file names of each mtllib statement, the first one found is loaded */
+                std::vector <std::vector <std::string>> mtlFileNames;
+            };
+
+            struct OBJParserInfo {
+                struct Resource {
+                    Log::LGImpl* logObj;
+                    Job::JBPool* jobPoolObj;
+                } resource;
+            } m_objParserInfo;
+
+            bool isSpace (const char value) {
+                return value == ' ' || value == '\t' || value == '\r';
+            }
+
+            bool isDigit (const char value) {
+                return static_cast <uint8_t> (value - '0') < 10;
+            }
+
+            const char* skipSpaces (const char* ptr, const char* end) {
+                while (ptr < end && isSpace (*ptr))
+                    ++ptr;
+                return ptr;
+            }
+
+            const char* skipToken (const char* ptr, const char* end) {
+                while (ptr < end && !isSpace (*ptr))
+                    ++ptr;
+                return ptr;
+            }
+
+            /* Lines are found with memchr, which is vectorized by the c library */
+            const char* getLineEnd (const char* ptr, const char* end) {
+                auto lineEnd = static_cast <const char*> (std::memchr (ptr, '\n', static_cast <size_t> (end - ptr)));
+                return lineEnd == nullptr ? end: lineEnd;
+            }
+
+            /* Whether ptr begins with the keyword, followed by a space */
+            bool isKeyword (const char* ptr, const char* end, const char* keyword) {
+                size_t keywordSize = std::strlen (keyword);
+                return static_cast <size_t> (end - ptr) > keywordSize        &&
+                       std::memcmp (ptr, keyword, keywordSize) == 0          &&
+                       isSpace (ptr[keywordSize]);
+            }
+
+            std::string getToken (const char* ptr, const char* end) {
+                ptr = skipSpaces (ptr, end);
+                return std::string (ptr, skipToken (ptr, end));
+            }
+
+            /* Rest of the line without the surrounding spaces, texture names may contain spaces */
+            std::string getTrimmedLine (const char* ptr, const char* end) {
+                ptr = skipSpaces (ptr, end);
+                while (end > ptr && isSpace (end[-1]))
+                    --end;
+                return std::string (ptr, end);
+            }
+
+            /* The 8 bytes (loaded little endian) are all ascii digits if the high nibbles are 3, and adding 6 to each
+             * byte doesn't carry into the high nibble
+            */
+            bool isEightDigits (const uint64_t value) {
+                return ((value & 0xF0F0F0F0F0F0F0F0ull) |
+                       (((value + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) == 0x3333333333333333ull;
+            }
+
+            /* Combine adjacent digits pairwise (2 digits per 16 bits, then 4 digits per 32 bits, then all 8) with one
+             * multiply per step, instead of 8 dependent multiply-adds
+            */
+            uint32_t parseEightDigits (uint64_t value) {
+                value = ((value & 0x0F0F0F0F0F0F0F0Full) * 2561)           >> 8;
+                value = ((value & 0x00FF00FF00FF00FFull) * 6553601)        >> 16;
+                return static_cast <uint32_t> (((value & 0x0000FFFF0000FFFFull) * 42949672960001ull) >> 32);
+            }
+
+            const char* parseDigits (const char* ptr, const char* end, uint64_t& mantissa, uint32_t& digitsCount) {
+                uint64_t value;
+                while (end - ptr >= 8) {
+                    std::memcpy (&value, ptr, 8);
+                    if (!isEightDigits (value))
+                        break;
+                    mantissa     = mantissa * 100000000 + parseEightDigits (value);
+                    ptr         += 8;
+                    digitsCount += 8;
+                }
+                while (ptr < end && isDigit (*ptr)) {
+                    mantissa     = mantissa * 10 + static_cast <uint64_t> (*ptr - '0');
+                    ++ptr;
+                    ++digitsCount;
+                }
+                return ptr;
+            }
+
+            /* A mantissa of up to 19 digits (exact in a double up to 2^53) scaled by an exact power of 10 is correctly
+             * rounded, everything else goes through strtof. Missing values are left as 0
+            */
+            const char* parseFloat (const char* ptr, const char* end, float& value) {
+                static const double powersOf10[] = {
+                    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+                };
+                ptr                  = skipSpaces (ptr, end);
+                const char* begin    = ptr;
+                bool negative        = false;
+                uint64_t mantissa    = 0;
+                uint32_t digitsCount = 0;
+                int32_t exponent     = 0;
+
+                if (ptr < end && (*ptr == '-' || *ptr == '+')) {
+                    negative = *ptr == '-';
+                    ++ptr;
+                }
+                ptr = parseDigits (ptr, end, mantissa, digitsCount);
+                if (ptr < end && *ptr == '.') {
+                    const char* fractionBegin = ++ptr;
+                    ptr       = parseDigits (ptr, end, mantissa, digitsCount);
+                    exponent -= static_cast <int32_t> (ptr - fractionBegin);
+                }
+                if (digitsCount > 0 && ptr < end && (*ptr == 'e' || *ptr == 'E')) {
+                    const char* exponentBegin  = ptr + 1;
+                    bool exponentNegative      = exponentBegin < end && *exponentBegin == '-';
+                    if (exponentBegin < end && (*exponentBegin == '-' || *exponentBegin == '+'))
+                        ++exponentBegin;
+
+                    int32_t exponentValue      = 0;
+                    const char* exponentEnd    = exponentBegin;
+                    while (exponentEnd < end && isDigit (*exponentEnd) && exponentValue < 10000)
+                        exponentValue = exponentValue * 10 + (*exponentEnd++ - '0');
+                    /* An 'e' without digits is not part of the number */
+                    if (exponentEnd > exponentBegin) {
+                        exponent += exponentNegative ? -exponentValue: exponentValue;
+                        ptr       = exponentEnd;
+                    }
+                }
+
+                bool fastPathValid = digitsCount > 0 && digitsCount <= 19  &&
+                                     mantissa <= (1ull << 53)              &&
+                                     exponent >= -22 && exponent <= 22     &&
+                                     (ptr == end || isSpace (*ptr));
+                if (fastPathValid) {
+                    double result = static_cast <double> (mantissa);
+                    result        = exponent < 0 ? result / powersOf10[-exponent]: result * powersOf10[exponent];
+                    value         = static_cast <float> (negative ? -result: result);
+                    return ptr;
+                }
+
+                const char* tokenEnd = skipToken (begin, end);
+                char buffer[64]      = {};
+                std::memcpy (buffer, begin, std::min (static_cast <size_t> (tokenEnd - begin), sizeof (buffer) - 1));
+                value                = std::strtof (buffer, nullptr);
+                return tokenEnd;
+            }
+
+            const char* parseInt (const char* ptr, const char* end, int32_t& value, bool& valueFound) {
+                bool negative    = ptr < end && *ptr == '-';
+                if (ptr < end && (*ptr == '-' || *ptr == '+'))
+                    ++ptr;
+
+                int64_t result   = 0;
+                valueFound       = ptr < end && isDigit (*ptr);
+                while (ptr < end && isDigit (*ptr)) {
+                    result = std::min (result * 10 + (*ptr - '0'), static_cast <int64_t> (INT32_MAX));
+                    ++ptr;
+                }
+                value            = static_cast <int32_t> (negative ? -result: result);
+                return ptr;
+            }
+
+            /* Corners are given as v, v/vt, v//vn or v/vt/vn */
+            const char* parseCorner (const char* ptr, const char* end, ChunkInfo& chunkInfo) {
+                std::array <int32_t, 3> idxs = {-1, -1, -1};
+                size_t attributesCounts[3]   = {
+                    chunkInfo.positions.size(),
+                    chunkInfo.texCoords.size(),
+                    chunkInfo.normals.size()
+                };
+                auto cornerIdx               = static_cast <uint32_t> (chunkInfo.corners.size());
+
+                for (uint32_t attributeIdx = 0; attributeIdx < 3; attributeIdx++) {
+                    int32_t value;
+                    bool valueFound;
+                    ptr = parseInt (ptr, end, value, valueFound);
+                    if (valueFound) {
+                        if (value == 0) {
+                            LOG_ERROR (m_objParserInfo.resource.logObj) << "Invalid face index"
+                                                                        << std::endl;
+                            throw std::runtime_error ("Invalid face index");
+                        }
+                        if (value < 0) {
+                            idxs[attributeIdx] = static_cast <int32_t> (attributesCounts[attributeIdx]) + value;
+                            chunkInfo.relativeIdxs.push_back ({cornerIdx, attributeIdx});
+                        }
+                        else
+                            idxs[attributeIdx] = value - 1;
+                    }
+                    if (ptr == end || *ptr != '/')
+                        break;
+                    ++ptr;
+                }
+                chunkInfo.corners.push_back (idxs);
+                return skipToken (ptr, end);
+            }
+
+            void parseChunk (const char* ptr, const char* end, ChunkInfo& chunkInfo) {
+                while (ptr < end) {
+                    const char* lineEnd = getLineEnd (ptr, end);
+                    ptr                 = skipSpaces (ptr, lineEnd);
+
+                    if (isKeyword (ptr, lineEnd, "v")) {
+                        glm::vec3 position = {0.0f, 0.0f, 0.0f};
+                        ptr = parseFloat (ptr + 1, lineEnd, position.x);
+                        ptr = parseFloat (ptr,     lineEnd, position.y);
+                        ptr = parseFloat (ptr,     lineEnd, position.z);
+                        chunkInfo.positions.push_back (position);
+                    }
+                    else if (isKeyword (ptr, lineEnd, "vn")) {
+                        glm::vec3 normal   = {0.0f, 0.0f, 0.0f};
+                        ptr = parseFloat (ptr + 2, lineEnd, normal.x);
+                        ptr = parseFloat (ptr,     lineEnd, normal.y);
+                        ptr = parseFloat (ptr,     lineEnd, normal.z);
+                        chunkInfo.normals.push_back (normal);
+                    }
+                    else if (isKeyword (ptr, lineEnd, "vt")) {
+                        glm::vec2 texCoord = {0.0f, 0.0f};
+                        ptr = parseFloat (ptr + 2, lineEnd, texCoord.x);
+                        ptr = parseFloat (ptr,     lineEnd, texCoord.y);
+                        chunkInfo.texCoords.push_back (texCoord);
+                    }
+                    else if (isKeyword (ptr, lineEnd, "f")) {
+                        size_t cornersCount = chunkInfo.corners.size();
+                        ptr                 = skipSpaces (ptr + 1, lineEnd);
+                        while (ptr < lineEnd) {
+                            ptr = parseCorner (ptr, lineEnd, chunkInfo);
+                            ptr = skipSpaces  (ptr, lineEnd);
+                        }
+                        cornersCount        = chunkInfo.corners.size() - cornersCount;
+                        /* Points and lines are not part of the mesh */
+                        if (cornersCount < 3) {
+                            chunkInfo.corners.resize (chunkInfo.corners.size() - cornersCount);
+                            while (!chunkInfo.relativeIdxs.empty() &&
+                                    chunkInfo.relativeIdxs.back().first >= chunkInfo.corners.size())
+                                chunkInfo.relativeIdxs.pop_back();
+                        }
+                        else
+                            chunkInfo.faceCornersCounts.push_back (static_cast <uint32_t> (cornersCount));
+                    }
+                    else if (isKeyword (ptr, lineEnd, "usemtl")) {
+                        chunkInfo.materialSwitches.push_back ({
+                            static_cast <uint32_t> (chunkInfo.faceCornersCounts.size()),
+                            getToken (ptr + 6, lineEnd)
+                        });
+                    }
+                    else if (isKeyword (ptr, lineEnd, "mtllib")) {
+                        std::vector <std::string> mtlFileNames;
+                        ptr = skipSpaces (ptr + 6, lineEnd);
+                        while (ptr < lineEnd) {
+                            const char* tokenEnd = skipToken (ptr, lineEnd);
+                            mtlFileNames.push_back (std::string (ptr, tokenEnd));
+                            ptr = skipSpaces (tokenEnd, lineEnd);
+                        }
+                        chunkInfo.mtlFileNames.push_back (mtlFileNames);
+                    }
+                    /* Comments, objects, groups, smoothing groups etc. are skipped */
+                    ptr = lineEnd + 1;
+                }
+            }
+
+            /* The mapping stays valid after the file is closed. An empty file is mapped to nullptr */
+            bool mapFile (const std::string filePath, const char*& mappedData, size_t& mappedSize) {
+                int fileDescriptor = open (filePath.c_str(), O_RDONLY);
+                if (fileDescriptor == -1)
+                    return false;
+
+                struct stat fileStat;
+                bool fileMapped    = fstat (fileDescriptor, &fileStat) == 0;
+                mappedData         = nullptr;
+                mappedSize         = fileMapped ? static_cast <size_t> (fileStat.st_size): 0;
+                if (mappedSize > 0) {
+                    void* data     = mmap (nullptr, mappedSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+                    fileMapped     = data != MAP_FAILED;
+                    mappedData     = fileMapped ? static_cast <const char*> (data): nullptr;
+                }
+                close (fileDescriptor);
+                return fileMapped;
+            }
+
+            void parseMtlFile (const char* ptr, const char* end, std::vector <OBJMaterialInfo>& materials) {
+                while (ptr < end) {
+                    const char* lineEnd = getLineEnd (ptr, end);
+                    ptr                 = skipSpaces (ptr, lineEnd);
+
+                    if (isKeyword (ptr, lineEnd, "newmtl"))
+                        materials.push_back ({getToken (ptr + 6, lineEnd), "", "", "", 1.0f});
+                    else if (!materials.empty()) {
+                        auto& material = materials.back();
+                        if      (isKeyword (ptr, lineEnd, "Ns"))
+                            parseFloat (ptr + 2, lineEnd, material.shininess);
+                        else if (isKeyword (ptr, lineEnd, "map_Kd"))
+                            material.diffuseTextureName  = getTrimmedLine (ptr + 6, lineEnd);
+                        else if (isKeyword (ptr, lineEnd, "map_Ks"))
+                            material.specularTextureName = getTrimmedLine (ptr + 6, lineEnd);
+                        else if (isKeyword (ptr, lineEnd, "map_Ke"))
+                            material.emissionTextureName = getTrimmedLine (ptr + 6, lineEnd);
+                    }
+                    ptr = lineEnd + 1;
+                }
+            }
+
+            /* Load the first mtl file found among the candidates of each mtllib statement, a missing mtl file is not
+             * an error (faces that use its materials fall back to no material)
+            */
+            void populateMaterials (const std::string modelFilePath,
+                                    const std::string mtlFileDirPath,
+                                    const std::vector <ChunkInfo>& chunkInfos,
+                                    std::vector <OBJMaterialInfo>& materials,
+                                    std::vector <std::string>& mtlFilePaths) {
+
+                std::string dirPath = mtlFileDirPath;
+                if (dirPath.empty() && modelFilePath.find_last_of ('/') != std::string::npos)
+                    dirPath = modelFilePath.substr (0, modelFilePath.find_last_of ('/') + 1);
+                if (!dirPath.empty() && dirPath.back() != '/')
+                    dirPath += '/';
+
+                for (auto const& chunkInfo: chunkInfos) {
+                    for (auto const& mtlFileNames: chunkInfo.mtlFileNames) {
+                        bool mtlFileFound = false;
+                        for (auto const& mtlFileName: mtlFileNames) {
+                            const char* mappedData;
+                            size_t mappedSize;
+                            mtlFilePaths.push_back (dirPath + mtlFileName);
+                            if (!mapFile (dirPath + mtlFileName, mappedData, mappedSize))
+                                continue;
+
+                            parseMtlFile (mappedData, mappedData + mappedSize, materials);
+                            if (mappedData != nullptr)
+                                munmap (const_cast <char*> (mappedData), mappedSize);
+                            mtlFileFound = true;
+                            break;
+                        }
+                        if (!mtlFileFound) {
+                            LOG_WARNING (m_objParserInfo.resource.logObj) << "Failed to find mtl file"
+                                                                          << " "
+                                                                          << "[" << modelFilePath << "]"
+                                                                          << std::endl;
+                        }
+                    }
+                }
+            }
+
+            /* Open addressing (linear probing) table over the corner indices, the key is the 16 byte index tuple
+             * instead of the resulting vertex
+            */
+            uint32_t getCornerIdx (const OBJCornerInfo& cornerInfo,
+                                   std::vector <uint32_t>& slots,
+                                   std::vector <OBJCornerInfo>& corners) {
+
+                uint64_t hash = static_cast <uint64_t> (static_cast <uint32_t> (cornerInfo.positionIdx)) *
+                                0x9E3779B97F4A7C15ull;
+                hash         ^= static_cast <uint64_t> (static_cast <uint32_t> (cornerInfo.normalIdx))   *
+                                0xC2B2AE3D27D4EB4Full;
+                hash         ^= static_cast <uint64_t> (static_cast <uint32_t> (cornerInfo.texCoordIdx)) *
+                                0x165667B19E3779F9ull;
+                hash         ^= static_cast <uint64_t> (static_cast <uint32_t> (cornerInfo.materialIdx)) *
+                                0x27D4EB2F165667C5ull;
+                hash         ^= hash >> 32;
+
+                size_t mask   = slots.size() - 1;
+                size_t slot   = static_cast <size_t> (hash) & mask;
+                while (slots[slot] != std::numeric_limits <uint32_t>::max()) {
+                    auto& other = corners[slots[slot]];
+                    if (other.positionIdx == cornerInfo.positionIdx && other.normalIdx   == cornerInfo.normalIdx &&
+                        other.texCoordIdx == cornerInfo.texCoordIdx && other.materialIdx == cornerInfo.materialIdx)
+                        return slots[slot];
+                    slot = (slot + 1) & mask;
+                }
+                slots[slot] = static_cast <uint32_t> (corners.size());
+                corners.push_back (cornerInfo);
+                return slots[slot];
+            }
+
+            /* Triangulate the faces of every chunk in file order, and deduplicate their corners */
+            void populateIndices (const std::string modelFilePath,
+                                  std::vector <ChunkInfo>& chunkInfos,
+                                  OBJModelInfo& modelInfo) {
+
+                auto& logObj                   = m_objParserInfo.resource.logObj;
+                std::unordered_map <std::string, int32_t> materialNameToIdxMap;
+                for (size_t i = 0; i < modelInfo.materials.size(); i++)
+                    materialNameToIdxMap.try_emplace (modelInfo.materials[i].name, static_cast <int32_t> (i));
+
+                size_t cornersCount            = 0;
+                for (auto const& chunkInfo: chunkInfos)
+                    cornersCount += chunkInfo.corners.size();
+                size_t slotsCount              = 16;
+                while (slotsCount < cornersCount * 2)
+                    slotsCount *= 2;
+                std::vector <uint32_t> slots (slotsCount, std::numeric_limits <uint32_t>::max());
+                modelInfo.corners.reserve (cornersCount);
+                modelInfo.indices.reserve (cornersCount * 3 / 2);
+
+                int64_t attributesCounts[3]    = {
+                    static_cast <int64_t> (modelInfo.positions.size()),
+                    static_cast <int64_t> (modelInfo.texCoords.size()),
+                    static_cast <int64_t> (modelInfo.normals.size())
+                };
+                int64_t attributeOffsets[3]    = {0, 0, 0};
+                int32_t materialIdx            = -1;
+
+                for (auto& chunkInfo: chunkInfos) {
+                    for (auto const& [cornerIdx, attributeIdx]: chunkInfo.relativeIdxs)
+                        chunkInfo.corners[cornerIdx][attributeIdx] += static_cast <int32_t> (
+                            attributeOffsets[attributeIdx]
+                        );
+
+                    size_t cornerOffset        = 0;
+                    size_t switchIdx           = 0;
+                    for (size_t faceIdx = 0; faceIdx < chunkInfo.faceCornersCounts.size(); faceIdx++) {
+                        while (switchIdx < chunkInfo.materialSwitches.size() &&
+                               chunkInfo.materialSwitches[switchIdx].first == faceIdx) {
+                            auto& materialName = chunkInfo.materialSwitches[switchIdx].second;
+                            auto it            = materialNameToIdxMap.find (materialName);
+                            materialIdx        = it != materialNameToIdxMap.end() ? it->second: -1;
+                            if (materialIdx == -1) {
+                                LOG_WARNING (logObj) << "Failed to find material"
+                                                     << " "
+                                                     << "[" << materialName  << "]"
+                                                     << " "
+                                                     << "[" << modelFilePath << "]"
+                                                     << std::endl;
+                            }
+                            ++switchIdx;
+                        }
+
+                        auto faceCorners          = &chunkInfo.corners[cornerOffset];
+                        uint32_t faceCornersCount = chunkInfo.faceCornersCounts[faceIdx];
+                        cornerOffset             += faceCornersCount;
+                        for (uint32_t i = 0; i < faceCornersCount; i++) {
+                            for (uint32_t attributeIdx = 0; attributeIdx < 3; attributeIdx++) {
+                                int32_t idx    = faceCorners[i][attributeIdx];
+                                bool idxValid  = idx < attributesCounts[attributeIdx] &&
+                                                 (idx >= 0 || (idx == -1 && attributeIdx != 0));
+                                if (!idxValid) {
+                                    LOG_ERROR (logObj) << "Invalid face index"
+                                                       << " "
+                                                       << "[" << modelFilePath << "]"
+                                                       << std::endl;
+                                    throw std::runtime_error ("Invalid face index");
+                                }
+                            }
+                        }
+
+                        auto addCorner = [&](const uint32_t i) {
+                            OBJCornerInfo cornerInfo = {
+                                faceCorners[i][0],
+                                faceCorners[i][2],
+                                faceCorners[i][1],
+                                materialIdx
+                            };
+                            modelInfo.indices.push_back (getCornerIdx (cornerInfo, slots, modelInfo.corners));
+                        };
+                        auto addTriangle = [&](const uint32_t i0, const uint32_t i1, const uint32_t i2) {
+                            addCorner (i0);
+                            addCorner (i1);
+                            addCorner (i2);
+                        };
+
+                        if (faceCornersCount == 4) {
+                            auto& positions      = modelInfo.positions;
+                            glm::vec3 diagonal02 = positions[faceCorners[2][0]] - positions[faceCorners[0][0]];
+                            glm::vec3 diagonal13 = positions[faceCorners[3][0]] - positions[faceCorners[1][0]];
+                            if (glm::dot (diagonal02, diagonal02) < glm::dot (diagonal13, diagonal13)) {
+                                addTriangle (0, 1, 2);
+                                addTriangle (0, 2, 3);
+                            }
+                            else {
+                                addTriangle (0, 1, 3);
+                                addTriangle (1, 2, 3);
+                            }
+                        }
+                        else {
+                            for (uint32_t i = 1; i + 1 < faceCornersCount; i++)
+                                addTriangle (0, i, i + 1);
+                        }
+                    }
+                    attributeOffsets[0] += static_cast <int64_t> (chunkInfo.positions.size());
+                    attributeOffsets[1] += static_cast <int64_t> (chunkInfo.texCoords.size());
+                    attributeOffsets[2] += static_cast <int64_t> (chunkInfo.normals.size());
+                }
+            }
+
+        public:
+            SBOBJParser (void) {
+                m_objParserInfo = {};
+
+                auto& logObj = m_objParserInfo.resource.logObj;
+                logObj       = new Log::LGImpl();
+                logObj->initLogInfo     ("Build/Log/SandBox",     __FILE__);
+                logObj->updateLogConfig (Log::LEVEL_TYPE_INFO,    Log::SINK_TYPE_FILE);
+                logObj->updateLogConfig (Log::LEVEL_TYPE_WARNING, Log::SINK_TYPE_CONSOLE | Log::SINK_TYPE_FILE);
+                logObj->updateLogConfig (Log::LEVEL_TYPE_ERROR,   Log::SINK_TYPE_CONSOLE | Log::SINK_TYPE_FILE);
+            }
+
+            void initOBJParserInfo (Job::JBPool* jobPoolObj) {
+                auto& resource      = m_objParserInfo.resource;
+                if (jobPoolObj == nullptr) {
+                    LOG_ERROR (resource.logObj) << NULL_DEPOBJ_MSG
+                                                << std::endl;
+                    throw std::runtime_error (NULL_DEPOBJ_MSG);
+                }
+                resource.jobPoolObj = jobPoolObj;
+            }
+
+            /* Safe to call from multiple threads (and from within a job) at once. An empty mtl file dir path looks up
+             * mtl files next to the model file
+            */
+            void importModel (const std::string modelFilePath,
+                              const std::string mtlFileDirPath,
+                              OBJModelInfo& modelInfo) {
+
+                auto& resource = m_objParserInfo.resource;
+                const char* mappedData;
+                size_t mappedSize;
+                if (!mapFile (modelFilePath, mappedData, mappedSize)) {
+                    LOG_ERROR (resource.logObj) << "Failed to open model file"
+                                                << " "
+                                                << "[" << modelFilePath << "]"
+                                                << std::endl;
+                    throw std::runtime_error ("Failed to open model file");
+                }
+
+                modelInfo        = {};
+                auto chunksCount = static_cast <uint32_t> (std::max (mappedSize / g_objChunkSize,
+                                                                     static_cast <size_t> (1)));
+                std::vector <ChunkInfo> chunkInfos (chunksCount);
+                /* Chunks begin right after a line break, so that no line is split across chunks */
+                std::vector <const char*> chunkBegins (chunksCount + 1, mappedData + mappedSize);
+                for (uint32_t i = 0; i < chunksCount; i++) {
+                    const char* ptr = mappedData + mappedSize / chunksCount * i;
+                    if (i > 0) {
+                        ptr = getLineEnd (std::max (ptr, chunkBegins[i - 1]), mappedData + mappedSize);
+                        ptr = ptr == mappedData + mappedSize ? ptr: ptr + 1;
+                    }
+                    chunkBegins[i]  = ptr;
+                }
+
+                try {
+                    resource.jobPoolObj->runParallelJobs (chunksCount, [&](uint32_t chunkIdx) {
+                        parseChunk (chunkBegins[chunkIdx], chunkBegins[chunkIdx + 1], chunkInfos[chunkIdx]);
+                    });
+                }
+                catch (...) {
+                    if (mappedData != nullptr)
+                        munmap (const_cast <char*> (mappedData), mappedSize);
+                    throw;
+                }
+                if (mappedData != nullptr)
+                    munmap (const_cast <char*> (mappedData), mappedSize);
+
+                for (auto& chunkInfo: chunkInfos) {
+                    modelInfo.positions.insert (modelInfo.positions.end(), chunkInfo.positions.begin(),
+                                                                           chunkInfo.positions.end());
+                    modelInfo.normals.insert   (modelInfo.normals.end(),   chunkInfo.normals.begin(),
+                                                                           chunkInfo.normals.end());
+                    modelInfo.texCoords.insert (modelInfo.texCoords.end(), chunkInfo.texCoords.begin(),
+                                                                           chunkInfo.texCoords.end());
+                }
+                populateMaterials (modelFilePath,
+                                   mtlFileDirPath,
+                                   chunkInfos,
+                                   modelInfo.materials,
+                                   modelInfo.mtlFilePaths);
+                populateIndices   (modelFilePath, chunkInfos, modelInfo);
+            }
+
+            ~SBOBJParser (void) {
+                delete m_objParserInfo.resource.logObj;
+            }
+    };
+}   // namespace SandBox
\ No newline at end of file
@@ -3,10 +3,30 @@
 
 namespace SandBox {
     /* Note that, it is possible to use either uint16_t or uint32_t for your index buffer depending on the number of
-     * vertices. Additionally, you have to specify the correct type when binding the index buffer
+     * vertices. Additionally, you have to specify the correct type when binding the index buffer. Meshes are imported
+     * with 32 bit indices, and std meshes with few enough vertices are uploaded with 16 bit indices (see
+     * SYMeshBatching)
     */
     using IndexType                    = uint32_t;
+    using NarrowIndexType              = uint16_t;
     const uint32_t g_maxFramesInFlight = 2;
+    /* Levels of detail per mesh, including the full resolution level */
+    const uint32_t g_maxLodsCount      = 4;
+
+    /* One entry of the material table (see SBMeshPool), which is uploaded as is and indexed by the material idx of
+     * the vertices in the shaders
+    */
+    struct Material {
+        uint32_t diffuseTextureIdx;
+        uint32_t specularTextureIdx;
+        uint32_t emissionTextureIdx;
+        /* Shininess impacts the scattering/radius of the specular highlight. The table in the following link shows a
+         * list of material properties that simulate real materials found in the outside world. Note that, the higher
+         * the shininess value, the more it properly reflects the light instead of scattering it all around and thus
+         * the smaller the highlight becomes http://devernay.free.fr/cours/opengl/materials.html
+        */
+        uint32_t shininess;
+    };
 
     struct Vertex {
         struct Meta {
@@ -14,30 +34,49 @@ namespace SandBox {
             glm::vec3 normal;
             glm::vec3 position;
         } meta;
-
-        struct Material {
-            uint32_t diffuseTextureIdx;
-            uint32_t specularTextureIdx;
-            uint32_t emissionTextureIdx;
-            /* Shininess impacts the scattering/radius of the specular highlight. The table in the following link shows a
-             * list of material properties that simulate real materials found in the outside world. Note that, the higher
-             * the shininess value, the more it properly reflects the light instead of scattering it all around and thus
-             * the smaller the highlight becomes http://devernay.free.fr/cours/opengl/materials.html
-            */
-            uint32_t shininess;
-        } material;
+        /* Idx into the materials of the mesh (not the material table), so that imported vertices do not depend on the
+         * order in which meshes are added
+        */
+        uint32_t materialIdx;
 
         bool operator == (const Vertex& other) const {
-            return meta.uv                     == other.meta.uv                     &&
-                   meta.normal                 == other.meta.normal                 &&
-                   meta.position               == other.meta.position               &&
-                   material.diffuseTextureIdx  == other.material.diffuseTextureIdx  &&
-                   material.specularTextureIdx == other.material.specularTextureIdx &&
-                   material.emissionTextureIdx == other.material.emissionTextureIdx &&
-                   material.shininess          == other.material.shininess;
+            return meta.uv       == other.meta.uv       &&
+                   meta.normal   == other.meta.normal   &&
+                   meta.position == other.meta.position &&
+                   materialIdx   == other.materialIdx;
         }
     };
 
+    /* Compressed layout (16 bytes, half of the vertex above) that std meshes are uploaded in, see SBVertexCodec.
+     * Texture coordinates are half floats, normals are octahedral encoded and positions are quantized over the bounds
+     * of the mesh (the dequantization is folded into the instance model matrix). The material idx is into the material
+     * table, and is read as the (unused) w component of the position as well, since 3 component 16 bit formats are
+     * rarely supported for vertex buffers
+    */
+    struct PackedVertex {
+        struct Meta {
+            uint16_t uv[2];                 /* VK_FORMAT_R16G16_SFLOAT */
+            int16_t  normal[2];             /* VK_FORMAT_R16G16_SNORM */
+            uint16_t position[3];           /* VK_FORMAT_R16G16B16A16_UNORM */
+        } meta;
+        uint16_t materialIdx;               /* VK_FORMAT_R16_UINT */
+    };
+
+    /* Position only stream (8 bytes) of the packed vertices above, for the depth only passes. It is batched alongside
+     * the packed vertices, and so shares their vertex offsets and indices
+    */
+    struct PackedPosition {
+        uint16_t position[4];               /* VK_FORMAT_R16G16B16A16_UNORM, w is unused */
+    };
+
+    /* Range of indices that is drawn, relative to the first index idx of a render component. The visible meshlets of a
+     * mesh instance are drawn as a list of these (see SYStdMeshInstanceBatching)
+    */
+    struct IndexRangeInfo {
+        uint32_t firstIndexIdx;
+        uint32_t indicesCount;
+    };
+
     /* Alignment rules
      * - Scalars must be aligned by  N (= 4  bytes given 32 bit floats)
      * - Vec3    must be aligned by 4N (= 16 bytes)
@@ -83,19 +122,13 @@ namespace std {
             size_t h1   = hash <glm::vec2>() (vertex.meta.uv);
             size_t h2   = hash <glm::vec3>() (vertex.meta.normal);
             size_t h3   = hash <glm::vec3>() (vertex.meta.position);
-            size_t h4   = hash <uint32_t> () (vertex.material.diffuseTextureIdx);
-            size_t h5   = hash <uint32_t> () (vertex.material.specularTextureIdx);
-            size_t h6   = hash <uint32_t> () (vertex.material.emissionTextureIdx);
-            size_t h7   = hash <uint32_t> () (vertex.material.shininess);
+            size_t h4   = hash <uint32_t> () (vertex.materialIdx);
 
             size_t hash = 17;
             hash        = hash * 31 + h1;
             hash        = hash * 31 + h2;
             hash        = hash * 31 + h3;
             hash        = hash * 31 + h4;
-            hash        = hash * 31 + h5;
-            hash        = hash * 31 + h6;
-            hash        = hash * 31 + h7;
             return hash;
         }
     };
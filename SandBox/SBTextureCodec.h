@@ -0,0 +1,278 @@
+#pragma once
+#include "../Backend/Common.h"
+/* CPU encoder/decoder for the block compressed formats used by the texture pool. Every block covers 4x4 texels, and
+ * texels outside the image (for dimensions that are not a multiple of 4) are filled by repeating the edge texels
+ *
+ *  BC1     8 bytes per block, two RGB565 end points and a 2 bit index per texel that picks one of 4 colors on the line
+ *          between the end points
+ *  BC3     16 bytes per block, an alpha block (two 8 bit end points and a 3 bit index per texel that picks one of 8
+ *          values) followed by a BC1 color block
+ *
+ * End points are encoded as is (sRGB), which is what the hardware interpolates between for the _SRGB_BLOCK formats
+*/
+namespace SandBox {
+    bool isBlockCompressedFormat (const VkFormat format) {
+        return format == VK_FORMAT_BC1_RGB_SRGB_BLOCK || format == VK_FORMAT_BC3_SRGB_BLOCK;
+    }
+
+    size_t getImageSize (const VkFormat format, const int width, const int height) {
+        if (!isBlockCompressedFormat (format))
+            return static_cast <size_t> (width) * static_cast <size_t> (height) * 4;
+
+        size_t blocksCount = static_cast <size_t> ((width  + 3) / 4) *
+                             static_cast <size_t> ((height + 3) / 4);
+        return blocksCount * (format == VK_FORMAT_BC1_RGB_SRGB_BLOCK ? 8: 16);
+    }
+
+    uint16_t getRGB565 (const float r, const float g, const float b) {
+        auto quantize = [](const float value, const float maxValue) {
+            return static_cast <uint16_t> (std::clamp (value * maxValue / 255.0f + 0.5f, 0.0f, maxValue));
+        };
+        return static_cast <uint16_t> ((quantize (r, 31.0f) << 11) | (quantize (g, 63.0f) << 5) | quantize (b, 31.0f));
+    }
+
+    void getRGB888 (const uint16_t color, uint8_t* rgb) {
+        uint8_t r = (color >> 11) & 0x1F;
+        uint8_t g = (color >> 5)  & 0x3F;
+        uint8_t b =  color        & 0x1F;
+        rgb[0]    = static_cast <uint8_t> ((r << 3) | (r >> 2));
+        rgb[1]    = static_cast <uint8_t> ((g << 2) | (g >> 4));
+        rgb[2]    = static_cast <uint8_t> ((b << 3) | (b >> 2));
+    }
+
+    /* The end points are the extremes of the texels projected onto their principal axis (found by power iteration on
+     * the covariance matrix), which fits gradients far better than the bounding box corners
+    */
+    void encodeBC1Block (const uint8_t* texels, uint8_t* block) {
+        float mean[3] = {0.0f, 0.0f, 0.0f};
+        for (uint32_t i = 0; i < 16; i++) {
+            mean[0] += texels[i * 4 + 0];
+            mean[1] += texels[i * 4 + 1];
+            mean[2] += texels[i * 4 + 2];
+        }
+        for (auto& value: mean)
+            value /= 16.0f;
+
+        float covariance[6] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+        for (uint32_t i = 0; i < 16; i++) {
+            float r        = texels[i * 4 + 0] - mean[0];
+            float g        = texels[i * 4 + 1] - mean[1];
+            float b        = texels[i * 4 + 2] - mean[2];
+            covariance[0] += r * r;
+            covariance[1] += r * g;
+            covariance[2] += r * b;
+            covariance[3] += g * g;
+            covariance[4] += g * b;
+            covariance[5] += b * b;
+        }
+
+        float axis[3] = {1.0f, 1.0f, 1.0f};
+        for (uint32_t i = 0; i < 8; i++) {
+            float x   = covariance[0] * axis[0] + covariance[1] * axis[1] + covariance[2] * axis[2];
+            float y   = covariance[1] * axis[0] + covariance[3] * axis[1] + covariance[4] * axis[2];
+            float z   = covariance[2] * axis[0] + covariance[4] * axis[1] + covariance[5] * axis[2];
+            float m   = std::max ({std::fabs (x), std::fabs (y), std::fabs (z)});
+            /* Solid color block, any axis will do */
+            if (m < FLT_EPSILON)
+                break;
+            axis[0]   = x / m;
+            axis[1]   = y / m;
+            axis[2]   = z / m;
+        }
+
+        float minProjection = FLT_MAX;
+        float maxProjection = -FLT_MAX;
+        for (uint32_t i = 0; i < 16; i++) {
+            float projection = (texels[i * 4 + 0] - mean[0]) * axis[0] +
+                               (texels[i * 4 + 1] - mean[1]) * axis[1] +
+                               (texels[i * 4 + 2] - mean[2]) * axis[2];
+            minProjection    = std::min (minProjection, projection);
+            maxProjection    = std::max (maxProjection, projection);
+        }
+        float axisLengthSquared = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+        minProjection          /= axisLengthSquared;
+        maxProjection          /= axisLengthSquared;
+
+        uint16_t color0 = getRGB565 (mean[0] + axis[0] * maxProjection,
+                                     mean[1] + axis[1] * maxProjection,
+                                     mean[2] + axis[2] * maxProjection);
+        uint16_t color1 = getRGB565 (mean[0] + axis[0] * minProjection,
+                                     mean[1] + axis[1] * minProjection,
+                                     mean[2] + axis[2] * minProjection);
+        /* color0 > color1 selects the 4 color mode (as opposed to 3 colors and transparent black) */
+        if (color0 < color1)
+            std::swap (color0, color1);
+
+        uint32_t indices = 0;
+        if (color0 != color1) {
+            uint8_t palette[4][3];
+            getRGB888 (color0, palette[0]);
+            getRGB888 (color1, palette[1]);
+            for (uint32_t c = 0; c < 3; c++) {
+                palette[2][c] = static_cast <uint8_t> ((2 * palette[0][c] +     palette[1][c]) / 3);
+                palette[3][c] = static_cast <uint8_t> ((    palette[0][c] + 2 * palette[1][c]) / 3);
+            }
+
+            for (uint32_t i = 0; i < 16; i++) {
+                uint32_t bestIdx      = 0;
+                int32_t  bestDistance = std::numeric_limits <int32_t>::max();
+                for (uint32_t j = 0; j < 4; j++) {
+                    int32_t r        = texels[i * 4 + 0] - palette[j][0];
+                    int32_t g        = texels[i * 4 + 1] - palette[j][1];
+                    int32_t b        = texels[i * 4 + 2] - palette[j][2];
+                    int32_t distance = r * r + g * g + b * b;
+                    if (distance < bestDistance) {
+                        bestDistance = distance;
+                        bestIdx      = j;
+                    }
+                }
+                indices |= bestIdx << (i * 2);
+            }
+        }
+        std::memcpy (block + 0, &color0,  sizeof (color0));
+        std::memcpy (block + 2, &color1,  sizeof (color1));
+        std::memcpy (block + 4, &indices, sizeof (indices));
+    }
+
+    void encodeAlphaBlock (const uint8_t* texels, uint8_t* block) {
+        uint8_t alpha0 = 0;
+        uint8_t alpha1 = 255;
+        for (uint32_t i = 0; i < 16; i++) {
+            alpha0 = std::max (alpha0, texels[i * 4 + 3]);
+            alpha1 = std::min (alpha1, texels[i * 4 + 3]);
+        }
+        /* alpha0 > alpha1 selects the 8 value mode, a constant block uses index 0 throughout */
+        uint64_t indices = 0;
+        if (alpha0 != alpha1) {
+            uint8_t palette[8] = {alpha0, alpha1};
+            for (uint32_t j = 2; j < 8; j++)
+                palette[j] = static_cast <uint8_t> (((8 - j) * alpha0 + (j - 1) * alpha1) / 7);
+
+            for (uint32_t i = 0; i < 16; i++) {
+                uint64_t bestIdx      = 0;
+                int32_t  bestDistance = std::numeric_limits <int32_t>::max();
+                for (uint32_t j = 0; j < 8; j++) {
+                    int32_t distance = std::abs (texels[i * 4 + 3] - palette[j]);
+                    if (distance < bestDistance) {
+                        bestDistance = distance;
+                        bestIdx      = j;
+                    }
+                }
+                indices |= bestIdx << (i * 3);
+            }
+        }
+        block[0] = alpha0;
+        block[1] = alpha1;
+        for (uint32_t i = 0; i < 6; i++)
+            block[2 + i] = static_cast <uint8_t> (indices >> (i * 8));
+    }
+
+    /* Note that, the color block of BC3 is always decoded in the 4 color mode */
+    void decodeBC1Block (const uint8_t* block, const bool fourColorModeForced, uint8_t* texels) {
+        uint16_t color0, color1;
+        uint32_t indices;
+        std::memcpy (&color0,  block + 0, sizeof (color0));
+        std::memcpy (&color1,  block + 2, sizeof (color1));
+        std::memcpy (&indices, block + 4, sizeof (indices));
+
+        uint8_t palette[4][4];
+        getRGB888 (color0, palette[0]);
+        getRGB888 (color1, palette[1]);
+        bool fourColorMode = fourColorModeForced || color0 > color1;
+        palette[0][3]      = 255;
+        palette[1][3]      = 255;
+        for (uint32_t c = 0; c < 3; c++) {
+            if (fourColorMode) {
+                palette[2][c] = static_cast <uint8_t> ((2 * palette[0][c] +     palette[1][c]) / 3);
+                palette[3][c] = static_cast <uint8_t> ((    palette[0][c] + 2 * palette[1][c]) / 3);
+            }
+            else {
+                palette[2][c] = static_cast <uint8_t> ((palette[0][c] + palette[1][c]) / 2);
+                palette[3][c] = 0;
+            }
+        }
+        palette[2][3]      = 255;
+        palette[3][3]      = fourColorMode ? 255: 0;
+
+        for (uint32_t i = 0; i < 16; i++)
+            std::memcpy (texels + i * 4, palette[(indices >> (i * 2)) & 0x3], 4);
+    }
+
+    void decodeAlphaBlock (const uint8_t* block, uint8_t* texels) {
+        uint8_t palette[8] = {block[0], block[1]};
+        if (block[0] > block[1]) {
+            for (uint32_t j = 2; j < 8; j++)
+                palette[j] = static_cast <uint8_t> (((8 - j) * block[0] + (j - 1) * block[1]) / 7);
+        }
+        else {
+            for (uint32_t j = 2; j < 6; j++)
+                palette[j] = static_cast <uint8_t> (((6 - j) * block[0] + (j - 1) * block[1]) / 5);
+            palette[6] = 0;
+            palette[7] = 255;
+        }
+
+        uint64_t indices = 0;
+        for (uint32_t i = 0; i < 6; i++)
+            indices |= static_cast <uint64_t> (block[2 + i]) << (i * 8);
+        for (uint32_t i = 0; i < 16; i++)
+            texels[i * 4 + 3] = palette[(indices >> (i * 3)) & 0x7];
+    }
+
+    /* Encode a single (RGBA8) level into blocks, in row major block order */
+    void encodeImage (const uint8_t* texels,
+                      const int width,
+                      const int height,
+                      const VkFormat format,
+                      uint8_t* blocks) {
+
+        uint8_t blockTexels[16 * 4];
+        for (int blockY = 0; blockY < height; blockY += 4) {
+            for (int blockX = 0; blockX < width; blockX += 4) {
+                for (int y = 0; y < 4; y++) {
+                    for (int x = 0; x < 4; x++) {
+                        int srcX = std::min (blockX + x, width  - 1);
+                        int srcY = std::min (blockY + y, height - 1);
+                        std::memcpy (blockTexels + (y * 4 + x) * 4,
+                                     texels + (static_cast <size_t> (srcY) * width + srcX) * 4,
+                                     4);
+                    }
+                }
+                if (format == VK_FORMAT_BC3_SRGB_BLOCK) {
+                    encodeAlphaBlock (blockTexels, blocks);
+                    blocks += 8;
+                }
+                encodeBC1Block (blockTexels, blocks);
+                blocks += 8;
+            }
+        }
+    }
+
+    /* Decode a single level back into RGBA8 texels, used where the device can't sample the compressed format */
+    void decodeImage (const uint8_t* blocks,
+                      const int width,
+                      const int height,
+                      const VkFormat format,
+                      uint8_t* texels) {
+
+        uint8_t blockTexels[16 * 4];
+        for (int blockY = 0; blockY < height; blockY += 4) {
+            for (int blockX = 0; blockX < width; blockX += 4) {
+                bool alphaBlockPresent = format == VK_FORMAT_BC3_SRGB_BLOCK;
+                decodeBC1Block (blocks + (alphaBlockPresent ? 8: 0), alphaBlockPresent, blockTexels);
+                if (alphaBlockPresent) {
+                    decodeAlphaBlock (blocks, blockTexels);
+                    blocks += 8;
+                }
+                blocks += 8;
+
+                for (int y = 0; y < 4 && blockY + y < height; y++) {
+                    for (int x = 0; x < 4 && blockX + x < width; x++) {
+                        std::memcpy (texels + (static_cast <size_t> (blockY + y) * width + blockX + x) * 4,
+                                     blockTexels + (y * 4 + x) * 4,
+                                     4);
+                    }
+                }
+            }
+        }
+    }
+}   // namespace SandBox
\ No newline at end of file
@@ -3,51 +3,481 @@
 #include <stb/stb_image.h>
 #include "../Backend/Common.h"
 #include "../Backend/Log/LGImpl.h"
+#include "../Backend/Job/JBPool.h"
+#include "SBTextureCodec.h"
 
 namespace SandBox {
+    /* Texture cache file layout
+     *  +-----------+-----------+-----------+     +-----------+-----------+-----------+     +-----------+
+     *  |  Header   | Offset #0 | Offset #1 | ... | Offset #N |  Level #0 |  Level #1 | ... |  Level #N |
+     *  +-----------+-----------+-----------+     +-----------+-----------+-----------+     +-----------+
+     *
+     *  Header      magic, version, content hash, width, height, channels count, mip levels, format, data size
+     *  Offset      uint64_t offset of a mip level, from the start of level #0
+     *  Level       BC1/BC3 blocks (see SBTextureCodec), tightly packed in row major block order
+     *
+     * The levels are laid out exactly as the staging buffer expects them (see Renderer::copyBufferToImageMipLevels), so
+     * a mapped cache file is copied into the staging buffer as is. Cache files are named after the content hash of the
+     * source image, and so an edited image simply misses the cache
+    */
+    const char* g_textureCacheFileMagic      = "TXC1";
+    const char* g_textureCacheFileExtension  = ".txc";
+    const uint32_t g_textureCacheFileVersion = 2;
+    /* Minimum maxImageArrayLayers guaranteed by the spec, packed texture arrays are split beyond this */
+    const uint32_t g_maxTextureArrayLayers   = 256;
+
     class SBTexturePool {
         private:
             struct ImageInfo {
                 int width;
                 int height;
                 int channelsCount;
-                stbi_uc* data;
+                uint32_t mipLevels;
+                VkFormat format;
+                /* Offset of each mip level from the start of data, and the size of all levels combined */
+                std::vector <size_t> mipOffsets;
+                size_t size;
+                uint8_t* data;
+                /* Set if data points into a memory mapped cache file, as opposed to a heap allocation */
+                void* mappedData;
+                size_t mappedSize;
+                /* Empty if the image couldn't be cached, in which case it can't be re-loaded once destroyed */
+                std::string cacheFilePath;
+                uint64_t contentHash;
+            };
+
+            struct CacheFileHeader {
+                char magic[4];
+                uint32_t version;
+                uint64_t contentHash;
+                uint32_t width;
+                uint32_t height;
+                uint32_t channelsCount;
+                uint32_t mipLevels;
+                uint32_t format;
+                uint64_t size;
+            };
+
+            /* Image metadata, kept apart from the pixel data (see getImageData), so that the pool can be viewed as one
+             * contiguous array of these (see getTexturePool)
+            */
+            struct TextureInfo {
+                uint32_t idx;
+                int width;
+                int height;
+                int channelsCount;
+                uint32_t mipLevels;
+                VkFormat format;
+                std::vector <size_t> mipOffsets;
+                size_t size;
+            };
+
+            /* Location of a packed image, as a layer of a texture array */
+            struct ArrayLayerInfo {
+                uint32_t arrayIdx;
+                uint32_t layerIdx;
             };
 
             struct TexturePoolInfo {
                 struct Meta {
                     std::unordered_map <std::string, uint32_t> pathToIdxMap;
                     std::map <uint32_t, ImageInfo> idxToImageInfoMap;
+                    /* Textures that are still being decoded, moved to idxToImageInfoMap once they are waited on */
+                    std::map <uint32_t, std::shared_future <ImageInfo>> idxToImageInfoFutureMap;
+                    /* Indexed by texture idx, which are assigned contiguously starting at 0 (see addTexture) */
+                    std::vector <TextureInfo> textureInfos;
                     uint32_t nextAvailableIdx;
+                    std::string cacheDirPath;
+                    /* Texture indices of each texture array, in layer order (see packTextures) */
+                    std::map <uint32_t, std::vector <uint32_t>> arrayIdxToTextureIdxsMap;
+                    std::map <uint32_t, ArrayLayerInfo> idxToArrayLayerInfoMap;
+                    uint32_t maxPackedExtent;
                 } meta;
 
+                struct State {
+                    /* Only level 0 is generated and uploaded, for textures that are never minified (sky box etc.) */
+                    bool mipMapsDisabled;
+                } state;
+
                 struct Resource {
                     Log::LGImpl* logObj;
+                    Job::JBPool* jobPoolObj;
                 } resource;
             } m_texturePoolInfo;
 
-            ImageInfo loadImage (const char* imageFilePath) {
-                ImageInfo imageInfo;
+            /* FNV-1a over the encoded (file) bytes, along with the pool options that change the cached data */
+            uint64_t getContentHash (const std::vector <uint8_t>& fileBytes) {
+                uint64_t hash = 14695981039346656037ull;
+                for (auto const& byte: fileBytes) {
+                    hash ^= byte;
+                    hash *= 1099511628211ull;
+                }
+                hash ^= static_cast <uint64_t> (m_texturePoolInfo.state.mipMapsDisabled);
+                hash *= 1099511628211ull;
+                return hash;
+            }
+
+            std::string getCacheFilePath (const uint64_t contentHash) {
+                char fileName[17];
+                snprintf (fileName, sizeof (fileName), "%016" PRIx64, contentHash);
+                return m_texturePoolInfo.meta.cacheDirPath + "/" + fileName + g_textureCacheFileExtension;
+            }
+
+            void updateMipOffsets (ImageInfo& imageInfo) {
+                /* To calculate the number of levels in the mip chain, we use the max function to select the largest
+                 * dimension. The log2 function calculates how many times that dimension can be divided by 2. The floor
+                 * function handles cases where the largest dimension is not a power of 2. Finally, 1 is added so that
+                 * the original texture has a mip level
+                */
+                imageInfo.mipLevels  = m_texturePoolInfo.state.mipMapsDisabled ? 1: static_cast <uint32_t> (
+                    std::floor (std::log2 (std::max (
+                        imageInfo.width,
+                        imageInfo.height
+                    )))
+                ) + 1;
+                imageInfo.mipOffsets = {};
+                imageInfo.size       = 0;
+                for (uint32_t i = 0; i < imageInfo.mipLevels; i++) {
+                    imageInfo.mipOffsets.push_back (imageInfo.size);
+                    imageInfo.size  += getImageSize (imageInfo.format,
+                                                     std::max (imageInfo.width  >> i, 1),
+                                                     std::max (imageInfo.height >> i, 1));
+                }
+            }
+
+            /* Each level is a 2x2 box filter of the previous one. Color channels are averaged in linear space, since
+             * the images are sampled as sRGB (averaging the encoded values darkens the smaller levels), whereas alpha
+             * is averaged as is. The 4 channels of a texel are filtered together as one vector (compiler vector
+             * extensions, which are lowered to SSE/NEON), and the rows of each level are split across the job pool
+            */
+            void generateMipLevels (ImageInfo& imageInfo) {
+                typedef float   float4 __attribute__ ((vector_size (16)));
+                typedef int32_t int4   __attribute__ ((vector_size (16)));
+                /* The linear to sRGB table is fine enough that adjacent entries never differ by more than one 8 bit
+                 * step, even near black where the curve is steepest
+                */
+                static const auto srgbToLinearTable = [](void) {
+                    std::array <float, 256> table;
+                    for (uint32_t i = 0; i < 256; i++) {
+                        float value = static_cast <float> (i) / 255.0f;
+                        table[i]    = value <= 0.04045f ? value / 12.92f:
+                                                          std::pow ((value + 0.055f) / 1.055f, 2.4f);
+                    }
+                    return table;
+                }();
+                static const auto linearToSrgbTable = [](void) {
+                    std::array <uint8_t, 16384> table;
+                    for (uint32_t i = 0; i < 16384; i++) {
+                        float value   = static_cast <float> (i) / 16383.0f;
+                        float encoded = value <= 0.0031308f ? value * 12.92f:
+                                                              1.055f * std::pow (value, 1.0f / 2.4f) - 0.055f;
+                        table[i]      = static_cast <uint8_t> (std::clamp (encoded * 255.0f + 0.5f, 0.0f, 255.0f));
+                    }
+                    return table;
+                }();
+                auto getLinearTexel = [](const uint8_t* texel) {
+                    return float4 {
+                        srgbToLinearTable[texel[0]],
+                        srgbToLinearTable[texel[1]],
+                        srgbToLinearTable[texel[2]],
+                        static_cast <float> (texel[3]) / 255.0f
+                    };
+                };
+
+                for (uint32_t i = 1; i < imageInfo.mipLevels; i++) {
+                    int srcWidth  = std::max (imageInfo.width  >> (i - 1), 1);
+                    int srcHeight = std::max (imageInfo.height >> (i - 1), 1);
+                    int dstWidth  = std::max (imageInfo.width  >> i, 1);
+                    int dstHeight = std::max (imageInfo.height >> i, 1);
+                    auto srcLevel = imageInfo.data + imageInfo.mipOffsets[i - 1];
+                    auto dstLevel = imageInfo.data + imageInfo.mipOffsets[i];
+                    /* Chunks of roughly 16K texels, so that the small levels are not split at all */
+                    int rowsCount = std::max (16384 / dstWidth, 1);
+
+                    auto filterRows = [=](uint32_t chunkIdx) {
+                        int beginY = static_cast <int> (chunkIdx) * rowsCount;
+                        int endY   = std::min (beginY + rowsCount, dstHeight);
+
+                        for (int y = beginY; y < endY; y++) {
+                            /* Dimensions that have already reached 1 (non square images) are not halved further */
+                            auto srcRowA = srcLevel + static_cast <size_t> (std::min (y * 2,     srcHeight - 1)) *
+                                                      srcWidth * 4;
+                            auto srcRowB = srcLevel + static_cast <size_t> (std::min (y * 2 + 1, srcHeight - 1)) *
+                                                      srcWidth * 4;
+                            auto dstRow  = dstLevel + static_cast <size_t> (y) * dstWidth * 4;
+
+                            for (int x = 0; x < dstWidth; x++) {
+                                int srcColA    = std::min (x * 2,     srcWidth - 1) * 4;
+                                int srcColB    = std::min (x * 2 + 1, srcWidth - 1) * 4;
+                                float4 average = (getLinearTexel (srcRowA + srcColA) +
+                                                  getLinearTexel (srcRowA + srcColB) +
+                                                  getLinearTexel (srcRowB + srcColA) +
+                                                  getLinearTexel (srcRowB + srcColB)) * 0.25f;
+                                int4 idxs      = __builtin_convertvector (average * 16383.0f + 0.5f, int4);
+
+                                auto texel     = dstRow + x * 4;
+                                texel[0]       = linearToSrgbTable[idxs[0]];
+                                texel[1]       = linearToSrgbTable[idxs[1]];
+                                texel[2]       = linearToSrgbTable[idxs[2]];
+                                texel[3]       = static_cast <uint8_t> (average[3] * 255.0f + 0.5f);
+                            }
+                        }
+                    };
+                    m_texturePoolInfo.resource.jobPoolObj->runParallelJobs (
+                        static_cast <uint32_t> ((dstHeight + rowsCount - 1) / rowsCount),
+                        filterRows
+                    );
+                }
+            }
+
+            /* Opaque images are encoded as BC1 (4 bits per texel), and images with any transparency as BC3 (8 bits per
+             * texel), down from 32 bits per texel for RGBA8
+            */
+            void compressImage (ImageInfo& imageInfo) {
+                bool alphaPresent = false;
+                size_t levelSize  = getImageSize (imageInfo.format, imageInfo.width, imageInfo.height);
+                for (size_t i = 3; i < levelSize; i += 4) {
+                    if (imageInfo.data[i] != 255) {
+                        alphaPresent = true;
+                        break;
+                    }
+                }
+
+                ImageInfo compressedImageInfo = imageInfo;
+                compressedImageInfo.format    = alphaPresent ? VK_FORMAT_BC3_SRGB_BLOCK: VK_FORMAT_BC1_RGB_SRGB_BLOCK;
+                updateMipOffsets (compressedImageInfo);
+                compressedImageInfo.data      = new uint8_t[compressedImageInfo.size];
+
+                for (uint32_t i = 0; i < imageInfo.mipLevels; i++)
+                    encodeImage (imageInfo.data           + imageInfo.mipOffsets[i],
+                                 std::max (imageInfo.width  >> i, 1),
+                                 std::max (imageInfo.height >> i, 1),
+                                 compressedImageInfo.format,
+                                 compressedImageInfo.data + compressedImageInfo.mipOffsets[i]);
+
+                delete[] imageInfo.data;
+                imageInfo = compressedImageInfo;
+            }
+
+            void decodeImageInfo (ImageInfo& imageInfo) {
+                ImageInfo decompressedImageInfo  = imageInfo;
+                decompressedImageInfo.format     = VK_FORMAT_R8G8B8A8_SRGB;
+                updateMipOffsets (decompressedImageInfo);
+                decompressedImageInfo.data       = new uint8_t[decompressedImageInfo.size];
+                decompressedImageInfo.mappedData = nullptr;
+                decompressedImageInfo.mappedSize = 0;
+
+                for (uint32_t i = 0; i < imageInfo.mipLevels; i++)
+                    decodeImage (imageInfo.data             + imageInfo.mipOffsets[i],
+                                 std::max (imageInfo.width  >> i, 1),
+                                 std::max (imageInfo.height >> i, 1),
+                                 imageInfo.format,
+                                 decompressedImageInfo.data + decompressedImageInfo.mipOffsets[i]);
+
+                if (imageInfo.mappedData != nullptr)
+                    munmap (imageInfo.mappedData, imageInfo.mappedSize);
+                else
+                    delete[] imageInfo.data;
+                imageInfo = decompressedImageInfo;
+            }
+
+            /* Map the cache file (if any) and validate it against the content hash. Anything unexpected is treated as a
+             * miss, and the file is overwritten once the image is decoded again
+            */
+            bool readCacheFile (const std::string cacheFilePath, const uint64_t contentHash, ImageInfo& imageInfo) {
+                int fileDescriptor = open (cacheFilePath.c_str(), O_RDONLY);
+                if (fileDescriptor == -1)
+                    return false;
+
+                struct stat fileStat;
+                void* mappedData   = MAP_FAILED;
+                size_t mappedSize  = 0;
+                if (fstat (fileDescriptor, &fileStat) == 0 && fileStat.st_size > 0) {
+                    mappedSize     = static_cast <size_t> (fileStat.st_size);
+                    mappedData     = mmap (nullptr, mappedSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+                }
+                /* The mapping stays valid after the file is closed */
+                close (fileDescriptor);
+                if (mappedData == MAP_FAILED)
+                    return false;
+
+                CacheFileHeader header;
+                bool cacheFileValid = mappedSize >= sizeof (header);
+                if (cacheFileValid) {
+                    std::memcpy (&header, mappedData, sizeof (header));
+                    size_t dataOffset = sizeof (header) + header.mipLevels * sizeof (uint64_t);
+                    cacheFileValid    = std::memcmp (header.magic, g_textureCacheFileMagic, 4) == 0 &&
+                                        header.version     == g_textureCacheFileVersion             &&
+                                        header.contentHash == contentHash                           &&
+                                        isBlockCompressedFormat (static_cast <VkFormat> (header.format)) &&
+                                        dataOffset + header.size == mappedSize;
+                }
+                if (cacheFileValid) {
+                    imageInfo.width         = static_cast <int> (header.width);
+                    imageInfo.height        = static_cast <int> (header.height);
+                    imageInfo.channelsCount = static_cast <int> (header.channelsCount);
+                    imageInfo.format        = static_cast <VkFormat> (header.format);
+                    updateMipOffsets (imageInfo);
+                    cacheFileValid          = imageInfo.mipLevels == header.mipLevels &&
+                                              imageInfo.size      == header.size;
+                }
+                if (!cacheFileValid) {
+                    munmap (mappedData, mappedSize);
+                    return false;
+                }
+
+                imageInfo.data       = static_cast <uint8_t*> (mappedData) + mappedSize - imageInfo.size;
+                imageInfo.mappedData = mappedData;
+                imageInfo.mappedSize = mappedSize;
+                return true;
+            }
+
+            /* The file is written under a temporary name and renamed into place, so that a reader never maps a
+             * partially written file (two paths with identical content may be decoded at the same time)
+            */
+            bool writeCacheFile (const std::string cacheFilePath, const uint64_t contentHash, ImageInfo& imageInfo) {
+                CacheFileHeader header;
+                /* Zero the padding as well, since the header is written as is */
+                std::memset (&header, 0, sizeof (header));
+                std::memcpy (header.magic, g_textureCacheFileMagic, 4);
+                header.version       = g_textureCacheFileVersion;
+                header.contentHash   = contentHash;
+                header.width         = static_cast <uint32_t> (imageInfo.width);
+                header.height        = static_cast <uint32_t> (imageInfo.height);
+                header.channelsCount = static_cast <uint32_t> (imageInfo.channelsCount);
+                header.mipLevels     = imageInfo.mipLevels;
+                header.format        = static_cast <uint32_t> (imageInfo.format);
+                header.size          = imageInfo.size;
+
+                std::string tempFilePath = cacheFilePath + "." + std::to_string (
+                    std::hash <std::thread::id>{} (std::this_thread::get_id())
+                );
+                std::ofstream file (tempFilePath, std::ios::binary);
+                if (!file.is_open()) {
+                    LOG_WARNING (m_texturePoolInfo.resource.logObj) << "Failed to open texture cache file"
+                                                                    << " "
+                                                                    << "[" << tempFilePath << "]"
+                                                                    << std::endl;
+                    return false;
+                }
+                file.write (reinterpret_cast <const char*> (&header), sizeof (header));
+                for (auto const& mipOffset: imageInfo.mipOffsets) {
+                    uint64_t offset = mipOffset;
+                    file.write (reinterpret_cast <const char*> (&offset), sizeof (offset));
+                }
+                file.write (reinterpret_cast <const char*> (imageInfo.data),
+                            static_cast <std::streamsize> (imageInfo.size));
+                file.close();
+
+                if (!file || std::rename (tempFilePath.c_str(), cacheFilePath.c_str()) != 0) {
+                    LOG_WARNING (m_texturePoolInfo.resource.logObj) << "Failed to write texture cache file"
+                                                                    << " "
+                                                                    << "[" << cacheFilePath << "]"
+                                                                    << std::endl;
+                    std::remove (tempFilePath.c_str());
+                    return false;
+                }
+                return true;
+            }
+
+            /* Note that, this runs on the job pool workers. A cache hit only costs reading (and hashing) the encoded
+             * file, whereas a miss decodes the image, generates the mip levels and writes the cache file
+            */
+            ImageInfo loadImage (const std::string imageFilePath) {
+                auto& logObj = m_texturePoolInfo.resource.logObj;
+                std::ifstream file (imageFilePath, std::ios::binary);
+                if (!file.is_open()) {
+                    LOG_ERROR (logObj) << "Failed to open image"
+                                       << " "
+                                       << "[" << imageFilePath << "]"
+                                       << std::endl;
+                    throw std::runtime_error ("Failed to open image");
+                }
+                auto fileBytes = std::vector <uint8_t> (std::istreambuf_iterator <char> (file),
+                                                        std::istreambuf_iterator <char>());
+                file.close();
+
+                ImageInfo imageInfo{};
+                auto contentHash   = getContentHash (fileBytes);
+                auto cacheFilePath = getCacheFilePath (contentHash);
+                if (readCacheFile (cacheFilePath, contentHash, imageInfo)) {
+                    imageInfo.cacheFilePath = cacheFilePath;
+                    imageInfo.contentHash   = contentHash;
+                    LOG_INFO (logObj) << "Texture cache hit"
+                                      << " "
+                                      << "[" << imageFilePath << "]"
+                                      << std::endl;
+                    return imageInfo;
+                }
                 /* Note that, the STBI_rgb_alpha value forces the image to be loaded with an alpha channel, even if it
                  * doesn't have one. The pointer returned is the first element in an array of pixel values that are laid
                  * out row by row with 4 bytes per pixel in the case of STBI_rgb_alpha for a total of (width * height *
                  * 4) values
                 */
-                imageInfo.data = stbi_load (imageFilePath,
-                                            &imageInfo.width,
-                                            &imageInfo.height,
-                                            &imageInfo.channelsCount,
-                                            STBI_rgb_alpha);
-                if (!imageInfo.data) {
-                    LOG_ERROR (m_texturePoolInfo.resource.logObj) << "Failed to load image"
-                                                                  << " "
-                                                                  << "[" << imageFilePath << "]"
-                                                                  << std::endl;
+                auto decodedData = stbi_load_from_memory (fileBytes.data(),
+                                                          static_cast <int> (fileBytes.size()),
+                                                          &imageInfo.width,
+                                                          &imageInfo.height,
+                                                          &imageInfo.channelsCount,
+                                                          STBI_rgb_alpha);
+                if (!decodedData) {
+                    LOG_ERROR (logObj) << "Failed to load image"
+                                       << " "
+                                       << "[" << imageFilePath << "]"
+                                       << std::endl;
                     throw std::runtime_error ("Failed to load image");
                 }
+                imageInfo.format = VK_FORMAT_R8G8B8A8_SRGB;
+                updateMipOffsets (imageInfo);
+                imageInfo.data   = new uint8_t[imageInfo.size];
+                std::memcpy (imageInfo.data, decodedData, imageInfo.mipOffsets.size() > 1 ? imageInfo.mipOffsets[1]:
+                                                                                            imageInfo.size);
+                stbi_image_free (decodedData);
+
+                generateMipLevels (imageInfo);
+                compressImage     (imageInfo);
+                if (writeCacheFile (cacheFilePath, contentHash, imageInfo)) {
+                    imageInfo.cacheFilePath = cacheFilePath;
+                    imageInfo.contentHash   = contentHash;
+                }
+                LOG_INFO (logObj) << "Texture cache miss"
+                                  << " "
+                                  << "[" << imageFilePath << "]"
+                                  << " "
+                                  << "[" << cacheFilePath << "]"
+                                  << std::endl;
                 return imageInfo;
             }
 
+            void updateTextureInfo (const uint32_t textureIdx, const ImageInfo& imageInfo) {
+                auto& textureInfo         = m_texturePoolInfo.meta.textureInfos[textureIdx];
+                textureInfo.width         = imageInfo.width;
+                textureInfo.height        = imageInfo.height;
+                textureInfo.channelsCount = imageInfo.channelsCount;
+                textureInfo.mipLevels     = imageInfo.mipLevels;
+                textureInfo.format        = imageInfo.format;
+                textureInfo.mipOffsets    = imageInfo.mipOffsets;
+                textureInfo.size          = imageInfo.size;
+            }
+
+            /* Block until the texture is decoded. Decode errors (logged on the worker) are re-thrown here */
+            ImageInfo& getImageInfo (const uint32_t textureIdx) {
+                auto& meta = m_texturePoolInfo.meta;
+                if (meta.idxToImageInfoFutureMap.find (textureIdx) != meta.idxToImageInfoFutureMap.end()) {
+                    meta.idxToImageInfoMap[textureIdx] = meta.idxToImageInfoFutureMap[textureIdx].get();
+                    meta.idxToImageInfoFutureMap.erase (textureIdx);
+                    updateTextureInfo (textureIdx, meta.idxToImageInfoMap[textureIdx]);
+                }
+                if (meta.idxToImageInfoMap.find (textureIdx) == meta.idxToImageInfoMap.end()) {
+                    LOG_ERROR (m_texturePoolInfo.resource.logObj) << "Image info does not exist"
+                                                                  << " "
+                                                                  << "[" << textureIdx << "]"
+                                                                  << std::endl;
+                    throw std::runtime_error ("Image info does not exist");
+                }
+                return meta.idxToImageInfoMap[textureIdx];
+            }
+
         public:
             SBTexturePool (void) {
                 m_texturePoolInfo = {};
@@ -60,68 +490,245 @@ namespace SandBox {
                 logObj->updateLogConfig (Log::LEVEL_TYPE_ERROR,   Log::SINK_TYPE_CONSOLE | Log::SINK_TYPE_FILE);
             }
 
-            void initTexturePoolInfo (void) {
-                auto& meta             = m_texturePoolInfo.meta;
-                meta.pathToIdxMap      = {};
-                meta.idxToImageInfoMap = {};
-                meta.nextAvailableIdx  = 0;
+            /* Decoded (and mipped) images are cached under cacheDirPath, see g_textureCacheFileMagic. Images no larger
+             * than maxPackedExtent are packed into texture arrays (see packTextures), a value of 0 disables packing
+            */
+            void initTexturePoolInfo (Job::JBPool* jobPoolObj,
+                                      const std::string cacheDirPath,
+                                      const bool mipMapsDisabled,
+                                      const uint32_t maxPackedExtent) {
+                auto& meta                              = m_texturePoolInfo.meta;
+                if (jobPoolObj == nullptr) {
+                    LOG_ERROR (m_texturePoolInfo.resource.logObj) << NULL_DEPOBJ_MSG
+                                                                  << std::endl;
+                    throw std::runtime_error (NULL_DEPOBJ_MSG);
+                }
+
+                meta.pathToIdxMap                       = {};
+                meta.idxToImageInfoMap                  = {};
+                meta.idxToImageInfoFutureMap            = {};
+                meta.textureInfos                       = {};
+                meta.nextAvailableIdx                   = 0;
+                meta.cacheDirPath                       = cacheDirPath;
+                meta.arrayIdxToTextureIdxsMap           = {};
+                meta.idxToArrayLayerInfoMap             = {};
+                meta.maxPackedExtent                    = maxPackedExtent;
+                m_texturePoolInfo.state.mipMapsDisabled = mipMapsDisabled;
+                m_texturePoolInfo.resource.jobPoolObj   = jobPoolObj;
             }
 
             uint32_t getTextureIdx (const std::string imageFilePath) {
                 return m_texturePoolInfo.meta.pathToIdxMap[imageFilePath];
             }
 
-            std::map <uint32_t, ImageInfo>& getTexturePool (void) {
-                return m_texturePoolInfo.meta.idxToImageInfoMap;
+            void waitForTextures (void) {
+                auto& idxToImageInfoFutureMap = m_texturePoolInfo.meta.idxToImageInfoFutureMap;
+                while (!idxToImageInfoFutureMap.empty())
+                    getImageInfo (idxToImageInfoFutureMap.begin()->first);
+            }
+
+            /* Read only view of the image metadata, sorted by (and indexed with) texture idx. The view is cheap to
+             * copy, and stays valid until the next addTexture. Note that, this waits for all pending textures, so
+             * ideally it is first called as late as possible to let decoding overlap with the rest of the setup
+            */
+            std::span <const TextureInfo> getTexturePool (void) {
+                waitForTextures();
+                return m_texturePoolInfo.meta.textureInfos;
             }
 
-            void addTexture (const std::string imageFilePath) {
+            /* Pixel data of every mip level (laid out as given by the mip offsets), or nullptr once destroyed */
+            const uint8_t* getImageData (const uint32_t textureIdx) {
+                return getImageInfo (textureIdx).data;
+            }
+
+            /* Texture indices are assigned in the order the textures are added (and so are independent of the order in
+             * which decoding completes), while the decode itself is queued on the job pool
+            */
+            uint32_t addTexture (const std::string imageFilePath) {
                 auto& meta = m_texturePoolInfo.meta;
                 /* Return if texture has already been added to the pool */
                 if (meta.pathToIdxMap.find (imageFilePath) != meta.pathToIdxMap.end())
-                    return;
+                    return meta.pathToIdxMap[imageFilePath];
 
                 meta.pathToIdxMap.insert ({
                     imageFilePath,
                     meta.nextAvailableIdx
                 });
-                meta.idxToImageInfoMap[meta.nextAvailableIdx] = loadImage (
-                    imageFilePath.c_str()
-                );
-                ++meta.nextAvailableIdx;
+                meta.textureInfos.push_back ({});
+                meta.textureInfos.back().idx = meta.nextAvailableIdx;
+                meta.idxToImageInfoFutureMap[meta.nextAvailableIdx] = m_texturePoolInfo.resource.jobPoolObj->addJob (
+                    [this, imageFilePath](void) {
+                        return loadImage (imageFilePath);
+                    }
+                ).share();
+                return meta.nextAvailableIdx++;
             }
 
             void destroyImage (const uint32_t textureIdx) {
-                auto& idxToImageInfoMap = m_texturePoolInfo.meta.idxToImageInfoMap;
-                if (idxToImageInfoMap.find (textureIdx) == idxToImageInfoMap.end()) {
-                    LOG_ERROR (m_texturePoolInfo.resource.logObj) << "Image info does not exist"
+                auto& imageInfo = getImageInfo (textureIdx);
+                if (imageInfo.mappedData != nullptr)
+                    munmap (imageInfo.mappedData, imageInfo.mappedSize);
+                else
+                    delete[] imageInfo.data;
+
+                imageInfo.data       = nullptr;
+                imageInfo.mappedData = nullptr;
+                imageInfo.mappedSize = 0;
+            }
+
+            /* Convert a block compressed image back to RGBA8 on the host, for devices that can't sample the format */
+            void decompressImage (const uint32_t textureIdx) {
+                auto& imageInfo = getImageInfo (textureIdx);
+                if (!isBlockCompressedFormat (imageInfo.format))
+                    return;
+
+                decodeImageInfo   (imageInfo);
+                updateTextureInfo (textureIdx, imageInfo);
+                LOG_WARNING (m_texturePoolInfo.resource.logObj) << "Block compressed format not supported, decompressed"
+                                                                << " "
+                                                                << "[" << textureIdx << "]"
+                                                                << std::endl;
+            }
+
+            /* Map the image back in from the texture cache, after it has been destroyed (once uploaded). The image is
+             * decompressed again if it was before. Returns false if the image was never cached, or if the cache file
+             * has since been removed or changed
+            */
+            bool reloadImage (const uint32_t textureIdx) {
+                auto& imageInfo = getImageInfo (textureIdx);
+                if (imageInfo.data != nullptr)
+                    return true;
+                if (imageInfo.cacheFilePath.empty())
+                    return false;
+
+                ImageInfo reloadedImageInfo{};
+                if (!readCacheFile (imageInfo.cacheFilePath, imageInfo.contentHash, reloadedImageInfo)) {
+                    LOG_WARNING (m_texturePoolInfo.resource.logObj) << "Failed to reload image"
+                                                                    << " "
+                                                                    << "[" << imageInfo.cacheFilePath << "]"
+                                                                    << std::endl;
+                    return false;
+                }
+                reloadedImageInfo.cacheFilePath = imageInfo.cacheFilePath;
+                reloadedImageInfo.contentHash   = imageInfo.contentHash;
+
+                bool decompressionRequired      = !isBlockCompressedFormat (imageInfo.format);
+                imageInfo                       = reloadedImageInfo;
+                if (decompressionRequired)
+                    decodeImageInfo (imageInfo);
+                updateTextureInfo (textureIdx, imageInfo);
+                return true;
+            }
+
+            bool isImageReloadable (const uint32_t textureIdx) {
+                return !getImageInfo (textureIdx).cacheFilePath.empty();
+            }
+
+            /* Group small images that share the same extent, format and mip levels into texture arrays, one layer per
+             * image, so that they are backed by a single image (and allocation) instead of one each. Images that have
+             * no match are left as is. Note that, this is to be called once the image formats are final (i.e. after
+             * decompressImage), and before the images are destroyed
+            */
+            void packTextures (void) {
+                auto& meta = m_texturePoolInfo.meta;
+                waitForTextures();
+
+                meta.arrayIdxToTextureIdxsMap = {};
+                meta.idxToArrayLayerInfoMap   = {};
+                if (meta.maxPackedExtent == 0)
+                    return;
+
+                std::map <std::tuple <int, int, VkFormat, uint32_t>, std::vector <uint32_t>> groupToTextureIdxsMap;
+                for (auto const& textureInfo: meta.textureInfos) {
+                    if (static_cast <uint32_t> (textureInfo.width)  > meta.maxPackedExtent ||
+                        static_cast <uint32_t> (textureInfo.height) > meta.maxPackedExtent)
+                        continue;
+                    groupToTextureIdxsMap[{
+                        textureInfo.width,
+                        textureInfo.height,
+                        textureInfo.format,
+                        textureInfo.mipLevels
+                    }].push_back (textureInfo.idx);
+                }
+
+                uint32_t arrayIdx = 0;
+                for (auto const& [group, textureIdxs]: groupToTextureIdxsMap) {
+                    if (textureIdxs.size() < 2)
+                        continue;
+
+                    for (size_t i = 0; i < textureIdxs.size(); i += g_maxTextureArrayLayers) {
+                        auto layersCount = std::min (textureIdxs.size() - i, static_cast <size_t> (
+                            g_maxTextureArrayLayers
+                        ));
+                        for (uint32_t j = 0; j < layersCount; j++) {
+                            meta.arrayIdxToTextureIdxsMap[arrayIdx].push_back (textureIdxs[i + j]);
+                            meta.idxToArrayLayerInfoMap[textureIdxs[i + j]] = {arrayIdx, j};
+                        }
+                        arrayIdx++;
+                    }
+                }
+                LOG_INFO (m_texturePoolInfo.resource.logObj) << "Packed textures"
+                                                             << " "
+                                                             << "[" << meta.idxToArrayLayerInfoMap.size()   << "]"
+                                                             << " "
+                                                             << "[" << meta.arrayIdxToTextureIdxsMap.size() << "]"
+                                                             << std::endl;
+            }
+
+            bool isImagePacked (const uint32_t textureIdx) {
+                auto& idxToArrayLayerInfoMap = m_texturePoolInfo.meta.idxToArrayLayerInfoMap;
+                return idxToArrayLayerInfoMap.find (textureIdx) != idxToArrayLayerInfoMap.end();
+            }
+
+            ArrayLayerInfo getArrayLayerInfo (const uint32_t textureIdx) {
+                auto& idxToArrayLayerInfoMap = m_texturePoolInfo.meta.idxToArrayLayerInfoMap;
+                if (!isImagePacked (textureIdx)) {
+                    LOG_ERROR (m_texturePoolInfo.resource.logObj) << "Image is not packed"
                                                                   << " "
                                                                   << "[" << textureIdx << "]"
                                                                   << std::endl;
-                    throw std::runtime_error ("Image info does not exist");
+                    throw std::runtime_error ("Image is not packed");
                 }
-                auto imageInfo = idxToImageInfoMap[textureIdx];
-                stbi_image_free (imageInfo.data);
+                return idxToArrayLayerInfoMap[textureIdx];
+            }
+
+            std::map <uint32_t, std::vector <uint32_t>>& getTextureArrays (void) {
+                return m_texturePoolInfo.meta.arrayIdxToTextureIdxsMap;
             }
 
             void generateReport (void) {
                 auto& meta   = m_texturePoolInfo.meta;
                 auto& logObj = m_texturePoolInfo.resource.logObj;
+                waitForTextures();
 
-                LOG_LITE_INFO (logObj)     << "{"                     << std::endl;
+                LOG_LITE_INFO (logObj)     << "{"                       << std::endl;
                 for (auto const& [path, idx]: meta.pathToIdxMap) {
-                    auto imageInfo = meta.idxToImageInfoMap[idx];
+                    auto& textureInfo = meta.textureInfos[idx];
 
-                    LOG_LITE_INFO (logObj) << "\t" << ALIGN_AND_PAD_S << idx                     << ", "
-                                                   << ALIGN_AND_PAD_S << imageInfo.width         << ", "
-                                                   << ALIGN_AND_PAD_S << imageInfo.height        << ", "
-                                                   << ALIGN_AND_PAD_S << imageInfo.channelsCount << ", "
+                    LOG_LITE_INFO (logObj) << "\t" << ALIGN_AND_PAD_S << idx                       << ", "
+                                                   << ALIGN_AND_PAD_S << textureInfo.width         << ", "
+                                                   << ALIGN_AND_PAD_S << textureInfo.height        << ", "
+                                                   << ALIGN_AND_PAD_S << textureInfo.channelsCount << ", "
+                                                   << ALIGN_AND_PAD_S << textureInfo.mipLevels     << ", "
+                                                   << string_VkFormat (textureInfo.format)         << ", "
                                                    << path            << std::endl;
                 }
-                LOG_LITE_INFO (logObj)     << "}"                     << std::endl;
+                LOG_LITE_INFO (logObj)     << "}"                       << std::endl;
+
+                LOG_LITE_INFO (logObj)     << "{"                       << std::endl;
+                for (auto const& [arrayIdx, textureIdxs]: meta.arrayIdxToTextureIdxsMap) {
+                    LOG_LITE_INFO (logObj) << "\t" << ALIGN_AND_PAD_S << arrayIdx                  << ", ";
+                    for (auto const& idx: textureIdxs)
+                        LOG_LITE_INFO (logObj) << idx << " ";
+                    LOG_LITE_INFO (logObj) << std::endl;
+                }
+                LOG_LITE_INFO (logObj)     << "}"                       << std::endl;
             }
 
             ~SBTexturePool (void) {
+                /* Pending jobs hold a pointer to the pool, so they have to finish before it goes away */
+                for (auto const& [idx, imageInfoFuture]: m_texturePoolInfo.meta.idxToImageInfoFutureMap)
+                    imageInfoFuture.wait();
                 delete m_texturePoolInfo.resource.logObj;
             }
     };
@@ -0,0 +1,265 @@
+#pragma once
+#include "../Backend/Common.h"
+#include "../Backend/Log/LGImpl.h"
+#include "SBTextureCodec.h"
+/* Decides which mip levels of each texture are resident on the device. Only the levels from a base level down to the
+ * smallest one are resident at any time, and a texture starts out with just its tail (the levels that fit in
+ * minResidentExtent texels), so that the first frames only wait on a few small uploads. Every frame, the batching
+ * systems report the size (in pixels) that a texture covers on screen, which picks the level that would be sampled at
+ * that size. Textures that want more levels are raised within the device memory budget, by trimming the least recently
+ * used textures back to their tail (or to the level they are currently requested at). Note that, this only plans the
+ * changes, the renderer re-creates the images and reports back once a change has been made (see updateBaseMipLevel)
+*/
+namespace SandBox {
+    class SBTextureResidency {
+        private:
+            struct TextureInfo {
+                int width;
+                int height;
+                uint32_t mipLevels;
+                VkFormat format;
+                /* Levels [baseMipLevel, mipLevels) are resident */
+                uint32_t baseMipLevel;
+                uint32_t tailMipLevel;
+                uint32_t requestedMipLevel;
+                uint64_t lastRequestedFrameIdx;
+                /* Textures that can't be re-loaded from the host are kept fully resident */
+                bool streamingDisabled;
+            };
+
+            struct TextureResidencyInfo {
+                struct Meta {
+                    std::map <uint32_t, TextureInfo> idxToTextureInfoMap;
+                    VkDeviceSize budgetSize;
+                    VkDeviceSize residentSize;
+                    uint32_t minResidentExtent;
+                    uint32_t maxChangesPerFrame;
+                    uint64_t frameIdx;
+                } meta;
+
+                struct Resource {
+                    Log::LGImpl* logObj;
+                } resource;
+            } m_textureResidencyInfo;
+
+            TextureInfo& getTextureInfo (const uint32_t textureIdx) {
+                auto& idxToTextureInfoMap = m_textureResidencyInfo.meta.idxToTextureInfoMap;
+                if (idxToTextureInfoMap.find (textureIdx) == idxToTextureInfoMap.end()) {
+                    LOG_ERROR (m_textureResidencyInfo.resource.logObj) << "Texture info does not exist"
+                                                                       << " "
+                                                                       << "[" << textureIdx << "]"
+                                                                       << std::endl;
+                    throw std::runtime_error ("Texture info does not exist");
+                }
+                return idxToTextureInfoMap[textureIdx];
+            }
+
+            /* Size of levels [baseMipLevel, mipLevels). Note that, this doesn't account for the alignment and padding
+             * of the device allocation, so the budget is an estimate of the memory used
+            */
+            VkDeviceSize getResidentSize (const TextureInfo& textureInfo, const uint32_t baseMipLevel) {
+                VkDeviceSize residentSize = 0;
+                for (uint32_t i = baseMipLevel; i < textureInfo.mipLevels; i++)
+                    residentSize += getImageSize (textureInfo.format,
+                                                  std::max (textureInfo.width  >> i, 1),
+                                                  std::max (textureInfo.height >> i, 1));
+                return residentSize;
+            }
+
+            /* A texture that covers N pixels on screen is sampled at the level whose larger dimension is closest to
+             * N, anything finer than that is never read
+            */
+            uint32_t getTargetMipLevel (const TextureInfo& textureInfo, const float screenSize) {
+                float maxExtent = static_cast <float> (std::max (textureInfo.width, textureInfo.height));
+                if (screenSize <= 1.0f)
+                    return textureInfo.tailMipLevel;
+
+                float level     = std::floor (std::log2 (maxExtent / screenSize));
+                return std::min (static_cast <uint32_t> (std::max (level, 0.0f)), textureInfo.tailMipLevel);
+            }
+
+        public:
+            SBTextureResidency (void) {
+                m_textureResidencyInfo = {};
+
+                auto& logObj = m_textureResidencyInfo.resource.logObj;
+                logObj       = new Log::LGImpl();
+                logObj->initLogInfo     ("Build/Log/SandBox",     __FILE__);
+                logObj->updateLogConfig (Log::LEVEL_TYPE_INFO,    Log::SINK_TYPE_FILE);
+                logObj->updateLogConfig (Log::LEVEL_TYPE_WARNING, Log::SINK_TYPE_CONSOLE | Log::SINK_TYPE_FILE);
+                logObj->updateLogConfig (Log::LEVEL_TYPE_ERROR,   Log::SINK_TYPE_CONSOLE | Log::SINK_TYPE_FILE);
+            }
+
+            /* The budget only covers the textures added here. Changes per frame are capped, since each one costs an
+             * image re-creation and upload
+            */
+            void initTextureResidencyInfo (const VkDeviceSize budgetSize,
+                                           const uint32_t minResidentExtent,
+                                           const uint32_t maxChangesPerFrame) {
+                auto& meta               = m_textureResidencyInfo.meta;
+                meta.idxToTextureInfoMap = {};
+                meta.budgetSize          = budgetSize;
+                meta.residentSize        = 0;
+                meta.minResidentExtent   = std::max (minResidentExtent,  1u);
+                meta.maxChangesPerFrame  = std::max (maxChangesPerFrame, 1u);
+                meta.frameIdx            = 0;
+            }
+
+            /* Returns the base level that the texture starts out with */
+            uint32_t addTexture (const uint32_t textureIdx,
+                                 const int width,
+                                 const int height,
+                                 const uint32_t mipLevels,
+                                 const VkFormat format,
+                                 const bool streamingDisabled) {
+                auto& meta = m_textureResidencyInfo.meta;
+                if (meta.idxToTextureInfoMap.find (textureIdx) != meta.idxToTextureInfoMap.end())
+                    return meta.idxToTextureInfoMap[textureIdx].baseMipLevel;
+
+                TextureInfo textureInfo;
+                textureInfo.width                 = width;
+                textureInfo.height                = height;
+                textureInfo.mipLevels             = mipLevels;
+                textureInfo.format                = format;
+                textureInfo.tailMipLevel          = 0;
+                while (textureInfo.tailMipLevel + 1 < mipLevels &&
+                       static_cast <uint32_t> (std::max (width >> textureInfo.tailMipLevel,
+                                                         height >> textureInfo.tailMipLevel)) > meta.minResidentExtent)
+                    textureInfo.tailMipLevel++;
+
+                if (streamingDisabled)
+                    textureInfo.tailMipLevel      = 0;
+                textureInfo.baseMipLevel          = textureInfo.tailMipLevel;
+                textureInfo.requestedMipLevel     = textureInfo.tailMipLevel;
+                textureInfo.lastRequestedFrameIdx = 0;
+                textureInfo.streamingDisabled     = streamingDisabled;
+
+                meta.residentSize                += getResidentSize (textureInfo, textureInfo.baseMipLevel);
+                meta.idxToTextureInfoMap[textureIdx] = textureInfo;
+                return textureInfo.baseMipLevel;
+            }
+
+            uint32_t getBaseMipLevel (const uint32_t textureIdx) {
+                return getTextureInfo (textureIdx).baseMipLevel;
+            }
+
+            /* Called by the batching systems, once per texture and instance that uses it. The finest level requested
+             * in a frame wins
+            */
+            void requestTexture (const uint32_t textureIdx, const float screenSize) {
+                auto& meta = m_textureResidencyInfo.meta;
+                if (meta.idxToTextureInfoMap.find (textureIdx) == meta.idxToTextureInfoMap.end())
+                    return;
+
+                auto& textureInfo  = meta.idxToTextureInfoMap[textureIdx];
+                uint32_t mipLevel  = getTargetMipLevel (textureInfo, screenSize);
+                if (textureInfo.lastRequestedFrameIdx != meta.frameIdx) {
+                    textureInfo.requestedMipLevel     = mipLevel;
+                    textureInfo.lastRequestedFrameIdx = meta.frameIdx;
+                }
+                else
+                    textureInfo.requestedMipLevel     = std::min (textureInfo.requestedMipLevel, mipLevel);
+            }
+
+            /* Plan the changes for this frame (texture idx to new base level) and move on to the next frame. Textures
+             * requested this frame that want more levels are raised, the most under-resident first. To make room,
+             * textures are trimmed in least recently used order, where those that weren't requested this frame drop
+             * back to their tail and those that were only lose the levels that they no longer need
+            */
+            std::map <uint32_t, uint32_t> getResidencyChanges (void) {
+                auto& meta                = m_textureResidencyInfo.meta;
+                auto idxToBaseMipLevelMap = std::map <uint32_t, uint32_t> {};
+                auto residentSize         = meta.residentSize;
+
+                std::vector <uint32_t> raiseCandidates;
+                std::vector <uint32_t> trimCandidates;
+                for (auto const& [idx, info]: meta.idxToTextureInfoMap) {
+                    if (info.streamingDisabled)
+                        continue;
+                    bool requested = info.lastRequestedFrameIdx == meta.frameIdx;
+                    if (requested && info.requestedMipLevel < info.baseMipLevel)
+                        raiseCandidates.push_back (idx);
+                    else if ((!requested && info.baseMipLevel < info.tailMipLevel) ||
+                             ( requested && info.baseMipLevel < info.requestedMipLevel))
+                        trimCandidates.push_back  (idx);
+                }
+                std::stable_sort (raiseCandidates.begin(), raiseCandidates.end(), [&meta](uint32_t a, uint32_t b) {
+                    auto& infoA = meta.idxToTextureInfoMap[a];
+                    auto& infoB = meta.idxToTextureInfoMap[b];
+                    return infoA.baseMipLevel - infoA.requestedMipLevel > infoB.baseMipLevel - infoB.requestedMipLevel;
+                });
+                std::stable_sort (trimCandidates.begin(),  trimCandidates.end(),  [&meta](uint32_t a, uint32_t b) {
+                    return meta.idxToTextureInfoMap[a].lastRequestedFrameIdx <
+                           meta.idxToTextureInfoMap[b].lastRequestedFrameIdx;
+                });
+
+                auto trimCandidate = trimCandidates.begin();
+                for (auto const& idx: raiseCandidates) {
+                    auto& info        = meta.idxToTextureInfoMap[idx];
+                    auto currentSize  = getResidentSize (info, info.baseMipLevel);
+                    auto mipLevel     = info.requestedMipLevel;
+
+                    while (residentSize - currentSize + getResidentSize (info, mipLevel) > meta.budgetSize &&
+                           trimCandidate != trimCandidates.end() &&
+                           idxToBaseMipLevelMap.size() + 1 < meta.maxChangesPerFrame) {
+
+                        auto& trimInfo    = meta.idxToTextureInfoMap[*trimCandidate];
+                        auto trimMipLevel = trimInfo.lastRequestedFrameIdx == meta.frameIdx ?
+                                            trimInfo.requestedMipLevel: trimInfo.tailMipLevel;
+                        residentSize     -= getResidentSize (trimInfo, trimInfo.baseMipLevel) -
+                                            getResidentSize (trimInfo, trimMipLevel);
+                        idxToBaseMipLevelMap[*trimCandidate++] = trimMipLevel;
+                    }
+                    /* Settle for a coarser level if the budget is still short */
+                    while (mipLevel < info.baseMipLevel &&
+                           residentSize - currentSize + getResidentSize (info, mipLevel) > meta.budgetSize)
+                        mipLevel++;
+
+                    if (mipLevel < info.baseMipLevel && idxToBaseMipLevelMap.size() < meta.maxChangesPerFrame) {
+                        residentSize += getResidentSize (info, mipLevel) - currentSize;
+                        idxToBaseMipLevelMap[idx] = mipLevel;
+                    }
+                    if (idxToBaseMipLevelMap.size() >= meta.maxChangesPerFrame)
+                        break;
+                }
+
+                meta.frameIdx++;
+                return idxToBaseMipLevelMap;
+            }
+
+            /* Record a change once the image has been re-created with the new base level */
+            void updateBaseMipLevel (const uint32_t textureIdx, const uint32_t baseMipLevel) {
+                auto& meta               = m_textureResidencyInfo.meta;
+                auto& textureInfo        = getTextureInfo (textureIdx);
+
+                meta.residentSize       -= getResidentSize (textureInfo, textureInfo.baseMipLevel);
+                meta.residentSize       += getResidentSize (textureInfo, baseMipLevel);
+                textureInfo.baseMipLevel = baseMipLevel;
+            }
+
+            /* Keep the texture at its current base level from here on */
+            void disableStreaming (const uint32_t textureIdx) {
+                getTextureInfo (textureIdx).streamingDisabled = true;
+            }
+
+            void generateReport (void) {
+                auto& meta   = m_textureResidencyInfo.meta;
+                auto& logObj = m_textureResidencyInfo.resource.logObj;
+
+                LOG_LITE_INFO (logObj)     << "{"                                                   << std::endl;
+                for (auto const& [idx, info]: meta.idxToTextureInfoMap)
+                    LOG_LITE_INFO (logObj) << "\t" << ALIGN_AND_PAD_S << idx                        << ", "
+                                                   << ALIGN_AND_PAD_S << info.baseMipLevel          << ", "
+                                                   << ALIGN_AND_PAD_S << info.tailMipLevel          << ", "
+                                                   << ALIGN_AND_PAD_S << info.requestedMipLevel     << ", "
+                                                   << ALIGN_AND_PAD_S << info.lastRequestedFrameIdx << ", "
+                                                   << (info.streamingDisabled ? "true": "false")    << std::endl;
+                LOG_LITE_INFO (logObj)     << "\t" << meta.residentSize << "/" << meta.budgetSize   << std::endl;
+                LOG_LITE_INFO (logObj)     << "}"                                                   << std::endl;
+            }
+
+            ~SBTextureResidency (void) {
+                delete m_textureResidencyInfo.resource.logObj;
+            }
+    };
+}   // namespace SandBox
\ No newline at end of file
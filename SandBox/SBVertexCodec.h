@@ -0,0 +1,149 @@
+#pragma once
+#include "../Backend/Common.h"
+#include "SBRendererType.h"
+/* CPU encoder/decoder for the packed vertex layout that std meshes are uploaded in
+ *
+ *  uv          IEEE half floats (round to nearest even), texture coordinates outside [0, 1] are kept as is
+ *  normal      octahedral encoding, the unit normal is projected onto the octahedron |x| + |y| + |z| = 1 and the
+ *              lower half is folded over the diagonals, leaving 2 signed normalized components
+ *  position    16 bit unsigned normalized per axis, over the bounds of the mesh. The hardware returns the quantized
+ *              position in [0, 1], which the dequantization matrix maps back to model space
+ *  material    16 bit unsigned integer, the material idx of the vertex offset to the material table
+*/
+namespace SandBox {
+    uint16_t getHalf (const float value) {
+        uint32_t bits;
+        std::memcpy (&bits, &value, sizeof (bits));
+        uint32_t sign     = (bits >> 16) & 0x8000;
+        uint32_t mantissa =  bits        & 0x7FFFFF;
+        int32_t exponent  = static_cast <int32_t> ((bits >> 23) & 0xFF) - 127 + 15;
+        /* Inf and NaN */
+        if (((bits >> 23) & 0xFF) == 0xFF)
+            return static_cast <uint16_t> (sign | 0x7C00 | (mantissa != 0 ? 0x200: 0));
+        if (exponent >= 31)
+            return static_cast <uint16_t> (sign | 0x7C00);
+        /* Denormals, along with values too small for them */
+        if (exponent <= 0) {
+            if (exponent < -10)
+                return static_cast <uint16_t> (sign);
+
+            mantissa         |= 0x800000;
+            uint32_t shift    = static_cast <uint32_t> (14 - exponent);
+            uint32_t half     = mantissa >> shift;
+            uint32_t rest     = mantissa & ((1u << shift) - 1);
+            uint32_t halfway  = 1u << (shift - 1);
+            if (rest > halfway || (rest == halfway && (half & 1) != 0))
+                ++half;
+            return static_cast <uint16_t> (sign | half);
+        }
+        /* A carry out of the mantissa rounds up into the exponent, which is the correct result */
+        uint32_t half     = (static_cast <uint32_t> (exponent) << 10) | (mantissa >> 13);
+        uint32_t rest     = mantissa & 0x1FFF;
+        if (rest > 0x1000 || (rest == 0x1000 && (half & 1) != 0))
+            ++half;
+        return static_cast <uint16_t> (sign | half);
+    }
+
+    float getFloat (const uint16_t half) {
+        uint32_t sign     = static_cast <uint32_t> (half & 0x8000) << 16;
+        uint32_t exponent = (half >> 10) & 0x1F;
+        uint32_t mantissa =  half        & 0x3FF;
+        uint32_t bits;
+        if (exponent == 0x1F)
+            bits          = sign | 0x7F800000 | (mantissa << 13);
+        else if (exponent != 0)
+            bits          = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+        else if (mantissa == 0)
+            bits          = sign;
+        else {
+            /* Normalize the denormal */
+            exponent      = 127 - 15 + 1;
+            while ((mantissa & 0x400) == 0) {
+                mantissa <<= 1;
+                --exponent;
+            }
+            bits          = sign | (exponent << 23) | ((mantissa & 0x3FF) << 13);
+        }
+        float value;
+        std::memcpy (&value, &bits, sizeof (value));
+        return value;
+    }
+
+    void getOctahedral (const glm::vec3& normal, int16_t* encoded) {
+        float length = std::abs (normal.x) + std::abs (normal.y) + std::abs (normal.z);
+        float x      = length > 0.0f ? normal.x / length: 0.0f;
+        float y      = length > 0.0f ? normal.y / length: 0.0f;
+        if (normal.z < 0.0f) {
+            float foldedX = (1.0f - std::abs (y)) * (x >= 0.0f ? 1.0f: -1.0f);
+            float foldedY = (1.0f - std::abs (x)) * (y >= 0.0f ? 1.0f: -1.0f);
+            x             = foldedX;
+            y             = foldedY;
+        }
+        encoded[0]   = static_cast <int16_t> (std::round (std::clamp (x, -1.0f, 1.0f) * 32767.0f));
+        encoded[1]   = static_cast <int16_t> (std::round (std::clamp (y, -1.0f, 1.0f) * 32767.0f));
+    }
+
+    /* Matches the decode in the vertex shaders */
+    glm::vec3 getNormal (const int16_t* encoded) {
+        glm::vec3 normal;
+        normal.x     = std::max (encoded[0] / 32767.0f, -1.0f);
+        normal.y     = std::max (encoded[1] / 32767.0f, -1.0f);
+        normal.z     = 1.0f - std::abs (normal.x) - std::abs (normal.y);
+        float t      = std::max (-normal.z, 0.0f);
+        normal.x    += normal.x >= 0.0f ? -t: t;
+        normal.y    += normal.y >= 0.0f ? -t: t;
+        return glm::normalize (normal);
+    }
+
+    /* Flat axes (a plane, for example) would otherwise divide by zero */
+    glm::vec3 getQuantizationExtent (const glm::vec3& minPosition, const glm::vec3& maxPosition) {
+        glm::vec3 extent = maxPosition - minPosition;
+        for (uint32_t i = 0; i < 3; i++)
+            extent[i]    = extent[i] > 0.0f ? extent[i]: 1.0f;
+        return extent;
+    }
+
+    /* Maps a quantized position in [0, 1] back to model space, applied before the model matrix */
+    glm::mat4 getDequantizationMatrix (const glm::vec3& minPosition, const glm::vec3& maxPosition) {
+        return glm::scale (glm::translate (glm::mat4 (1.0f), minPosition),
+                           getQuantizationExtent (minPosition, maxPosition));
+    }
+
+    /* Returns false if the material idx (in the material table) doesn't fit in 16 bits */
+    bool packVertex (const Vertex& vertex,
+                     const glm::vec3& minPosition,
+                     const glm::vec3& maxPosition,
+                     const uint32_t firstMaterialIdx,
+                     PackedVertex& packedVertex) {
+
+        glm::vec3 extent = getQuantizationExtent (minPosition, maxPosition);
+        packedVertex.meta.uv[0] = getHalf (vertex.meta.uv.x);
+        packedVertex.meta.uv[1] = getHalf (vertex.meta.uv.y);
+        getOctahedral (vertex.meta.normal, packedVertex.meta.normal);
+        for (uint32_t i = 0; i < 3; i++) {
+            float value = (vertex.meta.position[i] - minPosition[i]) / extent[i];
+            packedVertex.meta.position[i] = static_cast <uint16_t> (std::clamp (value, 0.0f, 1.0f) * 65535.0f + 0.5f);
+        }
+
+        uint32_t materialIdx = firstMaterialIdx + vertex.materialIdx;
+        if (materialIdx > std::numeric_limits <uint16_t>::max())
+            return false;
+        packedVertex.materialIdx = static_cast <uint16_t> (materialIdx);
+        return true;
+    }
+
+    /* The material idx of the unpacked vertex is into the material table, rather than the materials of the mesh */
+    Vertex unpackVertex (const PackedVertex& packedVertex,
+                         const glm::vec3& minPosition,
+                         const glm::vec3& maxPosition) {
+
+        glm::vec3 extent = getQuantizationExtent (minPosition, maxPosition);
+        Vertex vertex;
+        vertex.meta.uv       = {getFloat (packedVertex.meta.uv[0]), getFloat (packedVertex.meta.uv[1])};
+        vertex.meta.normal   = getNormal (packedVertex.meta.normal);
+        for (uint32_t i = 0; i < 3; i++)
+            vertex.meta.position[i] = minPosition[i] + packedVertex.meta.position[i] / 65535.0f * extent[i];
+        vertex.materialIdx   = packedVertex.materialIdx;
+        return vertex;
+    }
+}   // namespace SandBox
\ No newline at end of file
@@ -2,11 +2,35 @@
 #extension GL_EXT_nonuniform_qualifier: require
 
 layout (location = 0)      in  vec2 i_uv;
-layout (location = 1) flat in  uint i_diffuseTextureIdx;
+layout (location = 1) flat in  uint i_materialIdx;
+layout (location = 2) flat in  uint i_instanceIdx;
 layout (location = 0)      out vec4 o_color;
 
+struct MeshInstanceSBO {
+    mat4 modelMatrix;       /* Unused */
+    mat4 normalMatrix;      /* Unused */
+    int textureIdxOffsets[3];
+};
+
+struct MaterialSBO {
+    uint diffuseTextureIdx;
+    uint specularTextureIdx;        /* Unused */
+    uint emissionTextureIdx;        /* Unused */
+    uint shininess;                 /* Unused */
+};
+
+layout (set = 0, binding = 0) readonly buffer MeshInstanceSBOContainer {
+    MeshInstanceSBO instances[];
+} meshInstanceSBOContainer;
+
+layout (set = 0, binding = 1) readonly buffer MaterialSBOContainer {
+    MaterialSBO materials[];
+} materialSBOContainer;
+
 layout (set = 1, binding = 0) uniform sampler2D defaultSamplers[];
 
 void main (void) {
-    o_color = texture (defaultSamplers[i_diffuseTextureIdx], i_uv);
+    uint diffuseTextureIdx = materialSBOContainer.materials[i_materialIdx].diffuseTextureIdx +
+                             meshInstanceSBOContainer.instances[i_instanceIdx].textureIdxOffsets[0];
+    o_color = texture (defaultSamplers[diffuseTextureIdx], i_uv);
 }
\ No newline at end of file
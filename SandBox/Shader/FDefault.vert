@@ -2,15 +2,16 @@
 
 layout (location = 0) in  vec2 i_uv;
 layout (location = 1) in  vec3 i_position;
-layout (location = 2) in  uint i_diffuseTextureIdx;
+layout (location = 2) in  uint i_materialIdx;
 
 layout (location = 0) out vec2 o_uv;
-layout (location = 1) out uint o_diffuseTextureIdx;
+layout (location = 1) out uint o_materialIdx;
+layout (location = 2) out uint o_instanceIdx;
 
 struct MeshInstanceSBO {
     mat4 modelMatrix;
     mat4 normalMatrix;      /* Unused */
-    int textureIdxOffsets[3];
+    int textureIdxOffsets[3];   /* Unused */
 };
 
 layout (set = 0, binding = 0) readonly buffer MeshInstanceSBOContainer {
@@ -30,6 +31,6 @@ void main (void) {
                           vec4 (i_position, 1.0);
 
     o_uv                = i_uv;
-    o_diffuseTextureIdx = i_diffuseTextureIdx +
-                          meshInstanceSBOContainer.instances[gl_InstanceIndex].textureIdxOffsets[0];
+    o_materialIdx       = i_materialIdx;
+    o_instanceIdx       = gl_InstanceIndex;
 }
\ No newline at end of file
@@ -4,10 +4,8 @@
 layout (location = 0)      in  vec2 i_uv;
 layout (location = 1)      in  vec4 i_normal;
 layout (location = 2)      in  vec4 i_position;
-layout (location = 3) flat in  uint i_diffuseTextureIdx;
-layout (location = 4) flat in  uint i_specularTextureIdx;
-layout (location = 5) flat in  uint i_emissionTextureIdx;
-layout (location = 6) flat in  uint i_shininess;
+layout (location = 3) flat in  uint i_materialIdx;
+layout (location = 4) flat in  uint i_instanceIdx;
 
 layout (location = 0)      out vec4 o_normal;
 layout (location = 1)      out vec4 o_position;
@@ -15,17 +13,44 @@ layout (location = 2)      out vec4 o_color0;
 layout (location = 3)      out vec4 o_color1;
 layout (location = 4)      out vec4 o_color2;
 
+struct MeshInstanceSBO {
+    mat4 modelMatrix;       /* Unused */
+    mat4 normalMatrix;      /* Unused */
+    int textureIdxOffsets[3];
+};
+
+struct MaterialSBO {
+    uint diffuseTextureIdx;
+    uint specularTextureIdx;
+    uint emissionTextureIdx;
+    uint shininess;
+};
+
+layout (set = 0, binding = 0) readonly buffer MeshInstanceSBOContainer {
+    MeshInstanceSBO instances[];
+} meshInstanceSBOContainer;
+
+layout (set = 0, binding = 1) readonly buffer MaterialSBOContainer {
+    MaterialSBO materials[];
+} materialSBOContainer;
+
 layout (set = 1, binding = 0) uniform sampler2D defaultSamplers[];
 
 const float MIN_SHININESS = 32.0;
 const float MAX_SHININESS = 128.0;
 
 void main (void) {
+    MaterialSBO material     = materialSBOContainer.materials[i_materialIdx];
+    int textureIdxOffsets[3] = meshInstanceSBOContainer.instances[i_instanceIdx].textureIdxOffsets;
+    uint diffuseTextureIdx   = material.diffuseTextureIdx  + textureIdxOffsets[0];
+    uint specularTextureIdx  = material.specularTextureIdx + textureIdxOffsets[1];
+    uint emissionTextureIdx  = material.emissionTextureIdx + textureIdxOffsets[2];
+
     o_normal     = i_normal;
     o_position   = i_position;
-    o_color0     = texture (defaultSamplers[i_diffuseTextureIdx],  i_uv);
-    o_color1     = texture (defaultSamplers[i_specularTextureIdx], i_uv);
-    o_color2.rgb = texture (defaultSamplers[i_emissionTextureIdx], i_uv).rgb;
+    o_color0     = texture (defaultSamplers[diffuseTextureIdx],  i_uv);
+    o_color1     = texture (defaultSamplers[specularTextureIdx], i_uv);
+    o_color2.rgb = texture (defaultSamplers[emissionTextureIdx], i_uv).rgb;
     /* Normalize shininess */
-    o_color2.a   = (i_shininess - MIN_SHININESS) / (MAX_SHININESS - MIN_SHININESS);
+    o_color2.a   = (material.shininess - MIN_SHININESS) / (MAX_SHININESS - MIN_SHININESS);
 }
\ No newline at end of file
@@ -1,25 +1,20 @@
 #version 450
 
 layout (location = 0) in  vec2 i_uv;
-layout (location = 1) in  vec3 i_normal;
+layout (location = 1) in  vec2 i_normal;
 layout (location = 2) in  vec3 i_position;
-layout (location = 3) in  uint i_diffuseTextureIdx;
-layout (location = 4) in  uint i_specularTextureIdx;
-layout (location = 5) in  uint i_emissionTextureIdx;
-layout (location = 6) in  uint i_shininess;
+layout (location = 3) in  uint i_materialIdx;
 
 layout (location = 0) out vec2 o_uv;
 layout (location = 1) out vec4 o_normal;
 layout (location = 2) out vec4 o_position;
-layout (location = 3) out uint o_diffuseTextureIdx;
-layout (location = 4) out uint o_specularTextureIdx;
-layout (location = 5) out uint o_emissionTextureIdx;
-layout (location = 6) out uint o_shininess;
+layout (location = 3) out uint o_materialIdx;
+layout (location = 4) out uint o_instanceIdx;
 
 struct MeshInstanceSBO {
     mat4 modelMatrix;
     mat4 normalMatrix;
-    int textureIdxOffsets[3];
+    int textureIdxOffsets[3];   /* Unused */
 };
 
 layout (set = 0, binding = 0) readonly buffer MeshInstanceSBOContainer {
@@ -32,6 +27,15 @@ layout (push_constant) uniform ActiveCameraPC {
     mat4 projectionMatrix;
 } activeCamera;
 
+/* Normals are octahedral encoded, see SBVertexCodec */
+vec3 decodeNormal (vec2 encoded) {
+    vec3 normal = vec3 (encoded, 1.0 - abs (encoded.x) - abs (encoded.y));
+    float t     = max (-normal.z, 0.0);
+    normal.x   += normal.x >= 0.0 ? -t: t;
+    normal.y   += normal.y >= 0.0 ? -t: t;
+    return normalize (normal);
+}
+
 void main (void) {
     gl_Position          = activeCamera.projectionMatrix *
                            activeCamera.viewMatrix       *
@@ -56,7 +60,7 @@ void main (void) {
      * the normal matrix
     */
     o_normal             = normalize (meshInstanceSBOContainer.instances[gl_InstanceIndex].normalMatrix *
-                           vec4 (i_normal, 0.0));
+                           vec4 (decodeNormal (i_normal), 0.0));
     /* Since we're going to do all the lighting calculations in world space, we want a vertex position for the fragment
      * that is in world space first. We can accomplish this by multiplying the vertex position with the model matrix only
      * (not the view and projection matrix) to transform it to world space coordinates, which can easily be accomplished
@@ -65,11 +69,9 @@ void main (void) {
     */
     o_position           = meshInstanceSBOContainer.instances[gl_InstanceIndex].modelMatrix *
                            vec4 (i_position, 1.0);
-    o_diffuseTextureIdx  = i_diffuseTextureIdx  +
-                           meshInstanceSBOContainer.instances[gl_InstanceIndex].textureIdxOffsets[0];
-    o_specularTextureIdx = i_specularTextureIdx +
-                           meshInstanceSBOContainer.instances[gl_InstanceIndex].textureIdxOffsets[1];
-    o_emissionTextureIdx = i_emissionTextureIdx +
-                           meshInstanceSBOContainer.instances[gl_InstanceIndex].textureIdxOffsets[2];
-    o_shininess          = i_shininess;
+    /* The material (and the texture idx offsets of the instance) are looked up in the fragment shader, which only
+     * needs these 2 flat values
+    */
+    o_materialIdx        = i_materialIdx;
+    o_instanceIdx        = gl_InstanceIndex;
 }
\ No newline at end of file
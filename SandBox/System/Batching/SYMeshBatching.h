@@ -6,15 +6,61 @@
 #include "../../../Backend/Scene/SNType.h"
 #include "../../SBComponentType.h"
 #include "../../SBRendererType.h"
+#include "../../SBMeshPool.h"
+#include "../../SBVertexCodec.h"
 
 namespace SandBox {
+    /* Geometry export file layout, one section per batched tag type
+     *  +-----------+-----------+-----------+-----------+
+     *  |  Header   |  Meshes   | Vertices  |  Indices  |   ...
+     *  +-----------+-----------+-----------+-----------+
+     *
+     *  Header      magic, version, tag type, counts, vertex size, indices size (in bytes)
+     *  Meshes      GeometryExportMeshInfo array, the range of each mesh in the vertices and indices
+     *  Vertices    Vertex array, or PackedVertex array for the packed tag types (see SBVertexCodec)
+     *  Indices     IndexType array, or the packed indices (16 bit ranges followed by the 32 bit ranges) for the packed
+     *              tag types
+     *
+     * The vertices and indices are written as batched, packed vertices included, which are dequantized with the bounds
+     * of their mesh in the meshes section. The packed positions (position only stream of the packed tag types) are
+     * left out, since they repeat the positions of the packed vertices
+    */
+    const char* g_geometryExportFileMagic      = "GEO1";
+    const uint32_t g_geometryExportFileVersion = 1;
+
     class SYMeshBatching: public Scene::SNSystemBase {
         private:
+            struct GeometryExportHeader {
+                char magic[4];
+                uint32_t version;
+                uint32_t tagType;
+                uint32_t meshesCount;
+                uint32_t verticesCount;
+                uint32_t vertexSize;
+                uint64_t indicesSize;
+            };
+
+            /* The first index offset is in bytes from the start of the indices, the indices count is of the full
+             * resolution level (the levels of detail follow it)
+            */
+            struct GeometryExportMeshInfo {
+                uint32_t meshIdx;
+                int32_t vertexOffset;
+                uint64_t firstIndexOffset;
+                uint32_t indicesCount;
+                uint32_t indexSize;
+                float minPosition[3];
+                float maxPosition[3];
+            };
+
             struct OffsetInfo {
                 uint32_t verticesCountPerPrimitive;
                 uint32_t firstIndexIdx;
                 uint32_t indicesCount;
                 int32_t vertexOffset;
+                uint32_t meshIdx;
+                /* The first index idx of a packed mesh counts from the start of the 16 or 32 bit index ranges */
+                VkIndexType indexType;
             };
 
             struct MeshBatchingInfo {
@@ -25,14 +71,55 @@ namespace SandBox {
 
                     std::unordered_map <e_tagType, std::vector <Vertex>> tagTypeToVerticesMap;
                     std::unordered_map <e_tagType, std::vector <IndexType>> tagTypeToIndicesMap;
+                    std::unordered_map <e_tagType, std::vector <PackedVertex>> tagTypeToPackedVerticesMap;
+                    std::unordered_map <e_tagType, std::vector <PackedPosition>> tagTypeToPackedPositionsMap;
+                    /* 16 bit index ranges followed by the 32 bit index ranges (aligned to 4 bytes) */
+                    std::unordered_map <e_tagType, std::vector <uint8_t>> tagTypeToPackedIndicesMap;
+                    /* Range of each mesh in the batched vertices and indices, per tag type */
+                    std::unordered_map <e_tagType, std::unordered_map <uint32_t, OffsetInfo>> tagTypeToOffsetInfosMap;
+                    /* Time taken (in milliseconds) by the last update */
+                    float batchingTime;
                 } meta;
 
                 struct Resource {
                     Scene::SNImpl* sceneObj;
                     Log::LGImpl* logObj;
+                    SBMeshPool* meshPoolObj;
                 } resource;
             } m_meshBatchingInfo;
 
+            /* Std meshes are batched packed (see SBVertexCodec), the other tag types keep the imported layout */
+            bool isPackedTagType (const e_tagType tagType) {
+                return tagType == TAG_TYPE_STD_NO_ALPHA || tagType == TAG_TYPE_STD_ALPHA;
+            }
+
+            void packVertices (const SBMeshPool::MeshInfo& meshInfo,
+                               std::vector <PackedVertex>& packedVertices,
+                               std::vector <PackedPosition>& packedPositions) {
+
+                for (auto const& vertex: meshInfo.vertices) {
+                    PackedVertex packedVertex;
+                    if (!packVertex (vertex,
+                                     meshInfo.minPosition,
+                                     meshInfo.maxPosition,
+                                     meshInfo.firstMaterialIdx,
+                                     packedVertex)) {
+                        LOG_ERROR (m_meshBatchingInfo.resource.logObj) << "Material idx exceeds 16 bits"
+                                                                       << " "
+                                                                       << "[" << meshInfo.key << "]"
+                                                                       << std::endl;
+                        throw std::runtime_error ("Material idx exceeds 16 bits");
+                    }
+                    packedVertices.push_back  (packedVertex);
+                    packedPositions.push_back ({
+                        packedVertex.meta.position[0],
+                        packedVertex.meta.position[1],
+                        packedVertex.meta.position[2],
+                        0
+                    });
+                }
+            }
+
         public:
             SYMeshBatching (void) {
                 m_meshBatchingInfo = {};
@@ -45,21 +132,27 @@ namespace SandBox {
                 logObj->updateLogConfig (Log::LEVEL_TYPE_ERROR,   Log::SINK_TYPE_CONSOLE | Log::SINK_TYPE_FILE);
             }
 
-            void initMeshBatchingInfo (Scene::SNImpl* sceneObj) {
-                auto& meta                 = m_meshBatchingInfo.meta;
-                auto& resource             = m_meshBatchingInfo.resource;
+            void initMeshBatchingInfo (Scene::SNImpl* sceneObj, SBMeshPool* meshPoolObj) {
+                auto& meta                       = m_meshBatchingInfo.meta;
+                auto& resource                   = m_meshBatchingInfo.resource;
 
-                meta.entityToOffsetInfoMap = {};
-                meta.tagTypeToEntitiesMap  = {};
-                meta.tagTypeToVerticesMap  = {};
-                meta.tagTypeToIndicesMap   = {};
+                meta.entityToOffsetInfoMap       = {};
+                meta.tagTypeToEntitiesMap        = {};
+                meta.tagTypeToVerticesMap        = {};
+                meta.tagTypeToIndicesMap         = {};
+                meta.tagTypeToPackedVerticesMap  = {};
+                meta.tagTypeToPackedPositionsMap = {};
+                meta.tagTypeToPackedIndicesMap   = {};
+                meta.tagTypeToOffsetInfosMap     = {};
+                meta.batchingTime                = 0.0f;
 
-                if (sceneObj == nullptr) {
+                if (sceneObj == nullptr || meshPoolObj == nullptr) {
                     LOG_ERROR (resource.logObj) << NULL_DEPOBJ_MSG
                                                 << std::endl;
                     throw std::runtime_error (NULL_DEPOBJ_MSG);
                 }
-                resource.sceneObj          = sceneObj;
+                resource.sceneObj                = sceneObj;
+                resource.meshPoolObj             = meshPoolObj;
             }
 
             std::vector <Vertex>& getBatchedVertices (const e_tagType tagType) {
@@ -70,14 +163,32 @@ namespace SandBox {
                 return m_meshBatchingInfo.meta.tagTypeToIndicesMap[tagType];
             }
 
+            std::vector <PackedVertex>& getBatchedPackedVertices (const e_tagType tagType) {
+                return m_meshBatchingInfo.meta.tagTypeToPackedVerticesMap[tagType];
+            }
+
+            std::vector <PackedPosition>& getBatchedPackedPositions (const e_tagType tagType) {
+                return m_meshBatchingInfo.meta.tagTypeToPackedPositionsMap[tagType];
+            }
+
+            std::vector <uint8_t>& getBatchedPackedIndices (const e_tagType tagType) {
+                return m_meshBatchingInfo.meta.tagTypeToPackedIndicesMap[tagType];
+            }
+
             void update (void) {
-                auto& meta     = m_meshBatchingInfo.meta;
-                auto& sceneObj = m_meshBatchingInfo.resource.sceneObj;
+                auto& meta        = m_meshBatchingInfo.meta;
+                auto& sceneObj    = m_meshBatchingInfo.resource.sceneObj;
+                auto& meshPoolObj = m_meshBatchingInfo.resource.meshPoolObj;
+                auto startTime    = std::chrono::steady_clock::now();
                 /* Clear previous batched data */
                 meta.entityToOffsetInfoMap.clear();
                 meta.tagTypeToEntitiesMap.clear();
                 meta.tagTypeToVerticesMap.clear();
                 meta.tagTypeToIndicesMap.clear();
+                meta.tagTypeToPackedVerticesMap.clear();
+                meta.tagTypeToPackedPositionsMap.clear();
+                meta.tagTypeToPackedIndicesMap.clear();
+                meta.tagTypeToOffsetInfosMap.clear();
 
                 struct Counters {
                     size_t vertices;
@@ -85,105 +196,263 @@ namespace SandBox {
                     uint32_t instances;
                 };
                 std::unordered_map <e_tagType, Counters> tagTypeToCountersMap;
+                /* Meshes with few enough vertices (of the packed tag types) are batched with 16 bit indices, the rest
+                 * keep 32 bit indices. Both are joined into the packed indices once every mesh is batched
+                */
+                std::unordered_map <e_tagType, std::vector <NarrowIndexType>> tagTypeToNarrowIndicesMap;
+                std::unordered_map <e_tagType, std::vector <IndexType>> tagTypeToWideIndicesMap;
                 for (auto const& entity: m_entities) {
                     auto metaComponent                  = sceneObj->getComponent <MetaComponent>   (entity);
                     auto meshComponent                  = sceneObj->getComponent <MeshComponent>   (entity);
                     auto renderComponent                = sceneObj->getComponent <RenderComponent> (entity);
                     auto& tagType                       = metaComponent->m_tagType;
                     auto& counters                      = tagTypeToCountersMap[tagType];
+                    auto& offsetInfos                   = meta.tagTypeToOffsetInfosMap[tagType];
+                    auto& meshInfo                      = meshPoolObj->getMeshInfo (meshComponent->m_meshIdx);
                     uint32_t verticesCountPerPrimitive  = tagType == TAG_TYPE_WIRE ? 2: 3;
-                    /* Populate render component */
-                    renderComponent->m_firstIndexIdx    = static_cast <uint32_t> (counters.indices);
-                    renderComponent->m_indicesCount     = static_cast <uint32_t> (meshComponent->m_indices.size());
-                    renderComponent->m_vertexOffset     = static_cast <int32_t>  (counters.vertices);
-                    renderComponent->m_firstInstanceIdx = counters.instances;
-
-                    counters.vertices                  += meshComponent->m_vertices.size();
-                    counters.indices                   += meshComponent->m_indices.size();
-                    counters.instances                 += renderComponent->m_instancesCount;
-
-                    meta.entityToOffsetInfoMap[entity]  = {
-                        verticesCountPerPrimitive,
-                        renderComponent->m_firstIndexIdx,
-                        renderComponent->m_indicesCount,
-                        renderComponent->m_vertexOffset
-                    };
+                    /* A mesh is only batched once per tag type, entities that share the mesh share its range in the
+                     * batched vertices and indices
+                    */
+                    if (offsetInfos.find (meshComponent->m_meshIdx) == offsetInfos.end() && isPackedTagType (tagType)) {
+                        auto& narrowIndices             = tagTypeToNarrowIndicesMap[tagType];
+                        auto& wideIndices               = tagTypeToWideIndicesMap  [tagType];
+                        bool indicesNarrow              = meshInfo.vertices.size() <=
+                                                          std::numeric_limits <NarrowIndexType>::max() + size_t (1);
+                        offsetInfos[meshComponent->m_meshIdx] = {
+                            verticesCountPerPrimitive,
+                            static_cast <uint32_t> (indicesNarrow ? narrowIndices.size(): wideIndices.size()),
+                            meshInfo.lodInfos[0].indicesCount,
+                            static_cast <int32_t>  (counters.vertices),
+                            meshComponent->m_meshIdx,
+                            indicesNarrow ? VK_INDEX_TYPE_UINT16: VK_INDEX_TYPE_UINT32
+                        };
+                        counters.vertices              += meshInfo.vertices.size();
+
+                        meta.tagTypeToPackedVerticesMap [tagType].reserve (counters.vertices);
+                        meta.tagTypeToPackedPositionsMap[tagType].reserve (counters.vertices);
+                        packVertices (meshInfo,
+                                      meta.tagTypeToPackedVerticesMap [tagType],
+                                      meta.tagTypeToPackedPositionsMap[tagType]);
+                        if (indicesNarrow)
+                            narrowIndices.insert (narrowIndices.end(),
+                                                  meshInfo.indices.begin(),
+                                                  meshInfo.indices.end());
+                        else
+                            wideIndices.insert   (wideIndices.end(),
+                                                  meshInfo.indices.begin(),
+                                                  meshInfo.indices.end());
+                    }
+                    else if (offsetInfos.find (meshComponent->m_meshIdx) == offsetInfos.end()) {
+                        offsetInfos[meshComponent->m_meshIdx] = {
+                            verticesCountPerPrimitive,
+                            static_cast <uint32_t> (counters.indices),
+                            meshInfo.lodInfos[0].indicesCount,
+                            static_cast <int32_t>  (counters.vertices),
+                            meshComponent->m_meshIdx,
+                            VK_INDEX_TYPE_UINT32
+                        };
+                        counters.vertices              += meshInfo.vertices.size();
+                        counters.indices               += meshInfo.indices.size();
+
+                        meta.tagTypeToVerticesMap[tagType].reserve (counters.vertices);
+                        meta.tagTypeToVerticesMap[tagType].insert  (meta.tagTypeToVerticesMap[tagType].end(),
+                                                                    meshInfo.vertices.begin(),
+                                                                    meshInfo.vertices.end());
+
+                        meta.tagTypeToIndicesMap[tagType].reserve  (counters.indices);
+                        meta.tagTypeToIndicesMap[tagType].insert   (meta.tagTypeToIndicesMap[tagType].end(),
+                                                                    meshInfo.indices.begin(),
+                                                                    meshInfo.indices.end());
+                    }
+                    auto& offsetInfo                     = offsetInfos[meshComponent->m_meshIdx];
+                    /* Populate render component, the index buffer offset of 32 bit packed ranges is known once every
+                     * mesh is batched
+                    */
+                    renderComponent->m_firstIndexIdx     = offsetInfo.firstIndexIdx;
+                    renderComponent->m_indicesCount      = offsetInfo.indicesCount;
+                    renderComponent->m_vertexOffset      = offsetInfo.vertexOffset;
+                    renderComponent->m_firstInstanceIdx  = counters.instances;
+                    renderComponent->m_indexType         = offsetInfo.indexType;
+                    renderComponent->m_indexBufferOffset = 0;
+
+                    counters.instances                  += renderComponent->m_instancesCount;
+
+                    meta.entityToOffsetInfoMap[entity]   = offsetInfo;
                     meta.tagTypeToEntitiesMap[tagType].push_back (entity);
+                }
 
-                    meta.tagTypeToVerticesMap[tagType].reserve (counters.vertices);
-                    meta.tagTypeToVerticesMap[tagType].insert  (meta.tagTypeToVerticesMap[tagType].end(),
-                                                                meshComponent->m_vertices.begin(),
-                                                                meshComponent->m_vertices.end());
+                for (auto const& [tagType, narrowIndices]: tagTypeToNarrowIndicesMap) {
+                    auto& wideIndices   = tagTypeToWideIndicesMap[tagType];
+                    auto& packedIndices = meta.tagTypeToPackedIndicesMap[tagType];
+                    /* The offset of an index buffer binding has to be a multiple of the index type size */
+                    size_t wideOffset   = (narrowIndices.size() * sizeof (NarrowIndexType) + 3) & ~size_t (3);
+                    packedIndices.resize (wideOffset + wideIndices.size() * sizeof (IndexType), 0);
+                    std::memcpy (packedIndices.data(),
+                                 narrowIndices.data(),
+                                 narrowIndices.size() * sizeof (NarrowIndexType));
+                    std::memcpy (packedIndices.data() + wideOffset,
+                                 wideIndices.data(),
+                                 wideIndices.size()   * sizeof (IndexType));
 
-                    meta.tagTypeToIndicesMap[tagType].reserve  (counters.indices);
-                    meta.tagTypeToIndicesMap[tagType].insert   (meta.tagTypeToIndicesMap[tagType].end(),
-                                                                meshComponent->m_indices.begin(),
-                                                                meshComponent->m_indices.end());
+                    for (auto const& entity: meta.tagTypeToEntitiesMap[tagType]) {
+                        auto renderComponent = sceneObj->getComponent <RenderComponent> (entity);
+                        if (renderComponent->m_indexType == VK_INDEX_TYPE_UINT32)
+                            renderComponent->m_indexBufferOffset = wideOffset;
+                    }
                 }
+                meta.batchingTime = std::chrono::duration <float, std::milli> (
+                    std::chrono::steady_clock::now() - startTime
+                ).count();
             }
 
+            /* Runs on the load path, and so only summarizes each batched mesh (shared by every entity using it) rather
+             * than its geometry, which is written out by exportGeometry on request. Every mesh is reported with its
+             * idx, entities count, vertices count, indices count (every level of detail), vertex and index bytes in
+             * the batched buffers, import time (in milliseconds) and source, followed by its bounds
+            */
             void generateReport (void) {
                 auto& meta     = m_meshBatchingInfo.meta;
                 auto& resource = m_meshBatchingInfo.resource;
                 auto& logObj   = resource.logObj;
 
                 for (auto const& [tagType, entities]: meta.tagTypeToEntitiesMap) {
-                    auto vertices = meta.tagTypeToVerticesMap[tagType];
-                    auto indices  = meta.tagTypeToIndicesMap [tagType];
+                    auto& offsetInfos = meta.tagTypeToOffsetInfosMap[tagType];
+                    std::map <uint32_t, uint32_t> meshIdxToEntitiesCountMap;
+                    for (auto const& entity: entities)
+                        ++meshIdxToEntitiesCountMap[meta.entityToOffsetInfoMap[entity].meshIdx];
 
-                    LOG_LITE_INFO (logObj)         << getTagTypeString (tagType)     << std::endl;
-                    LOG_LITE_INFO (logObj)         << "["                            << std::endl;
+                    size_t verticesCount = 0;
+                    size_t indicesCount  = 0;
+                    size_t bytesCount    = 0;
+                    LOG_LITE_INFO (logObj)     << getTagTypeString (tagType)                        << std::endl;
+                    LOG_LITE_INFO (logObj)     << "["                                               << std::endl;
+                    for (auto const& [meshIdx, entitiesCount]: meshIdxToEntitiesCountMap) {
+                        auto& meshInfo       = resource.meshPoolObj->getMeshInfo (meshIdx);
+                        auto& offsetInfo     = offsetInfos[meshIdx];
+                        size_t vertexSize    = isPackedTagType (tagType) ?
+                                               sizeof (PackedVertex) + sizeof (PackedPosition): sizeof (Vertex);
+                        size_t indexSize     = offsetInfo.indexType == VK_INDEX_TYPE_UINT16 ?
+                                               sizeof (NarrowIndexType): sizeof (IndexType);
+                        size_t vertexBytes   = meshInfo.vertices.size() * vertexSize;
+                        size_t indexBytes    = meshInfo.indices.size()  * indexSize;
+                        const char* source   = meshInfo.key.empty() ? "MANUAL": meshInfo.cacheHit ? "CACHED": "PARSED";
 
+                        verticesCount       += meshInfo.vertices.size();
+                        indicesCount        += meshInfo.indices.size();
+                        bytesCount          += vertexBytes + indexBytes;
+
+                        LOG_LITE_INFO (logObj) << "\t" << ALIGN_AND_PAD_S << meshIdx                  << ", "
+                                                       << ALIGN_AND_PAD_S << entitiesCount            << ", "
+                                                       << ALIGN_AND_PAD_S << meshInfo.vertices.size() << ", "
+                                                       << ALIGN_AND_PAD_S << meshInfo.indices.size()  << ", "
+                                                       << ALIGN_AND_PAD_S << vertexBytes              << ", "
+                                                       << ALIGN_AND_PAD_S << indexBytes               << ", "
+                                                       << ALIGN_AND_PAD_S << meshInfo.importTime      << ", "
+                                                       << ALIGN_AND_PAD_S << source                   << ", "
+                                                       << meshInfo.key                                << std::endl;
+                        /* Min position, max position and radius */
+                        LOG_LITE_INFO (logObj) << "\t" << ALIGN_AND_PAD_S << ""                       << ", "
+                                                       << meshInfo.minPosition.x                      << ", "
+                                                       << meshInfo.minPosition.y                      << ", "
+                                                       << meshInfo.minPosition.z                      << " -> "
+                                                       << meshInfo.maxPosition.x                      << ", "
+                                                       << meshInfo.maxPosition.y                      << ", "
+                                                       << meshInfo.maxPosition.z                      << ", "
+                                                       << meshInfo.radius                             << std::endl;
+                    }
+                    /* Meshes count, vertices count, indices count and bytes over every mesh of the tag type */
+                    LOG_LITE_INFO (logObj)     << "\t" << ALIGN_AND_PAD_S << offsetInfos.size()       << ", "
+                                                       << ALIGN_AND_PAD_S << verticesCount            << ", "
+                                                       << ALIGN_AND_PAD_S << indicesCount             << ", "
+                                                       << bytesCount                                  << std::endl;
+                    LOG_LITE_INFO (logObj)     << "]"                                               << std::endl;
+                }
+                /* Batching time (in milliseconds) */
+                LOG_LITE_INFO (logObj)         << meta.batchingTime                                 << std::endl;
+            }
+
+            /* Writes the batched geometry of every tag type to the given file (see the layout above), which is only
+             * done on request rather than on every load. Returns false if the file couldn't be written
+            */
+            bool exportGeometry (const std::string filePath) {
+                auto& meta     = m_meshBatchingInfo.meta;
+                auto& resource = m_meshBatchingInfo.resource;
+
+                std::ofstream file (filePath, std::ios::binary);
+                if (!file.is_open()) {
+                    LOG_WARNING (resource.logObj) << "Failed to open geometry export file"
+                                                  << " "
+                                                  << "[" << filePath << "]"
+                                                  << std::endl;
+                    return false;
+                }
+                for (auto const& [tagType, entities]: meta.tagTypeToEntitiesMap) {
+                    bool packed = isPackedTagType (tagType);
+                    /* The first index offset of a mesh is taken from the render component of an entity using it, since
+                     * the 32 bit packed ranges start after the 16 bit ones
+                    */
+                    std::map <uint32_t, GeometryExportMeshInfo> meshIdxToMeshInfoMap;
                     for (auto const& entity: entities) {
-                        auto metaComponent                 = resource.sceneObj->getComponent <MetaComponent> (entity);
-                        auto info                          = meta.entityToOffsetInfoMap[entity];
-                        uint32_t verticesCountPerPrimitive = info.verticesCountPerPrimitive;
-                        uint32_t firstIndexIdx             = info.firstIndexIdx;
-                        uint32_t lastIndexIdx              = firstIndexIdx + info.indicesCount;
-                        size_t loopIdx                     = 0;
-
-                        LOG_LITE_INFO (logObj)     << "\t"   << metaComponent->m_id  << std::endl;
-                        LOG_LITE_INFO (logObj)     << "\t"   << "["                  << std::endl;
-
-                        for (uint32_t indexIdx = firstIndexIdx; indexIdx < lastIndexIdx; indexIdx++) {
-                            auto index  = indices [indexIdx];
-                            auto vertex = vertices[info.vertexOffset + index];
-
-                            /* New line after every primitive */
-                            if (loopIdx > 0 && (loopIdx % verticesCountPerPrimitive == 0))
-                            LOG_LITE_INFO (logObj) << std::endl;
-
-                            LOG_LITE_INFO (logObj) << "\t\t" << "("
-                                                             << ALIGN_AND_PAD_C (16) << vertex.meta.uv.x       << ", "
-                                                             << ALIGN_AND_PAD_C (16) << vertex.meta.uv.y
-                                                             << ")"
-                                                             << ", "
-                                                             << "("
-                                                             << ALIGN_AND_PAD_C (16) << vertex.meta.normal.x   << ", "
-                                                             << ALIGN_AND_PAD_C (16) << vertex.meta.normal.y   << ", "
-                                                             << ALIGN_AND_PAD_C (16) << vertex.meta.normal.z
-                                                             << ")"
-                                                             << ", "
-                                                             << "("
-                                                             << ALIGN_AND_PAD_C (16) << vertex.meta.position.x << ", "
-                                                             << ALIGN_AND_PAD_C (16) << vertex.meta.position.y << ", "
-                                                             << ALIGN_AND_PAD_C (16) << vertex.meta.position.z
-                                                             << ")"
-                                                             << ", "
-                                                             << ALIGN_AND_PAD_S      << vertex.material.diffuseTextureIdx
-                                                             << ", "
-                                                             << ALIGN_AND_PAD_S      << vertex.material.specularTextureIdx
-                                                             << ", "
-                                                             << ALIGN_AND_PAD_S      << vertex.material.emissionTextureIdx
-                                                             << ", "
-                                                             << ALIGN_AND_PAD_S      << vertex.material.shininess
-                                                             << std::endl;
-                            ++loopIdx;
-                        }
-                        LOG_LITE_INFO (logObj)     << "\t"   << "]"                  << std::endl;
+                        auto renderComponent = resource.sceneObj->getComponent <RenderComponent> (entity);
+                        auto& offsetInfo     = meta.entityToOffsetInfoMap[entity];
+                        auto& meshInfo       = resource.meshPoolObj->getMeshInfo (offsetInfo.meshIdx);
+                        uint32_t indexSize   = offsetInfo.indexType == VK_INDEX_TYPE_UINT16 ?
+                                               sizeof (NarrowIndexType): sizeof (IndexType);
+
+                        meshIdxToMeshInfoMap[offsetInfo.meshIdx] = {
+                            offsetInfo.meshIdx,
+                            offsetInfo.vertexOffset,
+                            renderComponent->m_indexBufferOffset + uint64_t (offsetInfo.firstIndexIdx) * indexSize,
+                            offsetInfo.indicesCount,
+                            indexSize,
+                            {meshInfo.minPosition.x, meshInfo.minPosition.y, meshInfo.minPosition.z},
+                            {meshInfo.maxPosition.x, meshInfo.maxPosition.y, meshInfo.maxPosition.z}
+                        };
                     }
-                    LOG_LITE_INFO (logObj)         << "]"                            << std::endl;
+
+                    GeometryExportHeader header = {};
+                    std::memcpy (header.magic, g_geometryExportFileMagic, sizeof (header.magic));
+                    header.version       = g_geometryExportFileVersion;
+                    header.tagType       = static_cast <uint32_t> (tagType);
+                    header.meshesCount   = static_cast <uint32_t> (meshIdxToMeshInfoMap.size());
+                    header.verticesCount = static_cast <uint32_t> (
+                        packed ? meta.tagTypeToPackedVerticesMap[tagType].size():
+                                 meta.tagTypeToVerticesMap[tagType].size()
+                    );
+                    header.vertexSize    = static_cast <uint32_t> (packed ? sizeof (PackedVertex): sizeof (Vertex));
+                    header.indicesSize   = packed ? meta.tagTypeToPackedIndicesMap[tagType].size():
+                                                    meta.tagTypeToIndicesMap[tagType].size() * sizeof (IndexType);
+
+                    file.write (reinterpret_cast <const char*> (&header), sizeof (header));
+                    for (auto const& [meshIdx, meshInfo]: meshIdxToMeshInfoMap)
+                        file.write (reinterpret_cast <const char*> (&meshInfo), sizeof (meshInfo));
+                    if (packed) {
+                        file.write (reinterpret_cast <const char*> (meta.tagTypeToPackedVerticesMap[tagType].data()),
+                                    static_cast <std::streamsize> (header.verticesCount * sizeof (PackedVertex)));
+                        file.write (reinterpret_cast <const char*> (meta.tagTypeToPackedIndicesMap[tagType].data()),
+                                    static_cast <std::streamsize> (header.indicesSize));
+                    }
+                    else {
+                        file.write (reinterpret_cast <const char*> (meta.tagTypeToVerticesMap[tagType].data()),
+                                    static_cast <std::streamsize> (header.verticesCount * sizeof (Vertex)));
+                        file.write (reinterpret_cast <const char*> (meta.tagTypeToIndicesMap[tagType].data()),
+                                    static_cast <std::streamsize> (header.indicesSize));
+                    }
+                }
+                file.close();
+
+                if (!file) {
+                    LOG_WARNING (resource.logObj) << "Failed to write geometry export file"
+                                                  << " "
+                                                  << "[" << filePath << "]"
+                                                  << std::endl;
+                    return false;
                 }
+                LOG_INFO (resource.logObj) << "Exported geometry"
+                                           << " "
+                                           << "[" << filePath << "]"
+                                           << std::endl;
+                return true;
             }
 
             ~SYMeshBatching (void) {
@@ -5,6 +5,11 @@
 #include "../../../Backend/Log/LGImpl.h"
 #include "../../../Backend/Scene/SNType.h"
 #include "../../SBComponentType.h"
+#include "../../SBRendererType.h"
+#include "../../SBMeshPool.h"
+#include "../../SBVertexCodec.h"
+#include "../../SBMeshletCuller.h"
+#include "../SYConfig.h"
 
 namespace SandBox {
     class SYStdMeshInstanceBatching: public Scene::SNSystemBase {
@@ -20,6 +25,52 @@ namespace SandBox {
                 int32_t textureIdxOffsets[3];
             };
 
+            /* Materials used by the vertices of a mesh (idx into the materials of the mesh). The textures are looked up
+             * in the material table every time, since materials can be edited
+            */
+            struct TextureUsageInfo {
+                std::vector <uint32_t> materialIdxs;
+            };
+
+            /* World space bounding sphere of an instance, along with the (scaled) error of each level of detail of its
+             * mesh. The model matrix and mesh idx are kept for culling the meshlets of the instance. The instances
+             * count is that of the render component for its first instance (the parent), and 0 for its children
+            */
+            struct InstanceLodInfo {
+                glm::vec3 center;
+                float radius;
+                uint32_t lodsCount;
+                float errors[g_maxLodsCount];
+                glm::mat4 modelMatrix;
+                uint32_t meshIdx;
+                uint32_t instancesCount;
+            };
+
+            /* A view that draw ranges are built for, the camera or the shadow view of a light */
+            struct DrawViewInfo {
+                glm::vec3 position;
+                glm::mat4 viewMatrix;
+                glm::mat4 projectionMatrix;
+                float viewportHeight;
+                float maxScreenError;
+                bool coneCulling;
+            };
+
+            /* Meshlet bounds of a mesh in blocks (see SBMeshletCuller), every level of detail starting a new block */
+            struct MeshletCullInfo {
+                std::vector <MeshletBoundsBlock> blocks;
+                uint32_t firstBlockIdxs[g_maxLodsCount];
+            };
+
+            /* Index ranges to draw for every render component in a view. The ranges of the render component at first
+             * instance idx i are [firstRangeIdxs[i], firstRangeIdxs[i + 1]) and are drawn for all of its instances, a
+             * render component without ranges is culled. The other instances of a render component have no ranges
+            */
+            struct DrawRangesInfo {
+                std::vector <uint32_t> firstRangeIdxs;
+                std::vector <IndexRangeInfo> indexRanges;
+            };
+
             struct StdMeshInstanceBatchingInfo {
                 struct Meta {
                     /* Used for report purpose only */
@@ -28,14 +79,238 @@ namespace SandBox {
 
                     std::unordered_map <e_tagType, std::vector <MeshInstanceLiteSBO>> tagTypeToInstancesLiteMap;
                     std::unordered_map <e_tagType, std::vector <MeshInstanceSBO>> tagTypeToInstancesMap;
+
+                    std::unordered_map <uint32_t, TextureUsageInfo> meshIdxToTextureUsageInfoMap;
+                    /* Largest size (in pixels) that a texture covers on screen this frame, see SBTextureResidency */
+                    std::unordered_map <uint32_t, float> textureIdxToScreenSizeMap;
+
+                    std::unordered_map <e_tagType, std::vector <InstanceLodInfo>> tagTypeToInstanceLodInfosMap;
+                    std::unordered_map <uint32_t, MeshletCullInfo> meshIdxToMeshletCullInfoMap;
+                    /* Visible index ranges (of the selected level of detail) per instance, for the camera view (per tag
+                     * type) and for the shadow view of each active light (std no alpha tag type only, since nothing
+                     * else casts shadows)
+                    */
+                    std::unordered_map <e_tagType, DrawRangesInfo> tagTypeToDrawRangesInfoMap;
+                    std::vector <DrawRangesInfo> activeLightIdxToDrawRangesInfoMap;
+                    /* Views of the visible instances of a render component, reused across render components */
+                    std::vector <ViewCullInfo> viewCullInfos;
                 } meta;
 
                 struct Resource {
                     Scene::SNImpl* sceneObj;
                     Log::LGImpl* logObj;
+                    SBMeshPool* meshPoolObj;
                 } resource;
             } m_stdMeshInstanceBatchingInfo;
 
+            /* The texture usage of a mesh is only gathered once (and shared by every instance of the mesh), after which
+             * this only projects the world space bounding sphere of the instance. The projected diameter is
+             * (2 * radius / distance) * P[1][1] in NDC, which spans 2 units over the viewport height
+            */
+            void updateTextureScreenSizes (const InstanceLodInfo& lodInfo,
+                                           const int32_t* textureIdxOffsets,
+                                           const ActiveCameraPC* activeCamera,
+                                           const float viewportHeight) {
+
+                auto& meta           = m_stdMeshInstanceBatchingInfo.meta;
+                auto& resource       = m_stdMeshInstanceBatchingInfo.resource;
+                auto& meshInfo       = resource.meshPoolObj->getMeshInfo (lodInfo.meshIdx);
+                if (meshInfo.vertices.empty())
+                    return;
+
+                bool usageInfoFound  = meta.meshIdxToTextureUsageInfoMap.find (lodInfo.meshIdx) !=
+                                       meta.meshIdxToTextureUsageInfoMap.end();
+                auto& usageInfo      = meta.meshIdxToTextureUsageInfoMap[lodInfo.meshIdx];
+                if (!usageInfoFound) {
+                    std::set <uint32_t> materialIdxs;
+                    for (auto const& vertex: meshInfo.vertices)
+                        materialIdxs.insert (vertex.materialIdx);
+                    usageInfo.materialIdxs.assign (materialIdxs.begin(), materialIdxs.end());
+                }
+
+                auto& projectionMatrix = activeCamera->projectionMatrix;
+                auto& center           = lodInfo.center;
+                auto& radius           = lodInfo.radius;
+                float screenSize       = viewportHeight;
+                /* The w row of an orthographic projection is (0, 0, 0, 1), the size doesn't change with distance */
+                if (projectionMatrix[3][3] == 1.0f)
+                    screenSize         = radius * std::abs (projectionMatrix[1][1]) * viewportHeight;
+                else {
+                    float distance     = glm::length (center - activeCamera->position);
+                    if (distance > radius)
+                        screenSize     = radius * std::abs (projectionMatrix[1][1]) * viewportHeight / distance;
+                }
+
+                auto& materials        = resource.meshPoolObj->getMaterials();
+                for (auto const& materialIdx: usageInfo.materialIdxs) {
+                    auto& material          = materials[meshInfo.firstMaterialIdx + materialIdx];
+                    uint32_t textureIdxs[3] = {
+                        material.diffuseTextureIdx,
+                        material.specularTextureIdx,
+                        material.emissionTextureIdx
+                    };
+                    for (uint32_t i = 0; i < 3; i++) {
+                        int32_t offsetTextureIdx = static_cast <int32_t> (textureIdxs[i]) + textureIdxOffsets[i];
+                        if (offsetTextureIdx < 0)
+                            continue;
+
+                        auto& maxScreenSize      = meta.textureIdxToScreenSizeMap[
+                            static_cast <uint32_t> (offsetTextureIdx)
+                        ];
+                        maxScreenSize            = std::max (maxScreenSize, screenSize);
+                    }
+                }
+            }
+
+            /* The error of a level projects to (error / distance) * P[1][1] in NDC, which spans 2 units over the
+             * viewport height. The distance is taken to the near side of the bounding sphere, and the coarsest level
+             * that stays within the max screen error is selected
+            */
+            uint32_t selectLodIdx (const InstanceLodInfo& lodInfo,
+                                   const glm::vec3& viewPosition,
+                                   const glm::mat4& projectionMatrix,
+                                   const float viewportHeight,
+                                   const float maxScreenError) {
+
+                float errorScale = std::abs (projectionMatrix[1][1]) * viewportHeight * 0.5f;
+                /* The w row of an orthographic projection is (0, 0, 0, 1), the error doesn't change with distance */
+                if (projectionMatrix[3][3] != 1.0f) {
+                    float distance = glm::length (lodInfo.center - viewPosition) - lodInfo.radius;
+                    if (distance <= 0.0f)
+                        return 0;
+                    errorScale    /= distance;
+                }
+
+                uint32_t lodIdx = 0;
+                while (lodIdx + 1 < lodInfo.lodsCount && lodInfo.errors[lodIdx + 1] * errorScale <= maxScreenError)
+                    ++lodIdx;
+                return lodIdx;
+            }
+
+            /* The world space bounding sphere of an entity with a mesh is kept up to date by SYMeshBounding. Children
+             * are drawn with the mesh of their parent and have no bounds of their own, their sphere is derived from
+             * the mesh bounds here the same way
+            */
+            InstanceLodInfo createInstanceLodInfo (const Scene::Entity entity,
+                                                   const uint32_t meshIdx,
+                                                   const glm::mat4& modelMatrix,
+                                                   const glm::vec3& scale) {
+
+                auto& resource       = m_stdMeshInstanceBatchingInfo.resource;
+                auto& meshInfo       = resource.meshPoolObj->getMeshInfo (meshIdx);
+                float maxScale       = std::max ({std::abs (scale.x), std::abs (scale.y), std::abs (scale.z)});
+                auto entitySignature = resource.sceneObj->getEntitySignature (entity);
+
+                InstanceLodInfo lodInfo;
+                if (entitySignature.test (resource.sceneObj->getComponentType <BoundsComponent>())) {
+                    auto boundsComponent = resource.sceneObj->getComponent <BoundsComponent> (entity);
+                    lodInfo.center       = boundsComponent->m_worldCenter;
+                    lodInfo.radius       = boundsComponent->m_worldRadius;
+                }
+                else {
+                    lodInfo.center       = glm::vec3 (modelMatrix * glm::vec4 (meshInfo.center, 1.0f));
+                    lodInfo.radius       = meshInfo.radius * maxScale;
+                }
+                lodInfo.lodsCount    = static_cast <uint32_t> (meshInfo.lodInfos.size());
+                for (uint32_t i = 0; i < lodInfo.lodsCount; i++)
+                    lodInfo.errors[i] = meshInfo.lodInfos[i].error * maxScale;
+                lodInfo.modelMatrix = modelMatrix;
+                lodInfo.meshIdx     = meshIdx;
+                return lodInfo;
+            }
+
+            /* The meshlet bounds of a mesh are only laid out in blocks once, and shared by every entity using it */
+            MeshletCullInfo& getMeshletCullInfo (const uint32_t meshIdx) {
+                auto& meta     = m_stdMeshInstanceBatchingInfo.meta;
+                auto& resource = m_stdMeshInstanceBatchingInfo.resource;
+                if (meta.meshIdxToMeshletCullInfoMap.find (meshIdx) != meta.meshIdxToMeshletCullInfoMap.end())
+                    return meta.meshIdxToMeshletCullInfoMap[meshIdx];
+
+                auto& cullInfo = meta.meshIdxToMeshletCullInfoMap[meshIdx];
+                auto& meshInfo = resource.meshPoolObj->getMeshInfo (meshIdx);
+                for (uint32_t i = 0; i < meshInfo.lodInfos.size(); i++) {
+                    cullInfo.firstBlockIdxs[i] = static_cast <uint32_t> (cullInfo.blocks.size());
+                    createMeshletBoundsBlocks (meshInfo.meshletInfos,
+                                               meshInfo.lodInfos[i].firstMeshletIdx,
+                                               meshInfo.lodInfos[i].meshletsCount,
+                                               cullInfo.blocks);
+                }
+                return cullInfo;
+            }
+
+            /* Appends the visible index ranges of the render component whose first instance is given, which are drawn
+             * for all of its instances (see DrawRangesInfo). Every instance is culled against the view in its own model
+             * space, and a meshlet is drawn if it is visible from any of them. Without a view to cull against (or for
+             * meshes without meshlets), the whole level is drawn as long as an instance is visible. Visible meshlets
+             * that are next to each other in the indices are merged into a single range
+            */
+            void appendDrawRanges (const std::vector <InstanceLodInfo>& lodInfos,
+                                   const size_t firstInstanceIdx,
+                                   const DrawViewInfo* viewInfo,
+                                   DrawRangesInfo& drawRangesInfo) {
+
+                auto& meta             = m_stdMeshInstanceBatchingInfo.meta;
+                auto& resource         = m_stdMeshInstanceBatchingInfo.resource;
+                auto& firstLodInfo     = lodInfos[firstInstanceIdx];
+                auto& meshInfo         = resource.meshPoolObj->getMeshInfo (firstLodInfo.meshIdx);
+                auto& indexRanges      = drawRangesInfo.indexRanges;
+                uint32_t firstRangeIdx = static_cast <uint32_t> (indexRanges.size());
+                drawRangesInfo.firstRangeIdxs.push_back (firstRangeIdx);
+
+                /* Every instance is drawn at the same level, the finest one that any of them needs */
+                uint32_t lodIdx        = viewInfo != nullptr ? firstLodInfo.lodsCount - 1: 0;
+                for (uint32_t i = 0; viewInfo != nullptr && i < firstLodInfo.instancesCount && lodIdx > 0; i++)
+                    lodIdx             = std::min (lodIdx, selectLodIdx (lodInfos[firstInstanceIdx + i],
+                                                                         viewInfo->position,
+                                                                         viewInfo->projectionMatrix,
+                                                                         viewInfo->viewportHeight,
+                                                                         viewInfo->maxScreenError));
+                auto& meshLodInfo      = meshInfo.lodInfos[lodIdx];
+
+                /* The view is in model space, and so is tested against the model space bounding sphere */
+                bool culled            = viewInfo != nullptr && g_systemConfig.culling.clusterCulling;
+                auto& viewCullInfos    = meta.viewCullInfos;
+                viewCullInfos.clear();
+                for (uint32_t i = 0; culled && i < firstLodInfo.instancesCount; i++) {
+                    auto viewCullInfo  = createViewCullInfo (lodInfos[firstInstanceIdx + i].modelMatrix,
+                                                             viewInfo->viewMatrix,
+                                                             viewInfo->projectionMatrix,
+                                                             viewInfo->coneCulling);
+                    if (isSphereVisible (viewCullInfo, meshInfo.center, meshInfo.radius))
+                        viewCullInfos.push_back (viewCullInfo);
+                }
+
+                if (!culled || (!viewCullInfos.empty() && meshLodInfo.meshletsCount == 0))
+                    indexRanges.push_back ({meshLodInfo.firstIndexIdx, meshLodInfo.indicesCount});
+
+                else if (!viewCullInfos.empty()) {
+                    auto& cullInfo     = getMeshletCullInfo (firstLodInfo.meshIdx);
+                    uint32_t blockIdx  = cullInfo.firstBlockIdxs[lodIdx];
+                    for (uint32_t i = 0; i < meshLodInfo.meshletsCount; i += g_meshletBoundsBlockSize) {
+                        uint32_t mask  = 0;
+                        for (auto const& viewCullInfo: viewCullInfos)
+                            mask      |= cullMeshletBoundsBlock (viewCullInfo, cullInfo.blocks[blockIdx]);
+                        blockIdx++;
+
+                        for (uint32_t j = 0; mask != 0; j++, mask >>= 1) {
+                            if ((mask & 1) == 0)
+                                continue;
+
+                            auto& meshletInfo = meshInfo.meshletInfos[meshLodInfo.firstMeshletIdx + i + j];
+                            if (indexRanges.size() > firstRangeIdx &&
+                                indexRanges.back().firstIndexIdx + indexRanges.back().indicesCount ==
+                                meshletInfo.firstIndexIdx)
+                                indexRanges.back().indicesCount += meshletInfo.indicesCount;
+                            else
+                                indexRanges.push_back ({meshletInfo.firstIndexIdx, meshletInfo.indicesCount});
+                        }
+                    }
+                }
+                /* The children of the render component are left without ranges */
+                for (uint32_t i = 1; i < firstLodInfo.instancesCount; i++)
+                    drawRangesInfo.firstRangeIdxs.push_back (static_cast <uint32_t> (indexRanges.size()));
+            }
+
         public:
             SYStdMeshInstanceBatching (void) {
                 m_stdMeshInstanceBatchingInfo = {};
@@ -48,21 +323,28 @@ namespace SandBox {
                 logObj->updateLogConfig (Log::LEVEL_TYPE_ERROR,   Log::SINK_TYPE_CONSOLE | Log::SINK_TYPE_FILE);
             }
 
-            void initStdMeshInstanceBatchingInfo (Scene::SNImpl* sceneObj) {
-                auto& meta                     = m_stdMeshInstanceBatchingInfo.meta;
-                auto& resource                 = m_stdMeshInstanceBatchingInfo.resource;
+            void initStdMeshInstanceBatchingInfo (Scene::SNImpl* sceneObj, SBMeshPool* meshPoolObj) {
+                auto& meta                             = m_stdMeshInstanceBatchingInfo.meta;
+                auto& resource                         = m_stdMeshInstanceBatchingInfo.resource;
 
-                meta.entityToIdxMap            = {};
-                meta.tagTypeToEntitiesMap      = {};
-                meta.tagTypeToInstancesLiteMap = {};
-                meta.tagTypeToInstancesMap     = {};
+                meta.entityToIdxMap                    = {};
+                meta.tagTypeToEntitiesMap              = {};
+                meta.tagTypeToInstancesLiteMap         = {};
+                meta.tagTypeToInstancesMap             = {};
+                meta.meshIdxToTextureUsageInfoMap      = {};
+                meta.textureIdxToScreenSizeMap         = {};
+                meta.tagTypeToInstanceLodInfosMap      = {};
+                meta.meshIdxToMeshletCullInfoMap       = {};
+                meta.tagTypeToDrawRangesInfoMap        = {};
+                meta.activeLightIdxToDrawRangesInfoMap = {};
 
-                if (sceneObj == nullptr) {
+                if (sceneObj == nullptr || meshPoolObj == nullptr) {
                     LOG_ERROR (resource.logObj) << NULL_DEPOBJ_MSG
                                                 << std::endl;
                     throw std::runtime_error (NULL_DEPOBJ_MSG);
                 }
-                resource.sceneObj              = sceneObj;
+                resource.sceneObj                      = sceneObj;
+                resource.meshPoolObj                   = meshPoolObj;
             }
 
             std::vector <MeshInstanceLiteSBO>& getBatchedMeshInstancesLite (const e_tagType tagType) {
@@ -73,35 +355,148 @@ namespace SandBox {
                 return m_stdMeshInstanceBatchingInfo.meta.tagTypeToInstancesMap[tagType];
             }
 
-            void update (void) {
-                auto& meta     = m_stdMeshInstanceBatchingInfo.meta;
-                auto& sceneObj = m_stdMeshInstanceBatchingInfo.resource.sceneObj;
+            std::unordered_map <uint32_t, float>& getTextureIdxToScreenSizeMap (void) {
+                return m_stdMeshInstanceBatchingInfo.meta.textureIdxToScreenSizeMap;
+            }
+
+            /* The first range idxs are indexed by the first instance idx of the render component, see DrawRangesInfo */
+            DrawRangesInfo& getBatchedDrawRanges (const e_tagType tagType) {
+                return m_stdMeshInstanceBatchingInfo.meta.tagTypeToDrawRangesInfoMap[tagType];
+            }
+
+            DrawRangesInfo& getBatchedShadowDrawRanges (const uint32_t activeLightIdx) {
+                return m_stdMeshInstanceBatchingInfo.meta.activeLightIdxToDrawRangesInfoMap[activeLightIdx];
+            }
+
+            /* Texture screen sizes, levels of detail and visible meshlets are only selected when a camera is given,
+             * which isn't the case for the update that runs before the renderer is configured (every instance is
+             * drawn whole at full resolution then). Cone culling is left out for the alpha tag type, since it is drawn
+             * double sided
+            */
+            void update (const ActiveCameraPC* activeCamera = nullptr, const float viewportHeight = 0.0f) {
+                auto& meta        = m_stdMeshInstanceBatchingInfo.meta;
+                auto& sceneObj    = m_stdMeshInstanceBatchingInfo.resource.sceneObj;
+                auto& meshPoolObj = m_stdMeshInstanceBatchingInfo.resource.meshPoolObj;
                 /* Clear previous batched data */
                 meta.entityToIdxMap.clear();
                 meta.tagTypeToEntitiesMap.clear();
                 meta.tagTypeToInstancesLiteMap.clear();
                 meta.tagTypeToInstancesMap.clear();
+                meta.textureIdxToScreenSizeMap.clear();
+                meta.tagTypeToInstanceLodInfosMap.clear();
+                meta.tagTypeToDrawRangesInfoMap.clear();
 
                 std::unordered_map <e_tagType, size_t> tagTypeToLoopIdxMap;
+                /* Children have no mesh of their own, and follow their parent (see SBScene) whose mesh they are drawn
+                 * with
+                */
+                std::unordered_map <e_tagType, Scene::Entity> tagTypeToParentEntityMap;
+                std::unordered_map <e_tagType, size_t> tagTypeToFirstInstanceIdxMap;
+                auto meshComponentType = sceneObj->getComponentType <MeshComponent>();
                 for (auto const& entity: m_entities) {
                     auto metaComponent             = sceneObj->getComponent <MetaComponent>             (entity);
                     auto transformComponent        = sceneObj->getComponent <TransformComponent>        (entity);
                     auto textureIdxOffsetComponent = sceneObj->getComponent <TextureIdxOffsetComponent> (entity);
                     auto& tagType                  = metaComponent->m_tagType;
+                    auto& lodInfos                 = meta.tagTypeToInstanceLodInfosMap[tagType];
+                    bool isParent                  = sceneObj->getEntitySignature (entity).test (meshComponentType);
+                    if (isParent) {
+                        tagTypeToParentEntityMap[tagType]     = entity;
+                        tagTypeToFirstInstanceIdxMap[tagType] = lodInfos.size();
+                    }
+                    else if (tagTypeToParentEntityMap.find (tagType) == tagTypeToParentEntityMap.end())
+                        continue;
+
+                    auto meshComponent             = sceneObj->getComponent <MeshComponent> (
+                        tagTypeToParentEntityMap[tagType]
+                    );
+                    auto& meshInfo                 = meshPoolObj->getMeshInfo (meshComponent->m_meshIdx);
                     glm::mat4 modelMatrix          = transformComponent->createModelMatrix();
+                    /* Std meshes are batched with quantized positions (see SBVertexCodec), which are mapped back to
+                     * model space ahead of the model matrix. The normal matrix is derived from the model matrix alone
+                    */
+                    glm::mat4 dequantizedMatrix    = modelMatrix * getDequantizationMatrix (meshInfo.minPosition,
+                                                                                            meshInfo.maxPosition);
 
                     meta.entityToIdxMap[entity] = tagTypeToLoopIdxMap[tagType]++;
                     meta.tagTypeToEntitiesMap[tagType].push_back (entity);
 
                     MeshInstanceLiteSBO instanceLite;
-                    instanceLite.modelMatrix    = modelMatrix;
+                    instanceLite.modelMatrix    = dequantizedMatrix;
                     meta.tagTypeToInstancesLiteMap[tagType].push_back (instanceLite);
 
                     MeshInstanceSBO instance;
-                    instance.modelMatrix        = modelMatrix;
+                    instance.modelMatrix        = dequantizedMatrix;
                     instance.normalMatrix       = glm::mat4 (glm::transpose (glm::inverse (glm::mat3 (modelMatrix))));
                     textureIdxOffsetComponent->copyTo (instance.textureIdxOffsets);
                     meta.tagTypeToInstancesMap[tagType].push_back (instance);
+
+                    auto lodInfo                = createInstanceLodInfo (entity,
+                                                                         meshComponent->m_meshIdx,
+                                                                         modelMatrix,
+                                                                         transformComponent->m_scale);
+                    lodInfo.instancesCount      = isParent ? 1: 0;
+                    if (!isParent)
+                        lodInfos[tagTypeToFirstInstanceIdxMap[tagType]].instancesCount++;
+                    if (activeCamera != nullptr)
+                        updateTextureScreenSizes (lodInfo,
+                                                  textureIdxOffsetComponent->m_offsets,
+                                                  activeCamera,
+                                                  viewportHeight);
+                    lodInfos.push_back (lodInfo);
+                }
+                /* Ranges are built once the instances of every render component are known */
+                for (auto const& [tagType, lodInfos]: meta.tagTypeToInstanceLodInfosMap) {
+                    DrawViewInfo viewInfo;
+                    if (activeCamera != nullptr)
+                        viewInfo = {
+                            activeCamera->position,
+                            activeCamera->viewMatrix,
+                            activeCamera->projectionMatrix,
+                            viewportHeight,
+                            g_systemConfig.lod.maxScreenError,
+                            tagType != TAG_TYPE_STD_ALPHA
+                        };
+                    auto& drawRangesInfo = meta.tagTypeToDrawRangesInfoMap[tagType];
+                    for (size_t i = 0; i < lodInfos.size(); i += lodInfos[i].instancesCount)
+                        appendDrawRanges (lodInfos,
+                                          i,
+                                          activeCamera != nullptr ? &viewInfo: nullptr,
+                                          drawRangesInfo);
+                    drawRangesInfo.firstRangeIdxs.push_back (static_cast <uint32_t> (
+                        drawRangesInfo.indexRanges.size()
+                    ));
+                }
+            }
+
+            /* Runs after the active lights are batched, selects the level of detail and the visible meshlets of every
+             * shadow casting render component for each light view (including every face of a point light), against the
+             * shadow max screen error
+            */
+            void updateShadowDrawRanges (const std::vector <ActiveLightPC>& activeLights,
+                                         const float shadowImageHeight) {
+
+                auto& meta     = m_stdMeshInstanceBatchingInfo.meta;
+                auto& lodInfos = meta.tagTypeToInstanceLodInfosMap[TAG_TYPE_STD_NO_ALPHA];
+
+                meta.activeLightIdxToDrawRangesInfoMap.resize (activeLights.size());
+                for (size_t i = 0; i < activeLights.size(); i++) {
+                    auto& drawRangesInfo = meta.activeLightIdxToDrawRangesInfoMap[i];
+                    drawRangesInfo.firstRangeIdxs.clear();
+                    drawRangesInfo.indexRanges.clear();
+                    DrawViewInfo viewInfo = {
+                        activeLights[i].position,
+                        activeLights[i].viewMatrix,
+                        activeLights[i].projectionMatrix,
+                        shadowImageHeight,
+                        g_systemConfig.lod.maxShadowScreenError,
+                        true
+                    };
+                    for (size_t j = 0; j < lodInfos.size(); j += lodInfos[j].instancesCount)
+                        appendDrawRanges (lodInfos, j, &viewInfo, drawRangesInfo);
+                    drawRangesInfo.firstRangeIdxs.push_back (static_cast <uint32_t> (
+                        drawRangesInfo.indexRanges.size()
+                    ));
                 }
             }
 
@@ -0,0 +1,111 @@
+#pragma once
+#include "../../../Backend/Common.h"
+#include "../../../Backend/Scene/SNSystemBase.h"
+#include "../../../Backend/Scene/SNImpl.h"
+#include "../../../Backend/Log/LGImpl.h"
+#include "../../SBMeshPool.h"
+#include "../../SBComponentType.h"
+
+namespace SandBox {
+    class SYMeshBounding: public Scene::SNSystemBase {
+        private:
+            struct MeshBoundingInfo {
+                struct Resource {
+                    Scene::SNImpl* sceneObj;
+                    SBMeshPool* meshPoolObj;
+                    Log::LGImpl* logObj;
+                } resource;
+            } m_meshBoundingInfo;
+
+            /* The box is transformed as its center and extent (Arvo, "Transforming Axis-Aligned Bounding Boxes"), the
+             * extent along each world axis being the sum of the absolute values of the matrix row times the local
+             * extent. The sphere radius is scaled by the largest scale factor, which keeps it enclosing the mesh under
+             * non uniform scale
+            */
+            void updateWorldBounds (BoundsComponent* boundsComponent, TransformComponent* transformComponent) {
+                glm::mat4 modelMatrix = transformComponent->createModelMatrix();
+                glm::mat3 matrix      = glm::mat3 (modelMatrix);
+                glm::vec3 center      = (boundsComponent->m_localMinPosition + boundsComponent->m_localMaxPosition) *
+                                        0.5f;
+                glm::vec3 extent      = (boundsComponent->m_localMaxPosition - boundsComponent->m_localMinPosition) *
+                                        0.5f;
+                glm::vec3 worldCenter = glm::vec3 (modelMatrix * glm::vec4 (center, 1.0f));
+                glm::vec3 worldExtent = {0.0f, 0.0f, 0.0f};
+                for (uint32_t i = 0; i < 3; i++) {
+                    for (uint32_t j = 0; j < 3; j++)
+                        worldExtent[i] += std::abs (matrix[j][i]) * extent[j];
+                }
+                auto& scale           = transformComponent->m_scale;
+                float maxScale        = std::max ({std::abs (scale.x), std::abs (scale.y), std::abs (scale.z)});
+
+                boundsComponent->m_worldMinPosition = worldCenter - worldExtent;
+                boundsComponent->m_worldMaxPosition = worldCenter + worldExtent;
+                boundsComponent->m_worldCenter      = glm::vec3 (modelMatrix * glm::vec4 (
+                    boundsComponent->m_localCenter, 1.0f
+                ));
+                boundsComponent->m_worldRadius      = boundsComponent->m_localRadius * maxScale;
+
+                boundsComponent->m_position         = transformComponent->m_position;
+                boundsComponent->m_orientation      = transformComponent->m_orientation;
+                boundsComponent->m_scale            = transformComponent->m_scale;
+            }
+
+        public:
+            SYMeshBounding (void) {
+                m_meshBoundingInfo = {};
+
+                auto& logObj = m_meshBoundingInfo.resource.logObj;
+                logObj       = new Log::LGImpl();
+                logObj->initLogInfo     ("Build/Log/SandBox",     __FILE__);
+                logObj->updateLogConfig (Log::LEVEL_TYPE_INFO,    Log::SINK_TYPE_FILE);
+                logObj->updateLogConfig (Log::LEVEL_TYPE_WARNING, Log::SINK_TYPE_CONSOLE | Log::SINK_TYPE_FILE);
+                logObj->updateLogConfig (Log::LEVEL_TYPE_ERROR,   Log::SINK_TYPE_CONSOLE | Log::SINK_TYPE_FILE);
+            }
+
+            void initMeshBoundingInfo (Scene::SNImpl* sceneObj, SBMeshPool* meshPoolObj) {
+                auto& resource = m_meshBoundingInfo.resource;
+                if (sceneObj == nullptr || meshPoolObj == nullptr) {
+                    LOG_ERROR (resource.logObj) << NULL_DEPOBJ_MSG
+                                                << std::endl;
+                    throw std::runtime_error (NULL_DEPOBJ_MSG);
+                }
+                resource.sceneObj    = sceneObj;
+                resource.meshPoolObj = meshPoolObj;
+            }
+
+            /* Runs every frame, but only touches the entities whose mesh or transform changed since the last update.
+             * The local bounds are copied from the mesh pool (where they are recorded at import time, and cached along
+             * with imported meshes) once the mesh is loaded, and the world bounds follow the transform
+            */
+            void update (void) {
+                auto& resource = m_meshBoundingInfo.resource;
+                for (auto const& entity: m_entities) {
+                    auto meshComponent      = resource.sceneObj->getComponent <MeshComponent>      (entity);
+                    auto transformComponent = resource.sceneObj->getComponent <TransformComponent> (entity);
+                    auto boundsComponent    = resource.sceneObj->getComponent <BoundsComponent>    (entity);
+                    if (meshComponent->m_meshIdx == std::numeric_limits <uint32_t>::max())
+                        continue;
+
+                    if (boundsComponent->m_meshIdx != meshComponent->m_meshIdx) {
+                        auto& meshInfo                      = resource.meshPoolObj->getMeshInfo (
+                            meshComponent->m_meshIdx
+                        );
+                        boundsComponent->m_localMinPosition = meshInfo.minPosition;
+                        boundsComponent->m_localMaxPosition = meshInfo.maxPosition;
+                        boundsComponent->m_localCenter      = meshInfo.center;
+                        boundsComponent->m_localRadius      = meshInfo.radius;
+                        boundsComponent->m_meshIdx          = meshComponent->m_meshIdx;
+                        updateWorldBounds (boundsComponent, transformComponent);
+                    }
+                    else if (boundsComponent->m_position    != transformComponent->m_position    ||
+                             boundsComponent->m_orientation != transformComponent->m_orientation ||
+                             boundsComponent->m_scale       != transformComponent->m_scale)
+                        updateWorldBounds (boundsComponent, transformComponent);
+                }
+            }
+
+            ~SYMeshBounding (void) {
+                delete m_meshBoundingInfo.resource.logObj;
+            }
+    };
+}   // namespace SandBox
\ No newline at end of file
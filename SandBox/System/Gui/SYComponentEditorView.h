@@ -10,6 +10,7 @@
 #include "../../../Backend/Scene/SNType.h"
 #include "SYGuiHelper.h"
 #include "../../SBComponentType.h"
+#include "../../SBMeshPool.h"
 
 namespace SandBox {
     class SYComponentEditorView: public Scene::SNSystemBase {
@@ -36,6 +37,7 @@ namespace SandBox {
 
                 struct Resource {
                     Scene::SNImpl* sceneObj;
+                    SBMeshPool* meshPoolObj;
                     Log::LGImpl* logObj;
                 } resource;
             } m_componentEditorViewInfo;
@@ -53,7 +55,8 @@ namespace SandBox {
             }
 
             void initComponentEditorViewInfo (Scene::SNImpl* sceneObj,
-                                              Collection::CNImpl* collectionObj) {
+                                              Collection::CNImpl* collectionObj,
+                                              SBMeshPool* meshPoolObj) {
 
                 auto& meta                                    = m_componentEditorViewInfo.meta;
                 auto& style                                   = m_componentEditorViewInfo.style;
@@ -75,12 +78,13 @@ namespace SandBox {
                                                                 ImGuiColorEditFlags_Float      |
                                                                 ImGuiColorEditFlags_InputRGB;
 
-                if (sceneObj == nullptr || collectionObj == nullptr) {
+                if (sceneObj == nullptr || collectionObj == nullptr || meshPoolObj == nullptr) {
                     LOG_ERROR (resource.logObj) << NULL_DEPOBJ_MSG
                                                 << std::endl;
                     throw std::runtime_error (NULL_DEPOBJ_MSG);
                 }
                 resource.sceneObj                             = sceneObj;
+                resource.meshPoolObj                          = meshPoolObj;
                 auto imageObj                                 =
                     collectionObj->getCollectionTypeInstance <Renderer::VKImage>   ("G_DEFAULT_TEXTURE_2");
                 auto samplerObj                               =
@@ -102,6 +106,7 @@ namespace SandBox {
                 auto& style          = m_componentEditorViewInfo.style;
                 auto& colorEditFlags = m_componentEditorViewInfo.flag.colorEditFlags;
                 auto& sceneObj       = m_componentEditorViewInfo.resource.sceneObj;
+                auto& meshPoolObj    = m_componentEditorViewInfo.resource.meshPoolObj;
                 auto entitySignature = sceneObj->getEntitySignature (selectedEntity);
 
                 /* Remove horizontal item spacing between left child and right child */
@@ -178,6 +183,34 @@ namespace SandBox {
                                 ImGui::InputText     ("Model file",   &modelFilePath,  ImGuiInputTextFlags_ReadOnly);
                                 ImGui::InputText     ("Mtl file dir", &mtlFileDirPath, ImGuiInputTextFlags_ReadOnly);
                                 ImGui::EndDisabled();
+                                /* Materials live in the material table of the mesh pool, which is uploaded every frame,
+                                 * so edits show up without the vertex buffers being rebuilt. Note that, the materials
+                                 * are shared by every entity using the same mesh
+                                */
+                                if (meshComponent->m_meshIdx == std::numeric_limits <uint32_t>::max())
+                                    break;
+
+                                auto& meshInfo       = meshPoolObj->getMeshInfo (meshComponent->m_meshIdx);
+                                auto& materials      = meshPoolObj->getMaterials();
+                                uint32_t step        = 1;
+                                uint32_t stepFast    = 2;
+
+                                ImGui::SeparatorText ("Material");
+                                for (uint32_t i = 0; i < meshInfo.materials.size(); i++) {
+                                    auto& material = materials[meshInfo.firstMaterialIdx + i];
+
+                                    ImGui::PushID      (static_cast <int> (i));
+                                    ImGui::Text        ("Material %u", i);
+                                    ImGui::InputScalar ("Diffuse",   ImGuiDataType_U32, &material.diffuseTextureIdx,
+                                                        &step, &stepFast);
+                                    ImGui::InputScalar ("Specular",  ImGuiDataType_U32, &material.specularTextureIdx,
+                                                        &step, &stepFast);
+                                    ImGui::InputScalar ("Emission",  ImGuiDataType_U32, &material.emissionTextureIdx,
+                                                        &step, &stepFast);
+                                    ImGui::InputScalar ("Shininess", ImGuiDataType_U32, &material.shininess,
+                                                        &step, &stepFast);
+                                    ImGui::PopID();
+                                }
                                 break;
                             }
                             case 2:
@@ -410,6 +443,47 @@ namespace SandBox {
                                 ImGui::Text          ("%s", text);
                                 break;
                             }
+                            case 12:
+                            {   /* Bounds component type */
+                                auto boundsComponent  = sceneObj->getComponent <BoundsComponent> (selectedEntity);
+                                auto& localMin        = boundsComponent->m_localMinPosition;
+                                auto& localMax        = boundsComponent->m_localMaxPosition;
+                                auto& localCenter     = boundsComponent->m_localCenter;
+                                auto& localRadius     = boundsComponent->m_localRadius;
+                                auto& worldMin        = boundsComponent->m_worldMinPosition;
+                                auto& worldMax        = boundsComponent->m_worldMaxPosition;
+                                auto& worldCenter     = boundsComponent->m_worldCenter;
+                                auto& worldRadius     = boundsComponent->m_worldRadius;
+
+                                ImGui::BeginDisabled (true);
+                                ImGui::SeparatorText ("Local");
+                                ImGui::PushID        (0);
+                                ImGui::InputFloat3   ("Min",    glm::value_ptr (localMin),    meta.formatSpecifier,
+                                                      ImGuiInputTextFlags_ReadOnly);
+                                ImGui::InputFloat3   ("Max",    glm::value_ptr (localMax),    meta.formatSpecifier,
+                                                      ImGuiInputTextFlags_ReadOnly);
+                                ImGui::InputFloat3   ("Center", glm::value_ptr (localCenter), meta.formatSpecifier,
+                                                      ImGuiInputTextFlags_ReadOnly);
+                                ImGui::InputFloat    ("Radius", &localRadius,                 0.0f, 0.0f,
+                                                      meta.formatSpecifier,
+                                                      ImGuiInputTextFlags_ReadOnly);
+                                ImGui::PopID();
+
+                                ImGui::SeparatorText ("World");
+                                ImGui::PushID        (1);
+                                ImGui::InputFloat3   ("Min",    glm::value_ptr (worldMin),    meta.formatSpecifier,
+                                                      ImGuiInputTextFlags_ReadOnly);
+                                ImGui::InputFloat3   ("Max",    glm::value_ptr (worldMax),    meta.formatSpecifier,
+                                                      ImGuiInputTextFlags_ReadOnly);
+                                ImGui::InputFloat3   ("Center", glm::value_ptr (worldCenter), meta.formatSpecifier,
+                                                      ImGuiInputTextFlags_ReadOnly);
+                                ImGui::InputFloat    ("Radius", &worldRadius,                 0.0f, 0.0f,
+                                                      meta.formatSpecifier,
+                                                      ImGuiInputTextFlags_ReadOnly);
+                                ImGui::PopID();
+                                ImGui::EndDisabled();
+                                break;
+                            }
                         }
                     }
                     ImGui::EndChild();
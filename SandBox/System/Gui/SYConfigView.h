@@ -63,9 +63,11 @@ namespace SandBox {
                 meta.selectedTextureIdx      = 0;
                 meta.selectedConfigIdx       = 0;
                 meta.configIdxToLabelInfoMap = {
-                    {0, {"Texture pool", ICON_FA_IMAGES   }},
-                    {1, {"Shadow",       ICON_FA_CLOUD_SUN}},
-                    {2, {"Camera",       ICON_FA_CAMERA   }}
+                    {0, {"Texture pool", ICON_FA_IMAGES     }},
+                    {1, {"Shadow",       ICON_FA_CLOUD_SUN  }},
+                    {2, {"Camera",       ICON_FA_CAMERA     }},
+                    {3, {"Lod",          ICON_FA_LAYER_GROUP}},
+                    {4, {"Culling",      ICON_FA_EYE_SLASH  }}
                 };
 
                 style.tabButtonRounding      = 0.0f;
@@ -89,9 +91,9 @@ namespace SandBox {
                 );
                 auto texturePool             = resource.texturePoolObj->getTexturePool();
 
-                for (auto const& [idx, info]: texturePool) {
+                for (auto const& info: texturePool) {
                     auto imageObj            = collectionObj->getCollectionTypeInstance <Renderer::VKImage>   (
-                        "G_DEFAULT_TEXTURE_" + std::to_string (idx)
+                        "G_DEFAULT_TEXTURE_" + std::to_string (info.idx)
                     );
                     meta.textureIds.push_back (
                         guiObj->addTexture (*imageObj->getImageView(),
@@ -263,6 +265,27 @@ namespace SandBox {
                                 ImGui::PopID();
                                 break;
                             }
+                            case 3:
+                            {   /* Lod */
+                                auto& lod = g_systemConfig.lod;
+                                createHelpMarker     ("Largest error (in pixels) of the selected level of detail");
+                                ImGui::SeparatorText ("Max screen error");
+                                ImGui::DragFloat     ("Camera", &lod.maxScreenError,       meta.dragSpeed,
+                                                      0.0f,     FLT_MAX,                   meta.formatSpecifier,
+                                                      ImGuiSliderFlags_AlwaysClamp);
+                                ImGui::DragFloat     ("Shadow", &lod.maxShadowScreenError, meta.dragSpeed,
+                                                      0.0f,     FLT_MAX,                   meta.formatSpecifier,
+                                                      ImGuiSliderFlags_AlwaysClamp);
+                                break;
+                            }
+                            case 4:
+                            {   /* Culling */
+                                auto& culling = g_systemConfig.culling;
+                                createHelpMarker     ("Draw only the meshlets that are in view and facing it");
+                                ImGui::SeparatorText ("Cluster culling");
+                                ImGui::Checkbox      ("Enabled", &culling.clusterCulling);
+                                break;
+                            }
                         }
                     }
                     ImGui::EndChild();
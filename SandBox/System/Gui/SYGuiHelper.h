@@ -20,7 +20,8 @@ namespace SandBox {
         { 8, {"StdNoAlphaTag",    ICON_FA_TAGS             }},
         { 9, {"StdAlphaTag",      ICON_FA_TAGS             }},
         {10, {"WireTag",          ICON_FA_TAGS             }},
-        {11, {"SkyBoxTag",        ICON_FA_TAGS             }}
+        {11, {"SkyBoxTag",        ICON_FA_TAGS             }},
+        {12, {"Bounds",           ICON_FA_VECTOR_SQUARE    }}
     };
 
     void createHelpMarker (const char* text,
@@ -1,22 +1,46 @@
 #pragma once
-#define TINYOBJLOADER_IMPLEMENTATION
-#include <tinyobjloader/tiny_obj_loader.h>
 #include "../../../Backend/Common.h"
 #include "../../../Backend/Scene/SNSystemBase.h"
 #include "../../../Backend/Scene/SNImpl.h"
 #include "../../../Backend/Log/LGImpl.h"
+#include "../../../Backend/Job/JBPool.h"
 #include "../../SBTexturePool.h"
+#include "../../SBMeshPool.h"
+#include "../../SBOBJParser.h"
+#include "../../SBGLBParser.h"
+#include "../../SBMeshOptimizer.h"
+#include "../../SBMeshSimplifier.h"
+#include "../../SBMeshletBuilder.h"
 #include "../../SBComponentType.h"
 #include "../../SBRendererType.h"
 
 namespace SandBox {
+    /* Texture slot of materials that use the default textures, see SYMeshLoading::ImportInfo */
+    const uint32_t g_unresolvedTextureSlot = std::numeric_limits <uint32_t>::max();
+
     class SYMeshLoading: public Scene::SNSystemBase {
         private:
+            /* Result of importing one model file on a worker thread. Since the texture pool is not thread safe, the
+             * texture indices in the materials of the mesh are slots into the texture names (or unresolved, for the
+             * default textures) until the result is published on the main thread. This is also how the materials are
+             * cached (see SBMeshPool), as the texture indices differ from run to run
+            */
+            struct ImportInfo {
+                std::string modelFilePath;
+                std::string mtlFileDirPath;
+                SBMeshPool::MeshInfo meshInfo;
+                std::vector <std::string> textureNames;
+            };
+
             struct MeshLoadingInfo {
                 struct Resource {
                     Scene::SNImpl* sceneObj;
                     Log::LGImpl* logObj;
+                    Job::JBPool* jobPoolObj;
                     SBTexturePool* texturePoolObj;
+                    SBMeshPool* meshPoolObj;
+                    SBOBJParser* objParserObj;
+                    SBGLBParser* glbParserObj;
                 } resource;
             } m_meshLoadingInfo;
 
@@ -29,187 +53,368 @@ namespace SandBox {
                 ) +  newRange.first;
             }
 
-            void loadOBJModel (MeshComponent* meshComponent) {
-                auto& resource = m_meshLoadingInfo.resource;
-                std::unordered_map <Vertex, IndexType> vertexToIndexMap;
-                tinyobj::ObjReaderConfig readerConfig;
-                tinyobj::ObjReader reader;
-                /* Config */
-                readerConfig.mtl_search_path = meshComponent->m_mtlFileDirPath;
-                readerConfig.triangulate     = true;
-
-                if (!reader.ParseFromFile (meshComponent->m_modelFilePath, readerConfig)) {
-                    if (!reader.Error().empty()) {
-                        std::string msg = reader.Error().substr (0, reader.Error().size() - 1);
-                        LOG_ERROR (resource.logObj) << msg
-                                                    << " "
-                                                    << "[" << meshComponent->m_modelFilePath << "]"
-                                                    << std::endl;
-                        throw std::runtime_error (msg);
-                    }
-                }
-                if (!reader.Warning().empty()) {
-                    std::string msg = reader.Warning().substr (0, reader.Warning().size() - 1);
-                    LOG_WARNING (resource.logObj)   << msg
-                                                    << " "
-                                                    << "[" << meshComponent->m_modelFilePath << "]"
-                                                    << std::endl;
-                }
+            /* Collect texture names in the order they would be added to the texture pool, so that texture indices do
+             * not depend on which worker finishes first
+            */
+            uint32_t getTextureSlot (const std::string& textureName, std::vector <std::string>& textureNames) {
+                if (textureName.empty())
+                    return g_unresolvedTextureSlot;
+
+                auto it = std::find (textureNames.begin(), textureNames.end(), textureName);
+                if (it != textureNames.end())
+                    return static_cast <uint32_t> (it - textureNames.begin());
 
-                auto attribute = reader.GetAttrib();
-                auto shapes    = reader.GetShapes();
-                auto materials = reader.GetMaterials();
-
-                /* Populate texture pool */
-                for (auto const& material: materials) {
-                    if (!material.diffuse_texname.empty())  resource.texturePoolObj->addTexture (
-                         material.diffuse_texname
-                    );
-                    if (!material.specular_texname.empty()) resource.texturePoolObj->addTexture (
-                         material.specular_texname
-                    );
-                    if (!material.emissive_texname.empty()) resource.texturePoolObj->addTexture (
-                         material.emissive_texname
-                    );
+                textureNames.push_back (textureName);
+                return static_cast <uint32_t> (textureNames.size() - 1);
+            }
+
+            /* Model files are told apart by their extension, anything other than .glb is parsed as an OBJ file */
+            bool isGLBModel (const std::string& modelFilePath) {
+                std::string extension = modelFilePath.size() >= 4 ? modelFilePath.substr (modelFilePath.size() - 4): "";
+                std::transform (extension.begin(), extension.end(), extension.begin(), [](unsigned char value) {
+                    return static_cast <char> (std::tolower (value));
+                });
+                return extension == ".glb";
+            }
+
+            /* The import depends on the mtl files looked up, along with the model file */
+            void populateOBJModel (ImportInfo& importInfo, std::vector <std::string>& dependencyPaths) {
+                auto& resource     = m_meshLoadingInfo.resource;
+                auto& meshInfo     = importInfo.meshInfo;
+                auto& textureNames = importInfo.textureNames;
+                auto& vertices     = meshInfo.ownedVertices;
+                auto& indices      = meshInfo.ownedIndices;
+                OBJModelInfo modelInfo;
+                resource.objParserObj->importModel (importInfo.modelFilePath, importInfo.mtlFileDirPath, modelInfo);
+
+                /* Each material of the model file becomes one material of the mesh, in the same order, and faces
+                 * without a material share one more material (appended only if needed) that uses the default textures
+                */
+                auto& materials = meshInfo.materials;
+                for (auto const& material: modelInfo.materials) {
+                    materials.push_back ({
+                        getTextureSlot (material.diffuseTextureName,  textureNames),
+                        getTextureSlot (material.specularTextureName, textureNames),
+                        getTextureSlot (material.emissionTextureName, textureNames),
+                        transformToRange (
+                            static_cast <uint32_t> (material.shininess),
+                            {0,  900},
+                            {32, 128}
+                        )
+                    });
                 }
-                /* attrib_t contains single and linear array of vertex data (vertices, normals and texcoords)
-                 *
-                 * attrib_t::vertices => 3 floats per vertex
-                 *     p[0]        p[1]        p[2]        p[3]               p[n-1]
-                 * +-----------+-----------+-----------+-----------+      +-----------+
-                 * | x | y | z | x | y | z | x | y | z | x | y | z | .... | x | y | z |
-                 * +-----------+-----------+-----------+-----------+      +-----------+
-                 *
-                 * attrib_t::normals => 3 floats per vertex
-                 *     n[0]        n[1]        n[2]        n[3]               n[n-1]
-                 * +-----------+-----------+-----------+-----------+      +-----------+
-                 * | x | y | z | x | y | z | x | y | z | x | y | z | .... | x | y | z |
-                 * +-----------+-----------+-----------+-----------+      +-----------+
-                 *
-                 * attrib_t::texcoords => 2 floats per vertex
-                 *     t[0]        t[1]        t[2]        t[3]               t[n-1]
-                 * +-----------+-----------+-----------+-----------+      +-----------+
-                 * |  u  |  v  |  u  |  v  |  u  |  v  |  u  |  v  | .... |  u  |  v  |
-                 * +-----------+-----------+-----------+-----------+      +-----------+
-                 *
-                 * Each shape_t::mesh_t contains array index to attrib_t, and each index has an index to
-                 * attrib_t::vertices, attrib_t::normals and attrib_t::texcoords
-                 *
-                 * mesh_t::num_face_vertices => array of the number of vertices per face (e.g. 3 = triangle etc.)
-                 * +---+---+---+        +---+
-                 * | 3 | 4 | 3 | ...... | 3 |
-                 * +---+---+---+        +---+
-                 * |   |   |            |
-                 * |   |   |            +-----------------------------------------+
-                 * |   |   |                                                      |
-                 * |   |   +------------------------------+                       |
-                 * |   |                                  |                       |
-                 * |   +------------------+               |                       |
-                 * |                      |               |                       |
-                 * v                      v               v                       v
-                 *
-                 * mesh_t::indices
-                 * |    face[0]   |       face[1]     |    face[2]   |     |      face[n-1]           |
-                 * +----+----+----+----+----+----+----+----+----+----+     +--------+--------+--------+
-                 * | i0 | i1 | i2 | i3 | i4 | i5 | i6 | i7 | i8 | i9 | ... | i(n-3) | i(n-2) | i(n-1) |
-                 * +----+----+----+----+----+----+----+----+----+----+     +--------+--------+--------+
-                 * Note that when triangulate flag is set to true (true by default), num_face_vertices are all filled
-                 * with 3
+                uint32_t defaultMaterialIdx = std::numeric_limits <uint32_t>::max();
+                /* The parser has already deduplicated the corners of the faces (on their position, normal, texcoord and
+                 * material indices), so each corner becomes one vertex and the indices are used as is. Attributes that
+                 * are absent from a corner are left as 0
                 */
-                for (size_t shapeIdx = 0; shapeIdx < shapes.size(); shapeIdx++) {
-                    size_t idxOffset = 0;
-
-                    for (size_t faceIdx = 0; faceIdx < shapes[shapeIdx].mesh.num_face_vertices.size(); faceIdx++) {
-                        int materialIdx        = shapes[shapeIdx].mesh.material_ids[faceIdx];
-                        size_t verticesPerFace = static_cast <size_t> (shapes[shapeIdx].mesh.num_face_vertices[faceIdx]);
-
-                        for (size_t vertexIdx = 0; vertexIdx < verticesPerFace; vertexIdx++) {
-                            auto idx = shapes[shapeIdx].mesh.indices[idxOffset + vertexIdx];
-
-                            auto tx  = attribute.texcoords[2 * static_cast <size_t> (idx.texcoord_index) + 0];
-                            auto ty  = attribute.texcoords[2 * static_cast <size_t> (idx.texcoord_index) + 1];
-
-                            auto nx  = attribute.normals  [3 * static_cast <size_t> (idx.normal_index)   + 0];
-                            auto ny  = attribute.normals  [3 * static_cast <size_t> (idx.normal_index)   + 1];
-                            auto nz  = attribute.normals  [3 * static_cast <size_t> (idx.normal_index)   + 2];
-
-                            auto px  = attribute.vertices [3 * static_cast <size_t> (idx.vertex_index)   + 0];
-                            auto py  = attribute.vertices [3 * static_cast <size_t> (idx.vertex_index)   + 1];
-                            auto pz  = attribute.vertices [3 * static_cast <size_t> (idx.vertex_index)   + 2];
-
-                            Vertex vertex;
-                            /* The OBJ format assumes a coordinate system where a vertical coordinate of 0 means the
-                             * bottom of the image, however we've uploaded our image into vulkan in a top to bottom
-                             * orientation where 0 means the top of the image. We can solve this by flipping the vertical
-                             * component of the texture coordinates
-                             *
-                             * (0, 0)-----------(1, 0)  top ^
-                             * |                |
-                             * |     (u, v)     |
-                             * |                |
-                             * (0, 1)-----------(1, 1)  bottom v
-                             *
-                             * In Vulkan,
-                             * the u coordinate goes from 0.0 to 1.0, left to right
-                             * the v coordinate goes from 0.0 to 1.0, top to bottom
-                            */
-                            vertex.meta.uv       = {
-                                tx,
-                                1.0f - ty
-                            };
-                            vertex.meta.normal   = {
-                                nx, ny, nz
-                            };
-                            vertex.meta.position = {
-                                px, py, pz
-                            };
-                            /* Texture indices will be set to default diffuse/speculat/emission if,
-                             * (1) no texture present in the material
-                             * (2) no material present for the current face/vertex
-                            */
-                            if (materialIdx != -1) {
-                                auto material                      = materials[materialIdx];
-                                vertex.material.diffuseTextureIdx  = material.diffuse_texname  == "" ?
-                                    0:
-                                    resource.texturePoolObj->getTextureIdx (material.diffuse_texname);
-                                vertex.material.specularTextureIdx = material.specular_texname == "" ?
-                                    1:
-                                    resource.texturePoolObj->getTextureIdx (material.specular_texname);
-                                vertex.material.emissionTextureIdx = material.emissive_texname == "" ?
-                                    1:
-                                    resource.texturePoolObj->getTextureIdx (material.emissive_texname);
-                                vertex.material.shininess          = transformToRange (
-                                    material.shininess,
-                                    {0,  900},
-                                    {32, 128}
-                                );
+                vertices.reserve (modelInfo.corners.size());
+                for (auto const& corner: modelInfo.corners) {
+                    Vertex vertex = {};
+                    /* The OBJ format assumes a coordinate system where a vertical coordinate of 0 means the bottom of
+                     * the image, however we've uploaded our image into vulkan in a top to bottom orientation where 0
+                     * means the top of the image. We can solve this by flipping the vertical component of the texture
+                     * coordinates
+                     *
+                     * (0, 0)-----------(1, 0)  top ^
+                     * |                |
+                     * |     (u, v)     |
+                     * |                |
+                     * (0, 1)-----------(1, 1)  bottom v
+                     *
+                     * In Vulkan,
+                     * the u coordinate goes from 0.0 to 1.0, left to right
+                     * the v coordinate goes from 0.0 to 1.0, top to bottom
+                    */
+                    if (corner.texCoordIdx != -1) {
+                        auto& texCoord       = modelInfo.texCoords[corner.texCoordIdx];
+                        vertex.meta.uv       = {
+                            texCoord.x,
+                            1.0f - texCoord.y
+                        };
+                    }
+                    if (corner.normalIdx   != -1)
+                        vertex.meta.normal   = modelInfo.normals  [corner.normalIdx];
+                    vertex.meta.position     = modelInfo.positions[corner.positionIdx];
+                    /* Texture slots will be left unresolved (set to default diffuse/specular/emission when published)
+                     * if,
+                     * (1) no texture present in the material
+                     * (2) no material present for the current face/vertex
+                    */
+                    if (corner.materialIdx != -1)
+                        vertex.materialIdx   = static_cast <uint32_t> (corner.materialIdx);
+                    else {
+                        if (defaultMaterialIdx == std::numeric_limits <uint32_t>::max()) {
+                            defaultMaterialIdx = static_cast <uint32_t> (materials.size());
+                            materials.push_back ({
+                                g_unresolvedTextureSlot,
+                                g_unresolvedTextureSlot,
+                                g_unresolvedTextureSlot,
+                                32
+                            });
+                        }
+                        vertex.materialIdx   = defaultMaterialIdx;
+                    }
+                    vertices.push_back (vertex);
+                }
+                indices.assign (modelInfo.indices.begin(), modelInfo.indices.end());
+                dependencyPaths = std::move (modelInfo.mtlFilePaths);
+            }
+
+            /* The accessors of every primitive are read straight from the mapped model file into the vertices and
+             * indices, with the model matrix of its node applied, so that the whole scene becomes one mesh. Unlike the
+             * OBJ format, glTF texture coordinates already have their origin at the top left of the image, and so are
+             * not flipped. Embedded images are written out through the mesh pool, and the import depends on them
+            */
+            void populateGLBModel (ImportInfo& importInfo, std::vector <std::string>& dependencyPaths) {
+                auto& resource     = m_meshLoadingInfo.resource;
+                auto& meshInfo     = importInfo.meshInfo;
+                auto& textureNames = importInfo.textureNames;
+                auto& vertices     = meshInfo.ownedVertices;
+                auto& indices      = meshInfo.ownedIndices;
+                GLBModelInfo modelInfo;
+                resource.glbParserObj->importModel (importInfo.modelFilePath, importInfo.mtlFileDirPath, modelInfo);
+
+                try {
+                    /* Images in a format the texture pool can't decode (only png and jpeg are embedded as is) fall
+                     * back to the default textures
+                    */
+                    std::map <int32_t, uint32_t> imageIdxToSlotMap;
+                    auto getImageSlot = [&](const int32_t imageIdx) {
+                        if (imageIdx < 0 || static_cast <size_t> (imageIdx) >= modelInfo.images.size())
+                            return g_unresolvedTextureSlot;
+                        if (imageIdxToSlotMap.find (imageIdx) != imageIdxToSlotMap.end())
+                            return imageIdxToSlotMap[imageIdx];
+
+                        auto& imageInfo           = modelInfo.images[imageIdx];
+                        std::string imageFilePath = imageInfo.filePath;
+                        bool imageEmbedded        = imageFilePath.empty() && imageInfo.data != nullptr &&
+                                                    (imageInfo.mimeType == "image/png" ||
+                                                     imageInfo.mimeType == "image/jpeg");
+                        if (imageEmbedded) {
+                            auto fileExtension    = imageInfo.mimeType == "image/png" ? ".png": ".jpg";
+                            if (resource.meshPoolObj->writeImageFile (imageInfo.data,
+                                                                      imageInfo.size,
+                                                                      fileExtension,
+                                                                      imageFilePath))
+                                dependencyPaths.push_back (imageFilePath);
+                            else
+                                imageFilePath.clear();
+                        }
+                        imageIdxToSlotMap[imageIdx] = getTextureSlot (imageFilePath, textureNames);
+                        return imageIdxToSlotMap[imageIdx];
+                    };
+                    /* Metallic roughness materials are mapped onto the Blinn-Phong material, the base color texture
+                     * to diffuse and the emissive texture to emission (the metallic roughness, normal and occlusion
+                     * textures have no counterpart). The roughness is converted to a shininess as 2 / alpha^2 - 2
+                     * where alpha = roughness^2, clamped to the shininess range of the OBJ materials
+                    */
+                    auto& materials = meshInfo.materials;
+                    for (auto const& material: modelInfo.materials) {
+                        float alpha     = material.roughnessFactor * material.roughnessFactor;
+                        float shininess = 2.0f / std::max (alpha * alpha, 0.0001f) - 2.0f;
+                        materials.push_back ({
+                            getImageSlot (material.baseColorImageIdx),
+                            g_unresolvedTextureSlot,
+                            getImageSlot (material.emissiveImageIdx),
+                            static_cast <uint32_t> (std::clamp (shininess, 32.0f, 128.0f))
+                        });
+                    }
+                    uint32_t defaultMaterialIdx = std::numeric_limits <uint32_t>::max();
+
+                    size_t verticesCount = 0;
+                    for (auto const& primitive: modelInfo.primitives)
+                        verticesCount += primitive.positions.count;
+                    vertices.reserve (verticesCount);
+
+                    for (auto const& primitive: modelInfo.primitives) {
+                        uint32_t materialIdx;
+                        if (primitive.materialIdx >= 0 &&
+                            static_cast <size_t> (primitive.materialIdx) < modelInfo.materials.size())
+                            materialIdx = static_cast <uint32_t> (primitive.materialIdx);
+                        else {
+                            if (defaultMaterialIdx == std::numeric_limits <uint32_t>::max()) {
+                                defaultMaterialIdx = static_cast <uint32_t> (materials.size());
+                                materials.push_back ({
+                                    g_unresolvedTextureSlot,
+                                    g_unresolvedTextureSlot,
+                                    g_unresolvedTextureSlot,
+                                    32
+                                });
                             }
-                            else {
-                                vertex.material.diffuseTextureIdx  = 0;
-                                vertex.material.specularTextureIdx = 1;
-                                vertex.material.emissionTextureIdx = 1;
-                                vertex.material.shininess          = 32;
+                            materialIdx = defaultMaterialIdx;
+                        }
+
+                        auto& modelMatrix       = primitive.modelMatrix;
+                        glm::mat3 normalMatrix  = glm::transpose (glm::inverse (glm::mat3 (modelMatrix)));
+                        auto& positions         = primitive.positions;
+                        auto firstVertexIdx     = static_cast <uint32_t> (vertices.size());
+                        for (uint32_t i = 0; i < positions.count; i++) {
+                            Vertex vertex        = {};
+                            glm::vec3 position;
+                            readAccessorFloats (positions, i, &position.x, 3);
+                            vertex.meta.position = glm::vec3 (modelMatrix * glm::vec4 (position, 1.0f));
+                            if (primitive.normals.data   != nullptr) {
+                                glm::vec3 normal;
+                                readAccessorFloats (primitive.normals, i, &normal.x, 3);
+                                vertex.meta.normal = glm::normalize (normalMatrix * normal);
                             }
-                            /* To take advantage of the index buffer, we should keep only the unique vertices and use the
-                             * index buffer to reuse them whenever they come up. Every time we read a vertex from the OBJ
-                             * file, we check if we've already seen a vertex with the exact same attributes before. If
-                             * not, we add it to vertices array and store its index in the map container. After that we
-                             * add the index of the new vertex to indices array
-                             *
-                             * If we've seen the exact same vertex before, then we look up its index in the map container
-                             * and store that index in indices array
-                            */
-                            if (vertexToIndexMap.count (vertex) == 0) {
-                                vertexToIndexMap[vertex] = static_cast <IndexType> (
-                                    meshComponent->m_vertices.size()
-                                );
-                                meshComponent->m_vertices.push_back (vertex);
+                            if (primitive.texCoords.data != nullptr)
+                                readAccessorFloats (primitive.texCoords, i, &vertex.meta.uv.x, 2);
+                            vertex.materialIdx   = materialIdx;
+                            vertices.push_back (vertex);
+                        }
+
+                        /* Primitives without indices are drawn in vertex order. A mirrored model matrix flips the
+                         * winding of the triangles, which is flipped back here
+                        */
+                        auto& primitiveIndices  = primitive.indices;
+                        bool mirrored           = glm::determinant (glm::mat3 (modelMatrix)) < 0.0f;
+                        uint32_t indicesCount   = primitiveIndices.data != nullptr ? primitiveIndices.count:
+                                                                                     positions.count;
+                        for (uint32_t i = 0; i + 2 < indicesCount; i += 3) {
+                            uint32_t triangle[3];
+                            for (uint32_t j = 0; j < 3; j++) {
+                                triangle[j]     = primitiveIndices.data != nullptr ?
+                                                  readAccessorIdx (primitiveIndices, i + j): i + j;
+                                if (triangle[j] >= positions.count) {
+                                    LOG_ERROR (resource.logObj) << "Invalid primitive index"
+                                                                << " "
+                                                                << "[" << importInfo.modelFilePath << "]"
+                                                                << std::endl;
+                                    throw std::runtime_error ("Invalid primitive index");
+                                }
                             }
-                            meshComponent->m_indices.push_back (vertexToIndexMap[vertex]);
+                            indices.push_back (firstVertexIdx + triangle[0]);
+                            indices.push_back (firstVertexIdx + triangle[mirrored ? 2: 1]);
+                            indices.push_back (firstVertexIdx + triangle[mirrored ? 1: 2]);
                         }
-                        idxOffset += verticesPerFace;
                     }
                 }
+                catch (...) {
+                    resource.glbParserObj->releaseModel (modelInfo);
+                    throw;
+                }
+                resource.glbParserObj->releaseModel (modelInfo);
+            }
+
+            /* Runs on a worker thread, and only touches the import info (and the mesh cache files). A model file seen
+             * on a previous run is mapped from the mesh cache, in which case it is only read and hashed instead of
+             * being parsed and optimized
+            */
+            void importModel (ImportInfo& importInfo) {
+                auto& resource     = m_meshLoadingInfo.resource;
+                auto& meshInfo     = importInfo.meshInfo;
+                auto& textureNames = importInfo.textureNames;
+                auto startTime     = std::chrono::steady_clock::now();
+                auto getImportTime = [startTime](void) {
+                    return std::chrono::duration <float, std::milli> (std::chrono::steady_clock::now() - startTime)
+                           .count();
+                };
+                uint64_t contentHash;
+                bool contentHashed = resource.meshPoolObj->getContentHash (importInfo.modelFilePath,
+                                                                           importInfo.mtlFileDirPath,
+                                                                           contentHash);
+                if (contentHashed && resource.meshPoolObj->readCacheFile (contentHash, meshInfo, textureNames)) {
+                    meshInfo.importTime = getImportTime();
+                    meshInfo.cacheHit   = true;
+                    LOG_INFO (resource.logObj) << "Mesh cache hit"
+                                               << " "
+                                               << "[" << importInfo.modelFilePath << "]"
+                                               << std::endl;
+                    return;
+                }
+
+                auto& vertices     = meshInfo.ownedVertices;
+                auto& indices      = meshInfo.ownedIndices;
+                std::vector <std::string> dependencyPaths;
+                if (isGLBModel (importInfo.modelFilePath))
+                    populateGLBModel (importInfo, dependencyPaths);
+                else
+                    populateOBJModel (importInfo, dependencyPaths);
+
+                /* Model files only contain triangle lists, so the load time optimizations are applied here rather than
+                 * in the mesh pool (where line lists are also added). Stats are recorded on both sides of them, and
+                 * only cover the full resolution level, since the levels of detail are appended to the indices after.
+                 * Splitting into meshlets reorders the triangles once more, and so comes before the latter
+                */
+                meshInfo.unoptimizedStatsInfo = getMeshStats (vertices, indices);
+                optimizeVertexCache (indices, vertices.size());
+                optimizeOverdraw    (indices, vertices, g_overdrawClusterThreshold);
+                optimizeVertexFetch (vertices, indices);
+                generateLods        (vertices, indices, meshInfo.lodInfos);
+                generateMeshlets    (vertices, indices, meshInfo.lodInfos, meshInfo.meshletInfos);
+                meshInfo.optimizedStatsInfo   = getMeshStats (vertices, std::vector <IndexType> (
+                    indices.begin(),
+                    indices.begin() + meshInfo.lodInfos[0].indicesCount
+                ));
+                meshInfo.vertices             = vertices;
+                meshInfo.indices              = indices;
+                resource.meshPoolObj->updateBounds (meshInfo);
+                /* The model file is parsed again on the next run if the cache file couldn't be written */
+                if (contentHashed)
+                    resource.meshPoolObj->writeCacheFile (contentHash, dependencyPaths, meshInfo, textureNames);
+                meshInfo.importTime           = getImportTime();
+                meshInfo.cacheHit             = false;
+
+                LOG_INFO (resource.logObj) << "Imported model"
+                                           << " "
+                                           << "[" << importInfo.modelFilePath << "]"
+                                           << " "
+                                           << "[" << vertices.size() << "]"
+                                           << " "
+                                           << "[" << indices.size() << "]"
+                                           << std::endl;
+                LOG_INFO (resource.logObj) << "Optimized model"
+                                           << " "
+                                           << "[" << importInfo.modelFilePath << "]"
+                                           << " "
+                                           << "[ACMR "     << meshInfo.unoptimizedStatsInfo.acmr
+                                           << " -> "       << meshInfo.optimizedStatsInfo.acmr     << "]"
+                                           << " "
+                                           << "[Overdraw " << meshInfo.unoptimizedStatsInfo.overdraw
+                                           << " -> "       << meshInfo.optimizedStatsInfo.overdraw << "]"
+                                           << std::endl;
+                LOG_INFO (resource.logObj) << "Generated lods"
+                                           << " "
+                                           << "[" << importInfo.modelFilePath << "]"
+                                           << " "
+                                           << "[" << meshInfo.lodInfos.size() << "]"
+                                           << " "
+                                           << "[" << meshInfo.lodInfos.back().indicesCount << "]"
+                                           << std::endl;
+                LOG_INFO (resource.logObj) << "Generated meshlets"
+                                           << " "
+                                           << "[" << importInfo.modelFilePath << "]"
+                                           << " "
+                                           << "[" << meshInfo.meshletInfos.size() << "]"
+                                           << " "
+                                           << "[" << meshInfo.lodInfos[0].meshletsCount << "]"
+                                           << std::endl;
+            }
+
+            /* Runs on the main thread, in entity order. Textures are added to the texture pool and the texture slots in
+             * the materials are resolved to texture indices, before handing the mesh over to the mesh pool (which adds
+             * the materials to the material table). The vertices are left as is
+            */
+            void publishModel (ImportInfo& importInfo) {
+                auto& resource = m_meshLoadingInfo.resource;
+                std::vector <uint32_t> textureSlotToIdxMap;
+                for (auto const& textureName: importInfo.textureNames) {
+                    resource.texturePoolObj->addTexture (textureName);
+                    textureSlotToIdxMap.push_back (resource.texturePoolObj->getTextureIdx (textureName));
+                }
+                auto getTextureIdx = [&textureSlotToIdxMap](const uint32_t textureSlot, const uint32_t defaultIdx) {
+                    return textureSlot == g_unresolvedTextureSlot ? defaultIdx: textureSlotToIdxMap[textureSlot];
+                };
+                for (auto& material: importInfo.meshInfo.materials) {
+                    material.diffuseTextureIdx  = getTextureIdx (material.diffuseTextureIdx,  0);
+                    material.specularTextureIdx = getTextureIdx (material.specularTextureIdx, 1);
+                    material.emissionTextureIdx = getTextureIdx (material.emissionTextureIdx, 1);
+                }
+                resource.meshPoolObj->addMesh (importInfo.modelFilePath,
+                                               importInfo.mtlFileDirPath,
+                                               std::move (importInfo.meshInfo));
             }
 
         public:
@@ -222,37 +427,85 @@ namespace SandBox {
                 logObj->updateLogConfig (Log::LEVEL_TYPE_INFO,    Log::SINK_TYPE_FILE);
                 logObj->updateLogConfig (Log::LEVEL_TYPE_WARNING, Log::SINK_TYPE_CONSOLE | Log::SINK_TYPE_FILE);
                 logObj->updateLogConfig (Log::LEVEL_TYPE_ERROR,   Log::SINK_TYPE_CONSOLE | Log::SINK_TYPE_FILE);
+
+                m_meshLoadingInfo.resource.objParserObj = new SBOBJParser();
+                m_meshLoadingInfo.resource.glbParserObj = new SBGLBParser();
             }
 
             /* Note that, system constructors DO NOT take in any arguments, as a result dependencies are passed in here */
             void initMeshLoadingInfo (Scene::SNImpl* sceneObj,
-                                      SBTexturePool* texturePoolObj) {
+                                      Job::JBPool* jobPoolObj,
+                                      SBTexturePool* texturePoolObj,
+                                      SBMeshPool* meshPoolObj) {
 
                 auto& resource          = m_meshLoadingInfo.resource;
-                if (sceneObj == nullptr || texturePoolObj == nullptr) {
+                if (sceneObj       == nullptr || jobPoolObj  == nullptr ||
+                    texturePoolObj == nullptr || meshPoolObj == nullptr) {
                     LOG_ERROR (resource.logObj) << NULL_DEPOBJ_MSG
                                                 << std::endl;
                     throw std::runtime_error (NULL_DEPOBJ_MSG);
                 }
                 resource.sceneObj       = sceneObj;
+                resource.jobPoolObj     = jobPoolObj;
                 resource.texturePoolObj = texturePoolObj;
+                resource.meshPoolObj    = meshPoolObj;
+                resource.objParserObj->initOBJParserInfo (jobPoolObj);
             }
 
+            /* Model files are imported in 3 stages, (1) gather the model files that are not in the mesh pool yet, (2)
+             * parse all of them in parallel on the job pool and (3) publish the results in entity order, so that texture
+             * and mesh indices are the same no matter how the jobs were scheduled. As a result, the time taken is close
+             * to that of the largest model file rather than the sum of all of them
+            */
             void update (void) {
+                auto& resource = m_meshLoadingInfo.resource;
+                std::vector <ImportInfo> importInfos;
+                std::set <std::pair <std::string, std::string>> pendingPaths;
+
                 for (auto const& entity: m_entities) {
-                    auto meshComponent = m_meshLoadingInfo.resource.sceneObj->getComponent <MeshComponent> (entity);
-                    /* Skip entities with manually populated mesh component */
-                    if (!meshComponent->m_loadPending)
+                    auto meshComponent = resource.sceneObj->getComponent <MeshComponent> (entity);
+                    /* Hand manually populated geometry over to the mesh pool */
+                    if (!meshComponent->m_loadPending) {
+                        if (meshComponent->m_meshIdx == std::numeric_limits <uint32_t>::max())
+                            meshComponent->m_meshIdx = resource.meshPoolObj->addMesh (
+                                std::move (meshComponent->m_vertices),
+                                std::move (meshComponent->m_indices)
+                            );
+                        meshComponent->m_vertices.clear();
+                        meshComponent->m_indices.clear();
                         continue;
-                    /* Clear previous loaded data */
-                    meshComponent->m_vertices.clear();
-                    meshComponent->m_indices.clear();
+                    }
+                    /* Entities that use the same model (and import options) share one mesh, which is only parsed
+                     * once
+                    */
+                    auto paths = std::make_pair (meshComponent->m_modelFilePath, meshComponent->m_mtlFileDirPath);
+                    if (resource.meshPoolObj->isMeshAdded (paths.first, paths.second) ||
+                        pendingPaths.find (paths) != pendingPaths.end())
+                        continue;
+
+                    pendingPaths.insert (paths);
+                    importInfos.push_back ({paths.first, paths.second, {}, {}});
+                }
 
-                    loadOBJModel (meshComponent);
+                resource.jobPoolObj->runParallelJobs (static_cast <uint32_t> (importInfos.size()),
+                    [this, &importInfos](uint32_t importIdx) {
+                        importModel (importInfos[importIdx]);
+                    }
+                );
+                for (auto& importInfo: importInfos)
+                    publishModel (importInfo);
+
+                for (auto const& entity: m_entities) {
+                    auto meshComponent = resource.sceneObj->getComponent <MeshComponent> (entity);
+                    if (meshComponent->m_loadPending)
+                        meshComponent->m_meshIdx = resource.meshPoolObj->getMeshIdx (meshComponent->m_modelFilePath,
+                                                                                     meshComponent->m_mtlFileDirPath);
                 }
             }
 
             ~SYMeshLoading (void) {
+                delete m_meshLoadingInfo.resource.glbParserObj;
+                delete m_meshLoadingInfo.resource.objParserObj;
                 delete m_meshLoadingInfo.resource.logObj;
             }
     };
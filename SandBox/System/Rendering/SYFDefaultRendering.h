@@ -23,6 +23,7 @@ namespace SandBox {
                     Renderer::VKBuffer* vertexBufferObj;
                     Renderer::VKBuffer* indexBufferObj;
                     std::vector <Renderer::VKBuffer*> meshInstanceBufferObjs;
+                    std::vector <Renderer::VKBuffer*> materialBufferObjs;
                     Renderer::VKPipeline* pipelineObj;
                     Renderer::VKDescriptorSet* perFrameDescSetObj;
                     Renderer::VKDescriptorSet* otherDescSetObj;
@@ -65,6 +66,12 @@ namespace SandBox {
                     );
                     resource.meshInstanceBufferObjs.push_back (bufferObj);
                 }
+                for (uint32_t i = 0; i < g_maxFramesInFlight; i++) {
+                    auto bufferObj          = collectionObj->getCollectionTypeInstance <Renderer::VKBuffer>        (
+                        "F_DEFAULT_MATERIAL_" + std::to_string (i)
+                    );
+                    resource.materialBufferObjs.push_back (bufferObj);
+                }
                 resource.pipelineObj        = collectionObj->getCollectionTypeInstance <Renderer::VKPipeline>      (
                     "F_DEFAULT"
                 );
@@ -83,6 +90,9 @@ namespace SandBox {
             }
 
             void update (const void* meshInstances,
+                         const uint32_t* firstRangeIdxs,
+                         const IndexRangeInfo* indexRanges,
+                         const void* materials,
                          const void* activeCamera) {
 
                 auto& resource            = m_fDefaultRenderingInfo.resource;
@@ -94,6 +104,13 @@ namespace SandBox {
                     meshInstances,
                     false
                 );
+                /* The material table is uploaded every frame, so that material edits do not need the vertex buffers
+                 * to be rebuilt
+                */
+                resource.materialBufferObjs[frameInFlightIdx]->updateBuffer (
+                    materials,
+                    false
+                );
                 /* [.] Continue render pass
                  *  .
                  *  .
@@ -129,13 +146,6 @@ namespace SandBox {
                     vertexBuffers,
                     vertexBufferOffsets
                 );
-                /* Index buffer */
-                Renderer::bindIndexBuffer (
-                    cmdBuffer,
-                    *resource.indexBufferObj->getBuffer(),
-                    0,
-                    VK_INDEX_TYPE_UINT32
-                );
                 /* Descriptor sets */
                 auto descriptorSets = std::vector {
                     resource.perFrameDescSetObj->getDescriptorSets()[frameInFlightIdx],
@@ -150,18 +160,40 @@ namespace SandBox {
                     descriptorSets,
                     dynamicOffsets
                 );
-                /* Draw */
+                /* Draw, the index buffer is bound again whenever the index type (16 or 32 bit) changes between meshes,
+                 * see SYMeshBatching
+                */
+                VkIndexType boundIndexType = VK_INDEX_TYPE_MAX_ENUM;
                 for (auto const& entity: m_entities) {
-                    auto renderComponent = resource.sceneObj->getComponent <RenderComponent> (entity);
+                    auto renderComponent   = resource.sceneObj->getComponent <RenderComponent> (entity);
+                    /* Visible index ranges (of the level of detail selected) for this view, see
+                     * SYStdMeshInstanceBatching
+                    */
+                    uint32_t firstRangeIdx = firstRangeIdxs[renderComponent->m_firstInstanceIdx];
+                    uint32_t lastRangeIdx  = firstRangeIdxs[renderComponent->m_firstInstanceIdx + 1];
+                    if (firstRangeIdx == lastRangeIdx)
+                        continue;
 
-                    Renderer::drawIndexed (
-                        cmdBuffer,
-                        renderComponent->m_firstIndexIdx,
-                        renderComponent->m_indicesCount,
-                        renderComponent->m_vertexOffset,
-                        renderComponent->m_firstInstanceIdx,
-                        renderComponent->m_instancesCount
-                    );
+                    if (renderComponent->m_indexType != boundIndexType) {
+                        boundIndexType = renderComponent->m_indexType;
+                        Renderer::bindIndexBuffer (
+                            cmdBuffer,
+                            *resource.indexBufferObj->getBuffer(),
+                            renderComponent->m_indexBufferOffset,
+                            boundIndexType
+                        );
+                    }
+
+                    for (uint32_t i = firstRangeIdx; i < lastRangeIdx; i++) {
+                        Renderer::drawIndexed (
+                            cmdBuffer,
+                            renderComponent->m_firstIndexIdx + indexRanges[i].firstIndexIdx,
+                            indexRanges[i].indicesCount,
+                            renderComponent->m_vertexOffset,
+                            renderComponent->m_firstInstanceIdx,
+                            renderComponent->m_instancesCount
+                        );
+                    }
                 }
                 /* [.] Continue render pass
                  *  .
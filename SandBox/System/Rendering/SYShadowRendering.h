@@ -61,7 +61,7 @@ namespace SandBox {
                 }
                 resource.sceneObj           = sceneObj;
                 resource.vertexBufferObj    = collectionObj->getCollectionTypeInstance <Renderer::VKBuffer>        (
-                    "S_DEFAULT_VERTEX"
+                    "S_DEFAULT_POSITION"
                 );
                 resource.indexBufferObj     = collectionObj->getCollectionTypeInstance <Renderer::VKBuffer>        (
                     "S_DEFAULT_INDEX"
@@ -112,6 +112,8 @@ namespace SandBox {
 
             void update (const uint32_t activeLightIdx,
                          const void* meshInstances,
+                         const uint32_t* firstRangeIdxs,
+                         const IndexRangeInfo* indexRanges,
                          const void* activeLight) {
 
                 auto& resource            = m_shadowRenderingInfo.resource;
@@ -202,13 +204,6 @@ namespace SandBox {
                     vertexBuffers,
                     vertexBufferOffsets
                 );
-                /* Index buffer */
-                Renderer::bindIndexBuffer (
-                    cmdBuffer,
-                    *resource.indexBufferObj->getBuffer(),
-                    0,
-                    VK_INDEX_TYPE_UINT32
-                );
                 /* Descriptor sets */
                 auto descriptorSets = std::vector {
                     resource.perFrameDescSetObj->getDescriptorSets()[frameInFlightIdx],
@@ -222,18 +217,40 @@ namespace SandBox {
                     descriptorSets,
                     dynamicOffsets
                 );
-                /* Draw */
+                /* Draw, the index buffer is bound again whenever the index type (16 or 32 bit) changes between meshes,
+                 * see SYMeshBatching
+                */
+                VkIndexType boundIndexType = VK_INDEX_TYPE_MAX_ENUM;
                 for (auto const& entity: m_entities) {
-                    auto renderComponent = resource.sceneObj->getComponent <RenderComponent> (entity);
+                    auto renderComponent   = resource.sceneObj->getComponent <RenderComponent> (entity);
+                    /* Visible index ranges (of the level of detail selected) for this view, see
+                     * SYStdMeshInstanceBatching
+                    */
+                    uint32_t firstRangeIdx = firstRangeIdxs[renderComponent->m_firstInstanceIdx];
+                    uint32_t lastRangeIdx  = firstRangeIdxs[renderComponent->m_firstInstanceIdx + 1];
+                    if (firstRangeIdx == lastRangeIdx)
+                        continue;
 
-                    Renderer::drawIndexed (
-                        cmdBuffer,
-                        renderComponent->m_firstIndexIdx,
-                        renderComponent->m_indicesCount,
-                        renderComponent->m_vertexOffset,
-                        renderComponent->m_firstInstanceIdx,
-                        renderComponent->m_instancesCount
-                    );
+                    if (renderComponent->m_indexType != boundIndexType) {
+                        boundIndexType = renderComponent->m_indexType;
+                        Renderer::bindIndexBuffer (
+                            cmdBuffer,
+                            *resource.indexBufferObj->getBuffer(),
+                            renderComponent->m_indexBufferOffset,
+                            boundIndexType
+                        );
+                    }
+
+                    for (uint32_t i = firstRangeIdx; i < lastRangeIdx; i++) {
+                        Renderer::drawIndexed (
+                            cmdBuffer,
+                            renderComponent->m_firstIndexIdx + indexRanges[i].firstIndexIdx,
+                            indexRanges[i].indicesCount,
+                            renderComponent->m_vertexOffset,
+                            renderComponent->m_firstInstanceIdx,
+                            renderComponent->m_instancesCount
+                        );
+                    }
                 }
                 /* [.]
                  *  .
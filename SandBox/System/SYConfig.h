@@ -28,5 +28,28 @@ namespace SandBox {
                 float deltaDamp             = 0.85f;
             } coarseSensitivity;
         } camera;
+
+        /* Largest deviation (in pixels) from the full resolution mesh that a level of detail may show on screen. Shadow
+         * maps are filtered and only show silhouettes, and so are allowed a larger error
+        */
+        struct Lod {
+            float maxScreenError            = 1.0f;
+            float maxShadowScreenError      = 4.0f;
+        } lod;
+
+        /* Cull the meshlets of every std mesh instance against each view on the CPU (see SBMeshletCuller), drawing
+         * only the visible ones. Turned off, every instance is drawn whole
+        */
+        struct Culling {
+            bool clusterCulling             = true;
+        } culling;
+
+        /* The load time report only summarizes the batched meshes (see SYMeshBatching::generateReport). Turned on, the
+         * batched geometry is also written out to the export file once the scene is loaded
+        */
+        struct Report {
+            bool geometryExport             = false;
+            const char* geometryExportPath  = "Build/Log/SandBox/Geometry.bin";
+        } report;
     } g_systemConfig;
 }   // namespace SandBox
\ No newline at end of file
@@ -0,0 +1,272 @@
+#include "../Backend/Common.h"
+#include "../Backend/Log/LGType.h"
+/* Offline decoder for binary log files (.lgb) written by the binary sink. The output matches the text produced by the
+ * LOG and LOG_FMT macros when routed to the file sink
+ *
+ * Usage: LGDecoder_EXE [-t] <binaryFilePath> [saveFilePath]
+ *  -t      write raw ticks and frame indices as time stamps (same as TIME_STAMP_TYPE_TICK_AND_FRAME) instead of wall
+ *          clock time
+*/
+namespace Log {
+    class LGDecoder {
+        private:
+            struct SiteInfo {
+                e_levelType levelType;
+                uint32_t line;
+                std::string function;
+                std::string format;
+                std::vector <e_argType> argTypes;
+            };
+
+            struct DecoderInfo {
+                struct Meta {
+                    std::vector <uint8_t> bytes;
+                    size_t readOffset;
+                    std::unordered_map <SiteIdType, SiteInfo> siteIdToSiteInfoMap;
+                    /* Header */
+                    int64_t tickPeriodNum;
+                    int64_t tickPeriodDen;
+                    TickType headerTick;
+                    int64_t headerWallTime;
+                    TickType lastTick;
+                    FrameIdxType lastFrameIdx;
+                    uint32_t version;
+                } meta;
+
+                struct State {
+                    bool tickTimeStampEnabled;
+                } state;
+            } m_decoderInfo;
+
+            bool isEndOfFile (void) {
+                return m_decoderInfo.meta.readOffset >= m_decoderInfo.meta.bytes.size();
+            }
+
+            template <typename T>
+            T readBytes (void) {
+                auto& meta = m_decoderInfo.meta;
+                if (meta.readOffset + sizeof (T) > meta.bytes.size())
+                    throw std::runtime_error ("Truncated binary log file");
+
+                T value;
+                std::memcpy (&value, meta.bytes.data() + meta.readOffset, sizeof (T));
+                meta.readOffset += sizeof (T);
+                return value;
+            }
+
+            uint64_t readVarint (void) {
+                uint64_t value = 0;
+                uint32_t shift = 0;
+                uint8_t byte;
+                do {
+                    byte   = readBytes <uint8_t>();
+                    value |= static_cast <uint64_t> (byte & 0x7F) << shift;
+                    shift += 7;
+                } while (byte & 0x80);
+                return value;
+            }
+
+            int64_t readDelta (void) {
+                uint64_t value = readVarint();
+                return static_cast <int64_t> (value >> 1) ^ -static_cast <int64_t> (value & 1);
+            }
+
+            /* Frame indices were added in version 2 */
+            void readTickAndFrameIdx (void) {
+                auto& meta         = m_decoderInfo.meta;
+                meta.lastTick     += readDelta();
+                if (meta.version >= 2)
+                    meta.lastFrameIdx += static_cast <FrameIdxType> (readDelta());
+            }
+
+            std::string readString (void) {
+                auto& meta      = m_decoderInfo.meta;
+                uint32_t length = readBytes <uint32_t>();
+                if (meta.readOffset + length > meta.bytes.size())
+                    throw std::runtime_error ("Truncated binary log file");
+
+                std::string value (reinterpret_cast <const char*> (meta.bytes.data() + meta.readOffset), length);
+                meta.readOffset += length;
+                return value;
+            }
+
+            bool isHeaderNext (void) {
+                auto& meta         = m_decoderInfo.meta;
+                size_t magicLength = std::strlen (g_binaryFileMagic);
+
+                return meta.readOffset + magicLength <= meta.bytes.size() &&
+                       std::memcmp (meta.bytes.data() + meta.readOffset, g_binaryFileMagic, magicLength) == 0;
+            }
+
+            void readHeader (void) {
+                auto& meta           = m_decoderInfo.meta;
+                meta.readOffset     += std::strlen (g_binaryFileMagic);
+
+                meta.version         = readBytes <uint32_t>();
+                if (meta.version == 0 || meta.version > g_binaryFileVersion)
+                    throw std::runtime_error ("Unsupported binary log file version");
+
+                meta.tickPeriodNum   = readBytes <int64_t>();
+                meta.tickPeriodDen   = readBytes <int64_t>();
+                meta.headerTick      = readBytes <TickType>();
+                meta.headerWallTime  = readBytes <int64_t>();
+                meta.lastTick        = meta.headerTick;
+                meta.lastFrameIdx    = 0;
+                /* Site ids are only unique within a session, and every session begins with a header */
+                meta.siteIdToSiteInfoMap.clear();
+            }
+
+            std::string getTimeStamp (void) {
+                auto& meta = m_decoderInfo.meta;
+                auto tick  = meta.lastTick;
+                std::stringstream stream;
+                if (m_decoderInfo.state.tickTimeStampEnabled) {
+                    stream << "[" << tick << "]" << " " << "[" << meta.lastFrameIdx << "]";
+                    return stream.str();
+                }
+                /* Convert tick to wall clock time using the reference pair captured in the header */
+                auto elapsedSeconds = static_cast <int64_t> (
+                    static_cast <double> (tick - meta.headerTick) * meta.tickPeriodNum / meta.tickPeriodDen
+                );
+                auto t_c            = static_cast <std::time_t> (meta.headerWallTime + elapsedSeconds);
+                stream << "[" << std::put_time (std::localtime (&t_c), "%F %T") << "]";
+                return stream.str();
+            }
+
+            void readArg (std::ostream& stream, const e_argType argType) {
+                switch (argType) {
+                    case ARG_TYPE_BOOL:     stream << static_cast <bool> (readBytes <uint8_t>());   break;
+                    case ARG_TYPE_CHAR:     stream << readBytes <char>();                           break;
+                    case ARG_TYPE_INT32:    stream << readBytes <int32_t>();                        break;
+                    case ARG_TYPE_UINT32:   stream << readBytes <uint32_t>();                       break;
+                    case ARG_TYPE_INT64:    stream << readBytes <int64_t>();                        break;
+                    case ARG_TYPE_UINT64:   stream << readBytes <uint64_t>();                       break;
+                    case ARG_TYPE_FLOAT:    stream << readBytes <float>();                          break;
+                    case ARG_TYPE_DOUBLE:   stream << readBytes <double>();                         break;
+                    case ARG_TYPE_STRING:   stream << readString();                                 break;
+                    default:                throw std::runtime_error ("Invalid arg type");
+                }
+            }
+
+            void readSiteRecord (void) {
+                auto siteId              = static_cast <SiteIdType> (readVarint());
+                SiteInfo siteInfo;
+                siteInfo.levelType       = static_cast <e_levelType> (readBytes <uint8_t>());
+                siteInfo.line            = readBytes <uint32_t>();
+                /* File name is not part of the text format, skip it */
+                static_cast <void> (readString());
+                siteInfo.function        = readString();
+                siteInfo.format          = readString();
+
+                uint8_t argsCount        = readBytes <uint8_t>();
+                for (uint8_t i = 0; i < argsCount; i++)
+                    siteInfo.argTypes.push_back (static_cast <e_argType> (readBytes <uint8_t>()));
+
+                m_decoderInfo.meta.siteIdToSiteInfoMap[siteId] = siteInfo;
+            }
+
+            void readFmtRecord (std::ostream& stream) {
+                auto& siteIdToSiteInfoMap = m_decoderInfo.meta.siteIdToSiteInfoMap;
+                auto siteId               = static_cast <SiteIdType> (readVarint());
+                readTickAndFrameIdx();
+
+                if (siteIdToSiteInfoMap.find (siteId) == siteIdToSiteInfoMap.end())
+                    throw std::runtime_error ("Site record missing for fmt record");
+                auto& siteInfo            = siteIdToSiteInfoMap[siteId];
+
+                stream << getTimeStamp()
+                       << " "
+                       << "[" << getLevelTypeString (siteInfo.levelType)  << "]"
+                       << " "
+                       << std::right << std::setw (64) << siteInfo.function
+                       << " "
+                       << std::right << std::setw (8)  << siteInfo.line
+                       << " ";
+                /* Replace each "{}" in the format string with the next arg, same as the text sink */
+                size_t formatOffset       = 0;
+                for (auto const& argType: siteInfo.argTypes) {
+                    size_t placeholderIdx = siteInfo.format.find ("{}", formatOffset);
+                    if (placeholderIdx == std::string::npos) {
+                        /* Args without a placeholder are still present in the record, read and drop them */
+                        std::stringstream unusedStream;
+                        readArg (unusedStream, argType);
+                        continue;
+                    }
+                    stream << siteInfo.format.substr (formatOffset, placeholderIdx - formatOffset);
+                    readArg (stream, argType);
+                    formatOffset          = placeholderIdx + 2;
+                }
+                stream << siteInfo.format.substr (formatOffset) << std::endl;
+            }
+
+            /* Text records are stored fully formatted, with the time stamp type of the logger that wrote them */
+            void readTextRecord (std::ostream& stream) {
+                readTickAndFrameIdx();
+                stream << readString();
+            }
+
+        public:
+            LGDecoder (void) {
+                m_decoderInfo = {};
+            }
+
+            void initDecoderInfo (const char* binaryFilePath, const bool tickTimeStampEnabled) {
+                auto& meta = m_decoderInfo.meta;
+                std::ifstream file (binaryFilePath, std::ios::binary);
+                if (!file.is_open())
+                    throw std::runtime_error ("Failed to open binary log file");
+
+                meta.bytes               = std::vector <uint8_t> (std::istreambuf_iterator <char> (file),
+                                                                  std::istreambuf_iterator <char>());
+                meta.readOffset          = 0;
+                meta.siteIdToSiteInfoMap = {};
+                m_decoderInfo.state.tickTimeStampEnabled = tickTimeStampEnabled;
+                file.close();
+            }
+
+            void runDecoder (std::ostream& stream) {
+                while (!isEndOfFile()) {
+                    if (isHeaderNext()) {
+                        readHeader();
+                        continue;
+                    }
+                    auto recordType = static_cast <e_recordType> (readBytes <uint8_t>());
+                    switch (recordType) {
+                        case RECORD_TYPE_SITE:  readSiteRecord();           break;
+                        case RECORD_TYPE_FMT:   readFmtRecord  (stream);    break;
+                        case RECORD_TYPE_TEXT:  readTextRecord (stream);    break;
+                        default:                throw std::runtime_error ("Invalid record type");
+                    }
+                }
+            }
+    };
+}   // namespace Log
+
+int main (int argc, char* argv[]) {
+    bool tickTimeStampEnabled = argc > 1 && std::strcmp (argv[1], "-t") == 0;
+    int argIdx                = tickTimeStampEnabled ? 2: 1;
+    if (argc <= argIdx) {
+        std::cerr << "Usage: " << argv[0] << " [-t] <binaryFilePath> [saveFilePath]" << std::endl;
+        return 1;
+    }
+
+    try {
+        Log::LGDecoder decoder;
+        decoder.initDecoderInfo (argv[argIdx], tickTimeStampEnabled);
+
+        if (argc > argIdx + 1) {
+            std::ofstream file (argv[argIdx + 1]);
+            if (!file.is_open())
+                throw std::runtime_error ("Failed to open save file");
+            decoder.runDecoder (file);
+            file.close();
+        }
+        else
+            decoder.runDecoder (std::cout);
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,140 @@
+#include <filesystem>
+#include <future>
+#include "../Backend/Common.h"
+#include "../Backend/Log/LGImpl.h"
+/* Regression test for the sink registry, run with more file sinks than g_maxOpenFiles so that files are evicted. The
+ * first logger is made to rotate its file while a line is still buffered, after which every other logger writes a
+ * warning (which opens its file). The first sink is the least recently written one by then, and so the first to be
+ * evicted. Every log file is expected to hold every line written to it, and the test fails if it does not complete
+ * within a few seconds (a deadlock between the registry and a sink)
+ *
+ * Usage: LGSinkTest_EXE [saveFileDirPath]
+ *  saveFileDirPath     directory the log files are written to (Build/Log/Tool by default), its contents are removed
+*/
+namespace Log {
+    class LGSinkTest {
+        private:
+            struct TestInfo {
+                struct Meta {
+                    std::string saveFileDirPath;
+                    uint32_t loggersCount;
+                } meta;
+
+                struct Resource {
+                    std::vector <LGImpl*> logObjs;
+                } resource;
+            } m_testInfo;
+
+            std::string getSaveFilePath (const uint32_t loggerIdx) {
+                return m_testInfo.meta.saveFileDirPath + "/" + "Logger" + std::to_string (loggerIdx) + ".log";
+            }
+
+            bool isLineWritten (const std::string saveFilePath, const std::string line) {
+                std::ifstream file (saveFilePath);
+                std::stringstream stream;
+                stream << file.rdbuf();
+                return stream.str().find (line) != std::string::npos;
+            }
+
+            void writeLines (void) {
+                auto& logObjs = m_testInfo.resource.logObjs;
+                /* Info lines are not flushed, so the line that triggers the rotation is left in the buffer without an
+                 * open file
+                */
+                for (uint32_t i = 0; i < 4; i++)
+                    LOG_INFO (logObjs[0]) << "Rotated line " << i << std::endl;
+
+                for (uint32_t i = 1; i < m_testInfo.meta.loggersCount; i++)
+                    LOG_WARNING (logObjs[i]) << "Evicting line " << i << std::endl;
+                LOG_WARNING (logObjs[0]) << "Evicting line " << 0 << std::endl;
+            }
+
+        public:
+            LGSinkTest (void) {
+                m_testInfo = {};
+            }
+
+            void initTestInfo (const std::string saveFileDirPath) {
+                auto& meta           = m_testInfo.meta;
+                auto& resource       = m_testInfo.resource;
+                meta.saveFileDirPath = saveFileDirPath;
+                meta.loggersCount    = g_maxOpenFiles + 1;
+
+                std::filesystem::remove_all         (meta.saveFileDirPath);
+                std::filesystem::create_directories (meta.saveFileDirPath);
+
+                for (uint32_t i = 0; i < meta.loggersCount; i++) {
+                    auto logObj = new LGImpl();
+                    logObj->initLogInfo     (meta.saveFileDirPath,  "Logger" + std::to_string (i) + ".cpp");
+                    logObj->updateLogConfig (LEVEL_TYPE_INFO,       SINK_TYPE_FILE);
+                    logObj->updateLogConfig (LEVEL_TYPE_WARNING,    SINK_TYPE_FILE);
+                    resource.logObjs.push_back (logObj);
+                }
+                /* Small enough that a couple of lines trigger a rotation */
+                resource.logObjs[0]->updateSinkConfig (SINK_TYPE_FILE, 200, 2, 0);
+            }
+
+            bool runTest (std::ostream& stream) {
+                auto& meta        = m_testInfo.meta;
+                /* The writer is left running (and the process exits) if it deadlocks, hence the detached thread */
+                std::promise <void> promise;
+                auto future       = promise.get_future();
+                std::thread ([this, promise = std::move (promise)](void) mutable {
+                    writeLines();
+                    promise.set_value();
+                }).detach();
+
+                if (future.wait_for (std::chrono::seconds (10)) != std::future_status::ready) {
+                    stream << "[FAIL] Writes did not complete, registry deadlock" << std::endl;
+                    return false;
+                }
+
+                bool testPassed   = true;
+                /* The last warning of the first logger rotates its file once more, along with the buffered line */
+                std::vector <std::pair <std::string, std::string>> expectedLines = {
+                    {getSaveFilePath (0) + ".1", "Rotated line 3"}
+                };
+                for (uint32_t i = 0; i < meta.loggersCount; i++)
+                    expectedLines.push_back ({getSaveFilePath (i), "Evicting line " + std::to_string (i)});
+
+                for (auto const& [saveFilePath, line]: expectedLines) {
+                    if (!isLineWritten (saveFilePath, line)) {
+                        stream << "[FAIL] Missing line [" << line << "]"
+                               << " "
+                               << "in [" << saveFilePath << "]"
+                               << std::endl;
+                        testPassed = false;
+                    }
+                }
+
+                if (testPassed)
+                    stream << "[OK] "
+                           << meta.loggersCount << " sinks, " << g_maxOpenFiles << " open files"
+                           << std::endl;
+                return testPassed;
+            }
+
+            ~LGSinkTest (void) {
+                for (auto const& logObj: m_testInfo.resource.logObjs)
+                    delete logObj;
+            }
+    };
+}   // namespace Log
+
+int main (int argc, char* argv[]) {
+    std::string saveFileDirPath = argc > 1 ? argv[1]: "Build/Log/Tool";
+    bool testPassed             = false;
+    try {
+        Log::LGSinkTest test;
+        test.initTestInfo (saveFileDirPath);
+        testPassed = test.runTest (std::cout);
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    /* Skip static destruction, which would wait on a deadlocked sink */
+    if (!testPassed)
+        std::_Exit (1);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,264 @@
+#include <filesystem>
+#define TINYOBJLOADER_IMPLEMENTATION
+#include <tinyobjloader/tiny_obj_loader.h>
+#include "../Backend/Common.h"
+#include "../Backend/Job/JBPool.h"
+#include "../SandBox/SBOBJParser.h"
+#include "../SandBox/SBRendererType.h"
+/* Compares the time taken to turn a model file into vertices and indices, between the path SYMeshLoading used to take
+ * (tinyobjloader, copying the attributes/shapes/materials out of the reader and deduplicating on the full vertex) and
+ * the in-engine parser (SBOBJParser, deduplicating on the corner indices). Vertices refer to the materials of the model
+ * file by index in both, and faces without a material to the one past the last (where SYMeshLoading places its
+ * default material). The triangles produced by both are compared as well
+ *
+ * Usage: SBOBJBenchmark_EXE [-n iterationsCount] [modelFilePath ...]
+ *  -n      number of times each model file is imported by each path (20 by default), the fastest run is reported
+ *
+ * Every bundled model file (.obj files in Asset/Model) is used when no model file path is given, note that this has to
+ * be run from the project root. The tinyobjloader submodule (Dependency/tinyobjloader) has to be checked out, the times
+ * reported for it are only representative of the old path when built against that version of the reader
+*/
+namespace SandBox {
+    class SBOBJBenchmark {
+        private:
+            struct BenchmarkInfo {
+                struct Meta {
+                    std::vector <std::string> modelFilePaths;
+                    uint32_t iterationsCount;
+                } meta;
+
+                struct Resource {
+                    Job::JBPool* jobPoolObj;
+                    SBOBJParser* objParserObj;
+                } resource;
+            } m_benchmarkInfo;
+
+            std::string getMtlFileDirPath (const std::string modelFilePath) {
+                return std::filesystem::path (modelFilePath).parent_path().string() + "/";
+            }
+
+            void importWithTinyOBJ (const std::string modelFilePath,
+                                    std::vector <Vertex>& vertices,
+                                    std::vector <IndexType>& indices) {
+
+                std::unordered_map <Vertex, IndexType> vertexToIndexMap;
+                tinyobj::ObjReaderConfig readerConfig;
+                tinyobj::ObjReader reader;
+                readerConfig.mtl_search_path = getMtlFileDirPath (modelFilePath);
+                readerConfig.triangulate     = true;
+
+                if (!reader.ParseFromFile (modelFilePath, readerConfig))
+                    throw std::runtime_error ("Failed to parse model file [" + modelFilePath + "]");
+
+                auto attribute = reader.GetAttrib();
+                auto shapes    = reader.GetShapes();
+                auto materials = reader.GetMaterials();
+
+                for (size_t shapeIdx = 0; shapeIdx < shapes.size(); shapeIdx++) {
+                    size_t idxOffset = 0;
+
+                    for (size_t faceIdx = 0; faceIdx < shapes[shapeIdx].mesh.num_face_vertices.size(); faceIdx++) {
+                        int materialIdx        = shapes[shapeIdx].mesh.material_ids[faceIdx];
+                        auto verticesPerFace   = static_cast <size_t> (shapes[shapeIdx].mesh.num_face_vertices[faceIdx]);
+
+                        for (size_t vertexIdx = 0; vertexIdx < verticesPerFace; vertexIdx++) {
+                            auto idx = shapes[shapeIdx].mesh.indices[idxOffset + vertexIdx];
+                            Vertex vertex;
+                            vertex.meta.uv       = {
+                                attribute.texcoords[2 * static_cast <size_t> (idx.texcoord_index) + 0],
+                                1.0f - attribute.texcoords[2 * static_cast <size_t> (idx.texcoord_index) + 1]
+                            };
+                            vertex.meta.normal   = {
+                                attribute.normals  [3 * static_cast <size_t> (idx.normal_index)   + 0],
+                                attribute.normals  [3 * static_cast <size_t> (idx.normal_index)   + 1],
+                                attribute.normals  [3 * static_cast <size_t> (idx.normal_index)   + 2]
+                            };
+                            vertex.meta.position = {
+                                attribute.vertices [3 * static_cast <size_t> (idx.vertex_index)   + 0],
+                                attribute.vertices [3 * static_cast <size_t> (idx.vertex_index)   + 1],
+                                attribute.vertices [3 * static_cast <size_t> (idx.vertex_index)   + 2]
+                            };
+                            vertex.materialIdx   = materialIdx == -1 ?
+                                static_cast <uint32_t> (materials.size()): static_cast <uint32_t> (materialIdx);
+
+                            if (vertexToIndexMap.count (vertex) == 0) {
+                                vertexToIndexMap[vertex] = static_cast <IndexType> (vertices.size());
+                                vertices.push_back (vertex);
+                            }
+                            indices.push_back (vertexToIndexMap[vertex]);
+                        }
+                        idxOffset += verticesPerFace;
+                    }
+                }
+            }
+
+            void importWithOBJParser (const std::string modelFilePath,
+                                      std::vector <Vertex>& vertices,
+                                      std::vector <IndexType>& indices) {
+
+                OBJModelInfo modelInfo;
+                m_benchmarkInfo.resource.objParserObj->importModel (modelFilePath,
+                                                                    getMtlFileDirPath (modelFilePath),
+                                                                    modelInfo);
+                vertices.reserve (modelInfo.corners.size());
+                for (auto const& corner: modelInfo.corners) {
+                    Vertex vertex = {};
+                    if (corner.texCoordIdx != -1)
+                        vertex.meta.uv   = {
+                            modelInfo.texCoords[corner.texCoordIdx].x,
+                            1.0f - modelInfo.texCoords[corner.texCoordIdx].y
+                        };
+                    if (corner.normalIdx   != -1)
+                        vertex.meta.normal = modelInfo.normals[corner.normalIdx];
+                    vertex.meta.position = modelInfo.positions[corner.positionIdx];
+                    vertex.materialIdx   = corner.materialIdx == -1 ?
+                        static_cast <uint32_t> (modelInfo.materials.size()):
+                        static_cast <uint32_t> (corner.materialIdx);
+                    vertices.push_back (vertex);
+                }
+                indices.assign (modelInfo.indices.begin(), modelInfo.indices.end());
+            }
+
+            /* Fastest run in milliseconds */
+            template <typename T>
+            double getRunTime (T&& run) {
+                double minRunTime = std::numeric_limits <double>::max();
+                for (uint32_t i = 0; i < m_benchmarkInfo.meta.iterationsCount; i++) {
+                    auto start    = std::chrono::steady_clock::now();
+                    run();
+                    auto end      = std::chrono::steady_clock::now();
+                    minRunTime    = std::min (minRunTime,
+                                              std::chrono::duration <double, std::milli> (end - start).count());
+                }
+                return minRunTime;
+            }
+
+            /* The vertices may be ordered and deduplicated differently, so triangles are compared corner by corner */
+            bool isMatching (const std::vector <Vertex>& verticesA, const std::vector <IndexType>& indicesA,
+                             const std::vector <Vertex>& verticesB, const std::vector <IndexType>& indicesB) {
+
+                if (indicesA.size() != indicesB.size())
+                    return false;
+
+                auto isClose = [](const float a, const float b) {
+                    return std::abs (a - b) <= 1e-6f * std::max (1.0f, std::max (std::abs (a), std::abs (b)));
+                };
+                for (size_t i = 0; i < indicesA.size(); i++) {
+                    auto& vertexA = verticesA[indicesA[i]];
+                    auto& vertexB = verticesB[indicesB[i]];
+                    for (uint32_t j = 0; j < 3; j++) {
+                        if (!isClose (vertexA.meta.position[j], vertexB.meta.position[j]) ||
+                            !isClose (vertexA.meta.normal[j],   vertexB.meta.normal[j]))
+                            return false;
+                    }
+                    if (!isClose (vertexA.meta.uv.x, vertexB.meta.uv.x) ||
+                        !isClose (vertexA.meta.uv.y, vertexB.meta.uv.y))
+                        return false;
+                    if (vertexA.materialIdx != vertexB.materialIdx)
+                        return false;
+                }
+                return true;
+            }
+
+        public:
+            SBOBJBenchmark (void) {
+                m_benchmarkInfo = {};
+            }
+
+            void initBenchmarkInfo (const std::vector <std::string> modelFilePaths, const uint32_t iterationsCount) {
+                auto& meta                    = m_benchmarkInfo.meta;
+                auto& resource                = m_benchmarkInfo.resource;
+                meta.modelFilePaths           = modelFilePaths;
+                meta.iterationsCount          = std::max (iterationsCount, 1u);
+
+                if (meta.modelFilePaths.empty()) {
+                    for (auto const& entry: std::filesystem::directory_iterator ("Asset/Model")) {
+                        if (entry.path().extension() == ".obj")
+                            meta.modelFilePaths.push_back (entry.path().string());
+                    }
+                    std::sort (meta.modelFilePaths.begin(), meta.modelFilePaths.end());
+                }
+
+                resource.jobPoolObj           = new Job::JBPool();
+                resource.jobPoolObj->initPoolInfo();
+                resource.objParserObj         = new SBOBJParser();
+                resource.objParserObj->initOBJParserInfo (resource.jobPoolObj);
+            }
+
+            void runBenchmark (std::ostream& stream) {
+                auto& meta = m_benchmarkInfo.meta;
+                stream << std::left  << std::setw (40) << "Model file"
+                       << std::right << std::setw (12) << "Size (KB)"
+                       << std::setw (16) << "tinyobj (ms)"
+                       << std::setw (16) << "SBOBJ (ms)"
+                       << std::setw (10) << "Speed up"
+                       << std::setw (20) << "Vertices"
+                       << std::setw (10) << "Indices"
+                       << std::setw (8)  << "Match"
+                       << std::endl;
+
+                double tinyOBJTotalRunTime   = 0.0;
+                double objParserTotalRunTime = 0.0;
+                for (auto const& modelFilePath: meta.modelFilePaths) {
+                    std::vector <Vertex> tinyOBJVertices,   objParserVertices;
+                    std::vector <IndexType> tinyOBJIndices, objParserIndices;
+
+                    double tinyOBJRunTime    = getRunTime ([&](void) {
+                        tinyOBJVertices.clear();
+                        tinyOBJIndices.clear();
+                        importWithTinyOBJ   (modelFilePath, tinyOBJVertices,   tinyOBJIndices);
+                    });
+                    double objParserRunTime  = getRunTime ([&](void) {
+                        objParserVertices.clear();
+                        objParserIndices.clear();
+                        importWithOBJParser (modelFilePath, objParserVertices, objParserIndices);
+                    });
+                    tinyOBJTotalRunTime     += tinyOBJRunTime;
+                    objParserTotalRunTime   += objParserRunTime;
+
+                    stream << std::left  << std::setw (40) << modelFilePath
+                           << std::right << std::setw (12) << std::fixed << std::setprecision (1)
+                                                           << std::filesystem::file_size (modelFilePath) / 1024.0
+                           << std::setw (16) << std::setprecision (3) << tinyOBJRunTime
+                           << std::setw (16) << objParserRunTime
+                           << std::setw (9)  << std::setprecision (2) << tinyOBJRunTime / objParserRunTime << "x"
+                           << std::setw (20) << std::to_string (tinyOBJVertices.size())  + " / " +
+                                                std::to_string (objParserVertices.size())
+                           << std::setw (10) << objParserIndices.size()
+                           << std::setw (8)  << (isMatching (tinyOBJVertices,   tinyOBJIndices,
+                                                             objParserVertices, objParserIndices) ? "yes": "NO")
+                           << std::endl;
+                }
+                stream << std::left  << std::setw (52) << "Total"
+                       << std::right << std::setw (16) << std::setprecision (3) << tinyOBJTotalRunTime
+                       << std::setw (16) << objParserTotalRunTime
+                       << std::setw (9)  << std::setprecision (2) << tinyOBJTotalRunTime / objParserTotalRunTime << "x"
+                       << std::endl;
+            }
+
+            ~SBOBJBenchmark (void) {
+                delete m_benchmarkInfo.resource.objParserObj;
+                delete m_benchmarkInfo.resource.jobPoolObj;
+            }
+    };
+}   // namespace SandBox
+
+int main (int argc, char* argv[]) {
+    uint32_t iterationsCount = 20;
+    int argIdx               = 1;
+    if (argc > 2 && std::strcmp (argv[1], "-n") == 0) {
+        iterationsCount = static_cast <uint32_t> (std::strtoul (argv[2], nullptr, 10));
+        argIdx          = 3;
+    }
+
+    try {
+        SandBox::SBOBJBenchmark benchmark;
+        benchmark.initBenchmarkInfo (std::vector <std::string> (argv + argIdx, argv + argc), iterationsCount);
+        benchmark.runBenchmark (std::cout);
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file